@@ -35,6 +35,7 @@ You may select, at your option, one of the above-listed licenses.
 #include <uise/desktop/avatar.hpp>
 #include <uise/desktop/frame.hpp>
 #include <uise/desktop/utils/withpathandsize.hpp>
+#include <uise/desktop/utils/widthbucketcache.hpp>
 #include <uise/desktop/replypreviewdata.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
@@ -597,6 +598,30 @@ class UISE_DESKTOP_EXPORT AbstractChatMessageContent : public AbstractChatMessag
         //! updateItem() for the motivating case.
         void renegotiateBubbleWidth();
 
+        /**
+         * @brief Apply bubble width cached for a nearby forMaxWidthIn without querying the sections.
+         * @param forMaxWidthIn Width available for the bubble.
+         * @return False if nothing was ever negotiated and updateBubbleWidth() must be called instead.
+         *
+         * The result is approximate: the width cached for the same width bucket, or the current width
+         * if there is no such bucket, is clamped to forMaxWidthIn. The bubble is marked stale until
+         * the next updateBubbleWidth(). Used by ChatMessagesView for messages out of the viewport while
+         * the view is being resized.
+         */
+        bool replayBubbleWidth(int forMaxWidthIn);
+
+        //! Check if the bubble width was replayed and was not negotiated for the exact width since then.
+        bool isBubbleWidthStale() const noexcept
+        {
+            return m_bubbleWidthStale;
+        }
+
+        //! Drop bubble widths cached for other widths, must be called when the contents of sections change.
+        void invalidateBubbleWidthCache()
+        {
+            m_bubbleWidthCache.clear();
+        }
+
         const auto& sections() const
         {
             return m_sections;
@@ -663,6 +688,10 @@ class UISE_DESKTOP_EXPORT AbstractChatMessageContent : public AbstractChatMessag
         int m_bodyWidthHintForMaxWidth=0;
         bool m_bodyWidthHintValid=false;
 
+        //! Negotiated bubble widths keyed by forMaxWidthIn, see replayBubbleWidth().
+        WidthBucketCache<int> m_bubbleWidthCache;
+        bool m_bubbleWidthStale=false;
+
         void setMaximumBubbleWidth(int width);
 };
 
@@ -911,6 +940,34 @@ class UISE_DESKTOP_EXPORT AbstractChatMessage : public WidgetQFrame
             emit dateTimeUpdated();
         }
 
+        /**
+         * @brief Enable painting the content bubble from a snapshot while the message is idle.
+         * @param enable Flag.
+         *
+         * An idle message is not hovered, not selected and has neither focus nor selected text in it.
+         * Widgets of an idle bubble are hidden and its snapshot is painted instead, so they are skipped
+         * by painting, hit testing and event delivery. The bubble is restored as soon as it is hovered or selected.
+         *
+         * The snapshot is also dropped when the geometry, properties, style or children of the bubble's widgets change.
+         * A widget that changes only what it paints, e.g. by calling update() from its own setter, must report it with
+         * ChatMessageContentWrapper::invalidateSnapshotOf(), otherwise the stale snapshot is painted until the bubble
+         * is restored. Widgets of the library do that already.
+         */
+        void setPaintedWhenIdle(bool enable)
+        {
+            if (m_paintedWhenIdle==enable)
+            {
+                return;
+            }
+            m_paintedWhenIdle=enable;
+            updatePaintedWhenIdle();
+        }
+
+        bool isPaintedWhenIdle() const noexcept
+        {
+            return m_paintedWhenIdle;
+        }
+
     signals:
 
         void topSeparatorUpdated();
@@ -959,6 +1016,9 @@ class UISE_DESKTOP_EXPORT AbstractChatMessage : public WidgetQFrame
         virtual void updateDateTime()
         {}
 
+        virtual void updatePaintedWhenIdle()
+        {}
+
     private:
 
         AbstractChatSeparator* m_topSeparator=nullptr;
@@ -976,6 +1036,7 @@ class UISE_DESKTOP_EXPORT AbstractChatMessage : public WidgetQFrame
         bool m_selectorPositionLeft=true;
 
         bool m_right=false;
+        bool m_paintedWhenIdle=false;
 
         QDateTime m_dateTime;
 };
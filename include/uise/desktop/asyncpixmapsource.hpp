@@ -0,0 +1,208 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/asyncpixmapsource.hpp
+*
+*  Declares pixmap source decoding images in worker threads.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_ASYNC_PIXMAP_SOURCE_HPP
+#define UISE_DESKTOP_ASYNC_PIXMAP_SOURCE_HPP
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+#include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/pixmapproducer.hpp>
+#include <uise/desktop/thumbnaildiskcache.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Pixmap source that decodes images in a bounded thread pool.
+ *
+ * An image is decoded directly to the size of the pixmap key, so a thumbnail of a large photo never allocates
+ * the full resolution image. Decoding of a key is cancelled when the last consumer releases its producer,
+ * and is restarted if the producer is acquired again before it was destroyed.
+ * Decoded images are delivered to producers with updatePixmap() in the GUI thread.
+ *
+ * Requests are collected during an iteration of the event loop and are started in the order of priority,
+ * see loadPriority(), the most recent requests first. Requests for the same path at different sizes are coalesced,
+ * such path is decoded once and scaled to each size in the worker thread. Requests released before start
+ * are dropped from the queue. A key requested again while it is being decoded is merged into the running job.
+ *
+ * Priorities are evaluated when the queue is ranked. The ranking is reused by the following dispatches
+ * until new requests are queued or the ranking is older than priorityRefreshInterval().
+ *
+ * By default the file name of an image is the file path of the pixmap key, override imageFileName() to change it.
+ *
+ * With a disk cache scaled images are stored in the cache after decoding and are loaded from the cache
+ * synchronously when a producer is created, so the images decoded once are shown without waiting for
+ * decoding after restart of the application.
+ */
+class UISE_DESKTOP_EXPORT AsyncPixmapSource : public PixmapSource
+{
+    public:
+
+        //! Key of the priority hint in the data of a pixmap key, see AbstractImageViewer.
+        constexpr static const char* PriorityHintKey="uise.imageviewer.priority";
+
+        constexpr static const int DefaultPriorityRefreshInterval=200;
+
+        AsyncPixmapSource();
+
+        ~AsyncPixmapSource() override;
+
+        AsyncPixmapSource(const AsyncPixmapSource&)=delete;
+        AsyncPixmapSource(AsyncPixmapSource&&)=delete;
+        AsyncPixmapSource& operator=(const AsyncPixmapSource&)=delete;
+        AsyncPixmapSource& operator=(AsyncPixmapSource&&)=delete;
+
+        void setMaxThreadCount(int count);
+
+        int maxThreadCount() const;
+
+        /**
+         * @brief Set maximum age of the ranking of queued requests.
+         * @param msecs Age in milliseconds, 0 to rank the queue on every dispatch.
+         *
+         * Visibility of consumers can change without new requests, e.g. when a list is scrolled back,
+         * so the ranking is refreshed periodically.
+         */
+        void setPriorityRefreshInterval(int msecs) noexcept
+        {
+            m_priorityRefreshInterval=msecs;
+        }
+
+        int priorityRefreshInterval() const noexcept
+        {
+            return m_priorityRefreshInterval;
+        }
+
+        /**
+         * @brief Wait until all pending images are decoded.
+         * @param msecs Timeout, -1 for infinite.
+         * @return True if all images are decoded.
+         *
+         * Only started requests are waited for. Decoded images are delivered to producers and queued requests
+         * are started only when the event loop is processed.
+         */
+        bool waitForDone(int msecs=-1);
+
+        /**
+         * @brief Set disk cache of scaled images.
+         * @param cache Cache, nullptr disables the cache.
+         *
+         * Only keys with valid size are cached, images in original resolution are always decoded.
+         */
+        void setDiskCache(std::shared_ptr<ThumbnailDiskCache> cache)
+        {
+            m_diskCache=std::move(cache);
+        }
+
+        std::shared_ptr<ThumbnailDiskCache> diskCache() const
+        {
+            return m_diskCache;
+        }
+
+        //! Number of keys queued or being decoded.
+        size_t pendingCount() const noexcept;
+
+        /**
+         * @brief Read image scaled down to the size.
+         * @param fileName Image file.
+         * @param size Target size, the image is read in original resolution if the size is invalid.
+         * @param mode Aspect ratio mode of scaling.
+         * @return Read image or null image in case of error.
+         *
+         * Scaling is done by the image decoder where supported, e.g. JPEG is decoded directly to a reduced resolution.
+         * The image is never scaled up. Can be called in any thread.
+         */
+        static QImage readImage(const QString& fileName, const QSize& size, Qt::AspectRatioMode mode=Qt::KeepAspectRatio);
+
+    protected:
+
+        //! Get file name of the image for the key, invoked in the GUI thread.
+        virtual QString imageFileName(const PixmapKey& key) const;
+
+        //! Get fingerprint of the image content for the disk cache, invoked in the GUI thread.
+        //! Default is ThumbnailDiskCache::fileFingerprint() of the image file.
+        virtual quint64 imageFingerprint(const PixmapKey& key, const QString& fileName) const;
+
+        /**
+         * @brief Get priority of loading the key, invoked in the GUI thread when the queue is ranked.
+         * @return Priority, requests with greater priority are started first.
+         *
+         * Default priority is 1 if the key has "visible" priority hint or the producer has a visible consumer,
+         * and 0 otherwise.
+         */
+        virtual int loadPriority(const PixmapKey& key) const;
+
+        void doLoadPixmap(const PixmapKey& key) override;
+        void doUnloadProducer(const PixmapKey& key) override;
+        void doReleaseProducer(const PixmapKey& key) override;
+        void doReacquireProducer(const PixmapKey& key) override;
+
+    private:
+
+        struct Job;
+
+        struct Request
+        {
+            std::set<PixmapKey> keys;
+            size_t seq=0;
+        };
+
+        struct Running
+        {
+            std::shared_ptr<Job> job;
+            std::set<PixmapKey> keys;
+            std::set<PixmapKey> targets;
+        };
+
+        bool removeKey(const PixmapKey& key);
+        void scheduleDispatch();
+        void dispatch();
+        void rankQueue();
+        void start(const WithPath& path, std::set<PixmapKey> keys);
+        void onImagesDecoded(const WithPath& path, const std::shared_ptr<Job>& job,
+                             const std::vector<std::pair<PixmapKey,QImage>>& images);
+
+        QThreadPool m_pool;
+        std::map<WithPath,Request> m_queue;
+        std::map<WithPath,Running> m_running;
+        size_t m_requestSeq=0;
+        bool m_dispatchScheduled=false;
+        std::vector<WithPath> m_ranking;
+        bool m_rankingValid=false;
+        QElapsedTimer m_rankingClock;
+        int m_priorityRefreshInterval=DefaultPriorityRefreshInterval;
+        std::set<PixmapKey> m_cancelledKeys;
+        std::shared_ptr<ThumbnailDiskCache> m_diskCache;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_ASYNC_PIXMAP_SOURCE_HPP
@@ -26,6 +26,8 @@ You may select, at your option, one of the above-listed licenses.
 #ifndef UISE_DESKTOP_CHATMESSAGE_HPP
 #define UISE_DESKTOP_CHATMESSAGE_HPP
 
+#include <QPixmap>
+
 #include <uise/desktop/uisedesktop.hpp>
 #include <uise/desktop/abstractchatmessage.hpp>
 
@@ -208,6 +210,37 @@ class UISE_DESKTOP_EXPORT ChatMessageContentWrapper : public QFrame
 
         QSize sizeHint() const override;
 
+        /**
+         * @brief Replace the content bubble with its snapshot painted by this wrapper, or restore the bubble.
+         * @param enable Flag.
+         *
+         * Any change of the bubble geometry restores the bubble and emits paintedInvalidated().
+         * So does a change of properties, style, palette, font, children or visibility of any widget in the bubble.
+         * Changes that only repaint a widget are not detected, see invalidateSnapshotOf().
+         */
+        void setPainted(bool enable);
+
+        bool isPainted() const noexcept
+        {
+            return m_painted;
+        }
+
+        //! Restore the bubble and emit paintedInvalidated() if the bubble is painted from snapshot.
+        void invalidateSnapshot();
+
+        /**
+         * @brief Invalidate snapshot of the bubble containing a widget.
+         * @param widget Widget in the bubble whose content was changed.
+         *
+         * Widgets of a painted bubble are hidden, so their repaints are dropped and must be reported
+         * by their setters explicitly.
+         */
+        static void invalidateSnapshotOf(QWidget* widget);
+
+    signals:
+
+        void paintedInvalidated();
+
     public slots:
 
         void updatePosition();
@@ -220,6 +253,8 @@ class UISE_DESKTOP_EXPORT ChatMessageContentWrapper : public QFrame
 
         void showEvent(QShowEvent *event) override;
 
+        void paintEvent(QPaintEvent *event) override;
+
     private:
 
         //! Move m_content to its aligned position without touching its size.
@@ -227,8 +262,14 @@ class UISE_DESKTOP_EXPORT ChatMessageContentWrapper : public QFrame
         //! another resize of m_content, so it cannot re-enter this wrapper's own resizeEvent().
         void applyContentPosition();
 
+        //! Install or remove event filters detecting changes of the widgets of a painted bubble.
+        void watchContent(bool enable);
+
         AbstractChatMessageContent* m_content=nullptr;
         bool m_right=false;
+
+        bool m_painted=false;
+        QPixmap m_snapshot;
 };
 
 //--------------------------------------------------------------------------
@@ -312,8 +353,16 @@ class UISE_DESKTOP_EXPORT ChatMessage : public AbstractChatMessage
 
         void updateDateTime() override;
 
+        void updatePaintedWhenIdle() override;
+
         void mousePressEvent(QMouseEvent* event) override;
 
+        void enterEvent(QEnterEvent* event) override;
+
+        void leaveEvent(QEvent* event) override;
+
+        void showEvent(QShowEvent* event) override;
+
         void construct() override;
 
     private:
@@ -328,6 +377,11 @@ class UISE_DESKTOP_EXPORT ChatMessage : public AbstractChatMessage
         //! content body -- at ~5% of total process CPU.
         void ensureSelector();
 
+        //! Paint the bubble from snapshot after a delay if the message is still idle, see setPaintedWhenIdle().
+        void schedulePainting();
+        void paintIfIdle();
+        void setPainted(bool enable);
+
         std::unique_ptr<ChatMessage_p> pimpl;
 };
 
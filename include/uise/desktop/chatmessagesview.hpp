@@ -32,6 +32,8 @@ You may select, at your option, one of the above-listed licenses.
 #include <uise/desktop/uisedesktop.hpp>
 #include <uise/desktop/utils/enums.hpp>
 #include <uise/desktop/utils/singleshottimer.hpp>
+#include <uise/desktop/utils/messageselection.hpp>
+#include <uise/desktop/utils/messagepostqueue.hpp>
 #include <uise/desktop/frame.hpp>
 #include <uise/desktop/roundedimage.hpp>
 #include <uise/desktop/flyweightlistitem.hpp>
@@ -192,8 +194,18 @@ class ChatMessagesView : public AbstractChatMessagesView
 
         using MessageBuilder=std::function<Message* (const Data& data, QWidget* parent)>;
         using FuncItemsRequested=std::function<void (const SortValue& start, size_t maxCount, Direction direction)>;
+        using FuncItemRemoved=typename ChatMessagesViewWidget<BaseMessageT,Traits>::RemoveItemCb;
 
         using MessageHandler=std::function<bool (Message*)>;
+        using DataHandler=std::function<bool (const Data&)>;
+
+        //! Idle delay between chunks of refining bubble widths replayed on resize.
+        constexpr static const int RefineSizesInterval=20;
+        //! Number of messages laid out in a single chunk of refining.
+        constexpr static const size_t RefineSizesChunk=10;
+
+        //! Interval of committing posted messages, about one frame.
+        constexpr static const int PostCommitInterval=16;
 
         explicit ChatMessagesView(QWidget* parent=nullptr);
 
@@ -228,6 +240,18 @@ class ChatMessagesView : public AbstractChatMessagesView
             m_onItemsRequested=handler;
         }
 
+        /**
+         * @brief Set handler called when a message widget is removed from the list.
+         * @param handler Handler.
+         *
+         * Use it instead of setRemoveItemCb() of listView(), the callback of the list is used by the view
+         * to keep data of selected messages and calls this handler after that.
+         */
+        void setOnItemRemoved(FuncItemRemoved handler)
+        {
+            m_onItemRemoved=std::move(handler);
+        }
+
         void setMessageBuilder(MessageBuilder messageBuilder)
         {
             m_messageBuilder=messageBuilder;
@@ -262,6 +286,58 @@ class ChatMessagesView : public AbstractChatMessagesView
         void removeMessage(const Id& id);
         void reorderMessage(const Id& id);
 
+        /**
+         * @brief Post messages to insert or to update.
+         * @param items Messages, a message is updated if it is already in the list and inserted otherwise.
+         *
+         * Posted changes are accumulated and committed in a single update of the list per PostCommitInterval.
+         * Changes posted for the same message are merged, so only the final state of each message is committed.
+         * Calling insertMessage(), updateMessage(), removeMessage() or reorderMessage() commits pending changes first,
+         * clear() drops them.
+         */
+        void postMessages(const std::vector<Data>& items);
+
+        void postMessage(const Data& item);
+        void postRemoveMessage(const Id& id);
+        void postReorderMessage(const Id& id);
+
+        /**
+         * @brief Commit posted changes now.
+         */
+        void commitPostedMessages();
+
+        size_t pendingPostCount() const noexcept
+        {
+            return m_postQueue.size();
+        }
+
+        /**
+         * @brief Set maximum number of posted changes committed at once.
+         * @param count Maximum number, 0 means unlimited.
+         *
+         * Changes beyond the limit are left in the queue for the next commit, that spreads bursts of changes over
+         * several frames. Unlimited by default.
+         */
+        void setMaxPostCommitCount(size_t count) noexcept
+        {
+            m_maxPostCommitCount=count;
+        }
+
+        size_t maxPostCommitCount() const noexcept
+        {
+            return m_maxPostCommitCount;
+        }
+
+        const MessagePostStats& postStats() const noexcept
+        {
+            return m_postQueue.stats();
+        }
+
+        void resetPostStats() noexcept
+        {
+            m_postQueue.resetStats();
+        }
+
         //! Jump to an edge of the message list -- exactly what clicking the JumpEdge control
         //! does, including its fetch-if-the-loaded-window-is-not-the-true-edge fallback (through
         //! this view's own RequestEndCb/RequestHomeCb -> onJumpRequested()). See
@@ -273,6 +349,18 @@ class ChatMessagesView : public AbstractChatMessagesView
 
         std::vector<Data> selectedMessages() const;
 
+        /**
+         * @brief Iterate data of selected messages in the order of sort values without copying it.
+         * @param handler Handler, iteration stops if it returns false.
+         * @return False if iteration was stopped by the handler.
+         */
+        bool eachSelectedMessage(DataHandler handler) const;
+
+        size_t selectedCount() const noexcept
+        {
+            return m_selectedMessages.size();
+        }
+
         SortValue lastViewportSortValue() const;
 
         Id lastViewportSeqId() const;
@@ -290,6 +378,38 @@ class ChatMessagesView : public AbstractChatMessagesView
             return m_dateSubtitle;
         }
 
+        /**
+         * @brief Enable replaying cached bubble widths while the view is resized.
+         * @param enable Flag.
+         *
+         * When enabled only messages in the viewport are laid out for the new width on resize. Other messages
+         * get bubble widths cached for the nearest width bucket and are refined in small chunks when idle.
+         * Cached widths do not account for changes of fonts or style, until refined such messages may be
+         * laid out for stale widths. Disabled by default.
+         */
+        void setBubbleLayoutCacheEnabled(bool enable)
+        {
+            m_bubbleLayoutCache=enable;
+        }
+
+        bool isBubbleLayoutCacheEnabled() const noexcept
+        {
+            return m_bubbleLayoutCache;
+        }
+
+        /**
+         * @brief Enable painting bubbles of idle messages from snapshots.
+         * @param enable Flag.
+         *
+         * See AbstractChatMessage::setPaintedWhenIdle(). Disabled by default.
+         */
+        void setPaintedRowsEnabled(bool enable);
+
+        bool isPaintedRowsEnabled() const noexcept
+        {
+            return m_paintedRows;
+        }
+
         void setDateSubtitleEnabled(bool enable)
         {
             m_dateSubtitleEnabled=enable;
@@ -327,13 +447,17 @@ class ChatMessagesView : public AbstractChatMessagesView
         bool m_dateSubtitleEnabled=true;
 
         FuncItemsRequested m_onItemsRequested;
+        FuncItemRemoved m_onItemRemoved;
         MessageBuilder m_messageBuilder;
 
         QPointer<AbstractChatMessage> m_chatUnderMouse;
         QPoint m_lastMousePos;
-        std::map<Id,Data> m_selectedMessages;
+        MessageSelection<Id,SortValue,Message,Data> m_selectedMessages;
         std::optional<bool> m_mouseMoveUp;
 
+        //! Message with unread separator as evaluated by the last adjustment of the list, see adjustMessagesAround().
+        std::optional<Id> m_unreadSeparatorId;
+
         //! Set on this widget's own window losing activation (eventFilter()'s WindowDeactivate
         //! catch), cleared on the next genuine QEvent::MouseButtonPress anywhere in the app.
         //! While true, mouseMoveEvent() ignores what QMouseEvent::buttons() reports rather than
@@ -356,6 +480,16 @@ class ChatMessagesView : public AbstractChatMessagesView
         SingleShotTimer* m_resizeTimer=nullptr;
         SingleShotTimer* m_selectionModeTimer=nullptr;
 
+        bool m_bubbleLayoutCache=false;
+        bool m_paintedRows=false;
+        //! Messages with replayed bubble widths waiting to be refined, see refineMessagesSizes().
+        std::vector<Id> m_staleSizeMessages;
+        SingleShotTimer* m_refineSizesTimer=nullptr;
+
+        MessagePostQueue<Id,Data> m_postQueue;
+        size_t m_maxPostCommitCount=0;
+        SingleShotTimer* m_postTimer=nullptr;
+
     private:
 
         //! Clears the per-move drag-tracking state mouseMoveEvent() reads
@@ -375,17 +509,28 @@ class ChatMessagesView : public AbstractChatMessagesView
 
         void replaceSelectedData(Message* msg);
 
-        void doInsertMessage(const Data& item);
+        Message* doInsertMessage(const Data& item);
+        void doUpdateMessage(Message* msg, const Data& item);
         void doRemoveMessage(const Id& id);
         void doReorderMessage(const Id& id);
         void adjustCurrentMessagesList();
 
+        class MessageList;
+        void adjustMessagesAround(const std::vector<Message*>& touched);
+        void addNeighbourIds(const Id& id, std::vector<Id>& ids) const;
+        std::vector<Message*> loadedMessages(const std::vector<Id>& ids) const;
+        void keepUnreadSeparator(Message* msg);
+
         void onMessageClicked(const Id& id);
 
         void adjustMessagesSizes(std::vector<Message*>* messages=nullptr);
         int messageContentWidth() const;
         int defaultMessageContentWidth() const;
         void adjustMesssageSize(Message* msg);
+        void refineMessagesSizes();
+
+        void schedulePostCommit();
+        void commitPostedChunk(size_t maxCount);
 
         void onUserScrolled();
         void updateDateSubtitleText();
@@ -26,7 +26,12 @@ You may select, at your option, one of the above-listed licenses.
 #ifndef UISE_DESKTOP_CHATMESSAGETEXT_HPP
 #define UISE_DESKTOP_CHATMESSAGETEXT_HPP
 
+#include <functional>
+#include <memory>
+
 #include <QTextBrowser>
+#include <QTextDocument>
+#include <QThreadPool>
 
 #include <uise/desktop/uisedesktop.hpp>
 #include <uise/desktop/abstractchatmessage.hpp>
@@ -90,6 +95,83 @@ class UISE_DESKTOP_EXPORT ChatMessageTextBrowser : public QTextBrowser
         bool m_copyable=false;
 };
 
+/**
+ * @brief Pool of worker threads preparing documents of ChatMessageText off the GUI thread.
+ *
+ * When the pool is enabled ChatMessageText::loadText() does not parse the text on the GUI thread.
+ * Instead, a QTextDocument is built in a worker thread, then it is handed over to the widget
+ * that renegotiates the bubble width of its message. Until then the message is shown without text.
+ *
+ * Only parsing of the text and measuring of its natural width are moved off the GUI thread.
+ * The document is not wrapped in the worker, the widget wraps it for the bubble width in the GUI thread
+ * when the document is attached and whenever the width changes.
+ * Disabled by default.
+ */
+class UISE_DESKTOP_EXPORT ChatTextLayoutPool
+{
+    public:
+
+        struct Request
+        {
+            QString text;
+            bool markdown=true;
+            QFont font;
+            qreal documentMargin=0;
+        };
+
+        struct Result
+        {
+            std::unique_ptr<QTextDocument> document;
+            //! Ideal width of the document without wrapping.
+            qreal naturalWidth=0;
+        };
+
+        using Callback=std::function<void (std::shared_ptr<Result>)>;
+
+        static ChatTextLayoutPool& instance();
+
+        ~ChatTextLayoutPool();
+        ChatTextLayoutPool(const ChatTextLayoutPool&)=delete;
+        ChatTextLayoutPool& operator=(const ChatTextLayoutPool&)=delete;
+        ChatTextLayoutPool(ChatTextLayoutPool&&)=delete;
+        ChatTextLayoutPool& operator=(ChatTextLayoutPool&&)=delete;
+
+        void setEnabled(bool enable) noexcept
+        {
+            m_enabled=enable;
+        }
+
+        bool isEnabled() const noexcept
+        {
+            return m_enabled;
+        }
+
+        void setMaxThreadCount(int count);
+
+        int maxThreadCount() const;
+
+        /**
+         * @brief Prepare document in a worker thread.
+         * @param request Text and formatting of the document.
+         * @param callback Callback invoked in the GUI thread with the prepared document.
+         */
+        void prepare(Request request, Callback callback);
+
+        /**
+         * @brief Wait until all pending documents are prepared.
+         * @param msecs Timeout, -1 for infinite.
+         * @return True if all documents are prepared.
+         */
+        bool waitForDone(int msecs=-1);
+
+    private:
+
+        ChatTextLayoutPool();
+
+        QThreadPool m_pool;
+        bool m_enabled=false;
+};
+
 class ChatMessageText_p;
 
 class UISE_DESKTOP_EXPORT ChatMessageText : public AbstractChatMessageText
@@ -131,6 +213,8 @@ class UISE_DESKTOP_EXPORT ChatMessageText : public AbstractChatMessageText
     private:
 
         void adjustWrapWidth(int& value, bool add);
+        void attachPreparedText(size_t generation, ChatTextLayoutPool::Result& result);
+
         std::unique_ptr<ChatMessageText_p> pimpl;
 };
 
@@ -29,9 +29,16 @@ You may select, at your option, one of the above-listed licenses.
 #include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 
 #include <QDebug>
@@ -39,11 +46,15 @@ You may select, at your option, one of the above-listed licenses.
 #include <QPointer>
 #include <QEvent>
 #include <QResizeEvent>
+#include <QElapsedTimer>
 
 #include <uise/desktop/utils/pointerholder.hpp>
 #include <uise/desktop/utils/layout.hpp>
 #include <uise/desktop/utils/singleshottimer.hpp>
 #include <uise/desktop/utils/orientationinvariant.hpp>
+#include <uise/desktop/utils/scrollpositionestimator.hpp>
+#include <uise/desktop/utils/kineticscroller.hpp>
+#include <uise/desktop/utils/prefetchpolicy.hpp>
 
 #include <uise/desktop/verticalscrollbar.hpp>
 #include <uise/desktop/linkedlistview.hpp>
@@ -115,6 +126,35 @@ class UISE_DESKTOP_EXPORT FlyweightListView_q : public QObject
         std::function<void ()> listResizeHandler;
 };
 
+/**
+ * @brief Traits of ID index of FlyweightListView_p, ordered index is used by default.
+ */
+template <typename ItemT, typename IdIdxFn, typename IdComparer>
+struct FlyweightListViewIdIndex
+{
+    using type=boost::multi_index::ordered_unique<IdIdxFn,IdComparer>;
+
+    static auto ctorArgs(IdComparer idComparer)
+    {
+        return boost::make_tuple(IdIdxFn{},std::move(idComparer));
+    }
+};
+
+/**
+ * @brief Traits of hashed ID index of FlyweightListView_p selected with HashedIdIndex.
+ */
+template <typename ItemT, typename IdIdxFn, typename Hash, typename Pred>
+struct FlyweightListViewIdIndex<ItemT,IdIdxFn,HashedIdIndex<Hash,Pred>>
+{
+    using HashType=std::conditional_t<std::is_void<Hash>::value,std::hash<typename ItemT::IdType>,Hash>;
+    using type=boost::multi_index::hashed_unique<IdIdxFn,HashType,Pred>;
+
+    static auto ctorArgs(HashedIdIndex<Hash,Pred>)
+    {
+        return boost::make_tuple(size_t(0),IdIdxFn{},HashType{},Pred{});
+    }
+};
+
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 class FlyweightListView_p : public OrientationInvariant
 {
@@ -150,6 +190,16 @@ class FlyweightListView_p : public OrientationInvariant
 
         size_t prefetchThreshold() noexcept;
 
+        //! Item counts used by checkItemCount() at one edge of the list.
+        struct PrefetchWindow
+        {
+            size_t prefetch=0;
+            size_t threshold=0;
+            size_t maxHidden=0;
+        };
+        PrefetchWindow prefetchWindow(Direction direction);
+        double prefetchClockTime() const;
+
         size_t itemsCount() const noexcept;
 
         size_t visibleCount() const noexcept;
@@ -164,6 +214,7 @@ class FlyweightListView_p : public OrientationInvariant
         bool isFlyweightEnabled() const noexcept;
 
         void insertContinuousItems(const std::vector<ItemT>& items);
+        void insertItemsBatch(const std::vector<ItemT>& items);
 
         void clear(bool onDestroy=false);
 
@@ -173,6 +224,7 @@ class FlyweightListView_p : public OrientationInvariant
 
         bool hasItem(const typename ItemT::IdType& id) const noexcept;
         const ItemT* item(const typename ItemT::IdType& id) const noexcept;
+        const ItemT* neighbourItem(const typename ItemT::IdType& id, Direction direction) const noexcept;
         const ItemT* firstItem() const noexcept;
         const ItemT* lastItem() const noexcept;
 
@@ -218,6 +270,9 @@ class FlyweightListView_p : public OrientationInvariant
         void scroll(int delta);
 
         void wheelEvent(QWheelEvent *event);
+        void startScrollFrames();
+        void onScrollFrame(qint64 elapsed);
+        void stopScrollFrames();
         void updatePageStep();
 
         void viewportUpdated();
@@ -226,7 +281,7 @@ class FlyweightListView_p : public OrientationInvariant
 
         void resizeList();
 
-        void clearWidget(typename ItemT::WidgetType* widget);
+        void clearWidget(typename ItemT::WidgetType* widget, bool recycle=false);
         void removeItem(ItemT* item);
         void removeItem(const typename ItemT::IdType& id);
 
@@ -253,6 +308,15 @@ class FlyweightListView_p : public OrientationInvariant
 
         void updateScrollBarOrientation();
 
+        void setEstimatedItemCount(size_t count);
+        bool isScrollEstimationEnabled() const noexcept;
+        QScrollBar* mainScrollBar() const noexcept;
+        int estimatedWindowOffset() const;
+        int estimatedScrollBarMaximum() const;
+        void updateEstimatedScrollBar();
+        void requestEstimatedJump(int value);
+        void onMainSbarReleased();
+
         void setPrefetchScreensCount(double value);
         double prefetchScreensCount() const noexcept;
 
@@ -265,6 +329,9 @@ class FlyweightListView_p : public OrientationInvariant
         size_t prefetchItemCountAuto() noexcept;
         size_t prefetchItemCountEffective() noexcept;
 
+        void setAdaptivePrefetchEnabled(bool enable);
+        bool isAdaptivePrefetchEnabled() const noexcept;
+
         void setJumpEdgeControlEnabled(bool value);
         bool isJumpEdgeControlEnabled() const;
 
@@ -300,6 +367,11 @@ class FlyweightListView_p : public OrientationInvariant
 
         void updateListAlignment();
 
+        void setWidgetRecyclingLimit(size_t value);
+        size_t recycledWidgetCount() const noexcept;
+        QWidget* takeRecycledWidget(const std::type_index& type);
+        static void compactRecycledWidgets(std::vector<QPointer<QWidget>>& pool);
+
     public:
 
         using OrderIdxFn=boost::multi_index::const_mem_fun<
@@ -321,10 +393,7 @@ class FlyweightListView_p : public OrientationInvariant
                                     OrderIdxFn,
                                     OrderComparer
                     >,
-                    boost::multi_index::ordered_unique<
-                                    IdIdxFn,
-                                    IdComparer
-                    >
+                    typename FlyweightListViewIdIndex<ItemT,IdIdxFn,IdComparer>::type
                 >
             >;
 
@@ -344,6 +413,8 @@ class FlyweightListView_p : public OrientationInvariant
 
         typename FlyweightListView<ItemT>::RequestJumpCb m_homeRequestCb;
         typename FlyweightListView<ItemT>::RequestJumpCb m_endRequestCb;
+        typename FlyweightListView<ItemT>::RequestJumpToIndexCb m_jumpToIndexRequestCb;
+        typename FlyweightListView<ItemT>::ItemIndexCb m_itemIndexCb;
 
         typename FlyweightListView<ItemT>::InsertItemCb m_insertItemCb;
         typename FlyweightListView<ItemT>::RemoveItemCb m_removeItemCb;
@@ -397,6 +468,11 @@ class FlyweightListView_p : public OrientationInvariant
 
         bool m_scrollWheelHorizontal;
 
+        bool m_smoothScrolling;
+        KineticScroller m_kineticScroller;
+        SingleShotTimer m_scrollFrameTimer;
+        QElapsedTimer m_scrollFrameClock;
+
         ItemsContainer m_items;
         OrderComparer m_orderComparer;
 
@@ -405,6 +481,10 @@ class FlyweightListView_p : public OrientationInvariant
         double m_maxHiddenRatio;
         std::optional<size_t> m_prefetchItemCount;
 
+        bool m_adaptivePrefetch;
+        PrefetchPolicy m_prefetchPolicy;
+        QElapsedTimer m_prefetchClock;
+
         int m_currentBatchCount;
 
         bool m_enableJumpEdgeControl;
@@ -413,6 +493,12 @@ class FlyweightListView_p : public OrientationInvariant
         size_t m_jumpEdgeInvisibleItemCount;
 
         FlyweightListViewAlignment m_itemsAlignment;
+
+        size_t m_widgetRecyclingLimit;
+        std::unordered_map<std::type_index,std::vector<QPointer<QWidget>>> m_recycledWidgets;
+
+        ScrollPositionEstimator m_scrollEstimator;
+        std::optional<int> m_pendingEstimatedJump;
 };
 
 } // namespace detail
@@ -93,23 +93,27 @@ FlyweightListView_p<ItemT,OrderComparer,IdComparer>::FlyweightListView_p(
         m_vbarPolicy(Qt::ScrollBarAsNeeded),
         m_hbarPolicy(Qt::ScrollBarAsNeeded),
         m_scrollWheelHorizontal(true),
+        m_smoothScrolling(false),
         m_items(
           boost::make_tuple(
             boost::make_tuple(OrderIdxFn{},orderComparer),
-            boost::make_tuple(IdIdxFn{},std::move(idComparer))
+            FlyweightListViewIdIndex<ItemT,IdIdxFn,IdComparer>::ctorArgs(std::move(idComparer))
           )
         ),
         m_orderComparer(orderComparer),
         m_prefetchScreenCount(FlyweightListView<ItemT>::PrefetchScreensCountHint),
         m_prefetchThresholdRatio(FlyweightListView<ItemT>::PrefetchThresholdRatio),
         m_maxHiddenRatio(FlyweightListView<ItemT>::MaxHiddenRatio),
+        m_adaptivePrefetch(false),
         m_enableJumpEdgeControl(true),
         m_jumpEdge(nullptr),
         m_jumpEdgeOffset(FlyweightListView<ItemT>::DefaultJumpEdgeXOffset,FlyweightListView<ItemT>::DefaultJumpEdgeYOffset),
         m_jumpEdgeInvisibleItemCount(FlyweightListView<ItemT>::DefaultJumpInvisibleItemCount),
-        m_itemsAlignment(FlyweightListViewAlignment::Center)
+        m_itemsAlignment(FlyweightListViewAlignment::Center),
+        m_widgetRecyclingLimit(0)
 {
     m_currentBatchCount=0;    
+    m_prefetchClock.start();
 }
 
 //--------------------------------------------------------------------------
@@ -131,6 +135,8 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::resetCallbacks()
     m_userScrolledCb=decltype(m_userScrolledCb){};
     m_homeRequestCb=decltype(m_homeRequestCb){};
     m_endRequestCb=decltype(m_endRequestCb){};
+    m_jumpToIndexRequestCb=decltype(m_jumpToIndexRequestCb){};
+    m_itemIndexCb=decltype(m_itemIndexCb){};
     m_insertItemCb=decltype(m_insertItemCb){};
 }
 
@@ -186,6 +192,8 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::setupUi()
     updateScrollBarOrientation();
     QObject::connect(m_vbar,&QScrollBar::valueChanged,[this](int value){m_vScrollCb(value);});
     QObject::connect(m_hbar,&QScrollBar::valueChanged,[this](int value){m_hScrollCb(value);});
+    QObject::connect(m_vbar,&QScrollBar::sliderReleased,[this](){if (!isHorizontal()) onMainSbarReleased();});
+    QObject::connect(m_hbar,&QScrollBar::sliderReleased,[this](){if (isHorizontal()) onMainSbarReleased();});
 
     m_jumpEdge=new JumpEdge(m_view);
     m_jumpEdge->setDirection(m_stick);
@@ -347,6 +355,35 @@ size_t FlyweightListView_p<ItemT,OrderComparer,IdComparer>::prefetchThreshold()
     return prefetchItemWindow()*m_prefetchThresholdRatio;
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+typename FlyweightListView_p<ItemT,OrderComparer,IdComparer>::PrefetchWindow
+FlyweightListView_p<ItemT,OrderComparer,IdComparer>::prefetchWindow(Direction direction)
+{
+    auto visible=visibleCount();
+    if (!m_adaptivePrefetch || visible==0)
+    {
+        return PrefetchWindow{prefetchItemCountEffective(),prefetchThreshold(),maxHiddenItemsBeyondEdge()};
+    }
+
+    m_prefetchPolicy.setBaseScreens(m_prefetchScreenCount);
+    auto screens=m_prefetchPolicy.screens(direction,prefetchClockTime());
+    auto window=std::max(static_cast<size_t>(qRound(visible*screens)),size_t(1));
+
+    PrefetchWindow result;
+    result.prefetch=m_prefetchItemCount.value_or(window);
+    result.threshold=static_cast<size_t>(window*m_prefetchThresholdRatio);
+    result.maxHidden=static_cast<size_t>(window*m_maxHiddenRatio);
+    return result;
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+double FlyweightListView_p<ItemT,OrderComparer,IdComparer>::prefetchClockTime() const
+{
+    return static_cast<double>(m_prefetchClock.elapsed());
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 size_t FlyweightListView_p<ItemT,OrderComparer,IdComparer>::itemsCount() const noexcept
@@ -398,6 +435,27 @@ const ItemT* FlyweightListView_p<ItemT,OrderComparer,IdComparer>::item(const typ
     return (it!=idx.end())?&(*it):nullptr;
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+const ItemT* FlyweightListView_p<ItemT,OrderComparer,IdComparer>::neighbourItem(const typename ItemT::IdType &id, Direction direction) const noexcept
+{
+    const auto& idx=itemIdx();
+    auto it=idx.find(id);
+    if (it==idx.end())
+    {
+        return nullptr;
+    }
+
+    const auto& order=itemOrder();
+    auto orderIt=m_items.template project<0>(it);
+    if (direction==Direction::HOME)
+    {
+        return (orderIt==order.begin())?nullptr:&(*std::prev(orderIt));
+    }
+    ++orderIt;
+    return (orderIt!=order.end())?&(*orderIt):nullptr;
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 const auto& FlyweightListView_p<ItemT,OrderComparer,IdComparer>::itemOrder() const noexcept
@@ -670,16 +728,9 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::compensateSizeChange()
     {
         oldItem=&(*it);
     }
-    else
+    else if (auto it=order.lower_bound(m_firstViewportSortValue); it!=order.end())
     {
-        for (auto it=order.begin();it!=order.end();++it)
-        {
-            if (m_orderComparer(m_firstViewportSortValue,it->sortValue()) || itemOrdersEqual(m_firstViewportSortValue,it->sortValue()))
-            {
-                oldItem=&(*it);
-                break;
-            }
-        }
+        oldItem=&(*it);
     }
     if (!oldItem)
     {
@@ -1044,88 +1095,146 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::reorderItem(const Item
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::insertContinuousItems(const std::vector<ItemT>& items)
+{
+    // continuous items are usually the response to a request of items, account latency of the backend
+    const auto* first=firstItem();
+    if (!items.empty() && first!=nullptr)
+    {
+        auto direction=(m_orderComparer(items.front().sortValue(),first->sortValue())
+                        || m_orderComparer(items.back().sortValue(),first->sortValue()))
+                        ?Direction::HOME:Direction::END;
+        m_prefetchPolicy.requestFinished(direction,prefetchClockTime());
+    }
+    else
+    {
+        // empty response or initial load, direction is unknown, pending requests must not be accounted later
+        m_prefetchPolicy.requestCancelled(Direction::HOME);
+        m_prefetchPolicy.requestCancelled(Direction::END);
+    }
+
+    insertItemsBatch(items);
+    checkInvariants("insertContinuousItems");
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::insertItemsBatch(const std::vector<ItemT>& items)
 {
     if (items.empty())
     {
         return;
     }
 
-    // Insert every item into the sort-order/id container first, WITHOUT asking
-    // insertItemToContainer() for an anchor widget yet (findAfterWidget=false). Computing the
-    // anchor up front, at i==0, as this used to, is unsafe: a *later* iteration's dedup-by-id
-    // branch (see insertItemToContainer() above) can removeItem() an existing entry -- and
-    // that entry can be the very widget just captured as the anchor -- leaving
-    // insertWidgetsAfter() a dangling/orphaned pointer (the "insertWidgets() silently orphans
-    // the entire list" defect). Look the anchor up once, after every container mutation this
-    // batch will make is already done.
-    std::vector<QWidget*> widgets;
-    widgets.reserve(items.size());
+    auto lessItem=[this](const ItemT* l, const ItemT* r)
+    {
+        return m_orderComparer(l->sortValue(),r->sortValue());
+    };
+
+    // sort once, batches loaded by pages are usually sorted already
+    std::vector<const ItemT*> sorted;
+    sorted.reserve(items.size());
     for (const auto& item : items)
     {
-        insertItemToContainer(item,false);
-        widgets.push_back(item.widget());
+        sorted.push_back(&item);
+    }
+    if (!std::is_sorted(sorted.begin(),sorted.end(),lessItem))
+    {
+        std::stable_sort(sorted.begin(),sorted.end(),lessItem);
     }
 
-    const auto& idx=itemIdx();
-    const auto& order=itemOrder();
-
-    QWidget* afterWidget=nullptr;
-    bool contiguous=false;
-    auto frontIdxIt=idx.find(items.front().id());
-    if (frontIdxIt!=idx.end())
-    {
-        auto orderIt=m_items.template project<0>(frontIdxIt);
-        if (orderIt!=order.begin())
-        {
-            auto beforeIt=orderIt;
-            --beforeIt;
-            afterWidget=beforeIt->widget();
-        }
-
-        // Verify the batch really is contiguous in the final sort order -- "items must be
-        // pre-sorted" (documented on the public overload) doesn't imply "contiguous with
-        // what's already loaded"; ChatMessagesView::insertFetched()'s incremental branch, for
-        // instance, hands whatever range the server returned. insertWidgetsAfter() places the
-        // whole batch as one contiguous run after a single anchor -- if some other,
-        // already-loaded item actually belongs between two entries of this batch, that
-        // placement would silently diverge from sort order, which is exactly the precondition
-        // for checkItemCount()'s underflow defect.
-        contiguous=true;
-        auto checkIt=orderIt;
-        for (size_t i=0;i<widgets.size();++i)
-        {
-            if (checkIt==order.end() || checkIt->widget()!=widgets[i])
+    // Put every item to the container first, each insertion is hinted with position right after
+    // the previous one, so a batch appended or prepended as a whole costs amortized constant time per item.
+    // Widgets are not inserted into the linked list until all container mutations are done:
+    // replacing an item with the same ID removes the widget of the old item, and that widget
+    // could be the very anchor captured for the widgets inserted before.
+    auto& idx=itemIdx();
+    auto& order=itemOrder();
+    std::unordered_set<const ItemT*> batch;
+    batch.reserve(sorted.size());
+    auto hint=order.end();
+    for (const auto* item : sorted)
+    {
+        auto existing=idx.find(item->id());
+        if (existing!=idx.end())
+        {
+            if (existing->widget()==item->widget())
             {
-                contiguous=false;
-                break;
+                // see comment in insertItemToContainer()
+                idx.modify(existing,[](auto&){});
+                auto it=m_items.template project<0>(existing);
+                batch.insert(&(*it));
+                hint=std::next(it);
+                continue;
             }
-            ++checkIt;
+
+            batch.erase(&(*existing));
+            removeItem(item->id());
+
+            // removed item could be the hint
+            hint=order.end();
         }
+
+        auto it=order.insert(hint,*item);
+        configureWidget(&(*it));
+        batch.insert(&(*it));
+        hint=std::next(it);
     }
 
-    if (contiguous)
+    // Walk final order once from the first item of the batch and split the batch into runs of
+    // adjacent items, each run goes to the linked list with a single call anchored to the item
+    // preceding the run. That item is never a member of the batch, so it is already in its place.
+    const ItemT* minItem=nullptr;
+    for (const auto* item : batch)
+    {
+        if (minItem==nullptr || lessItem(item,minItem))
+        {
+            minItem=item;
+        }
+    }
+    auto it=m_items.template project<0>(idx.find(minItem->id()));
+    while (it!=order.begin() && !lessItem(&(*std::prev(it)),&(*it)))
     {
-        m_llist->insertWidgetsAfter(widgets,afterWidget);
+        --it;
     }
-    else
+
+    struct Run
     {
-        // Fall back to placing items one at a time -- correct regardless of ordering, just
-        // O(n^2) for this batch. Each item is already registered in the container above, so
-        // insertItemToContainer() here only re-derives its (now authoritative) individual
-        // anchor; it does not insert a duplicate.
-        if (fwlvDebugEnabled())
+        QWidget* afterWidget;
+        std::vector<QWidget*> widgets;
+    };
+    std::vector<Run> runs;
+    bool inRun=false;
+    size_t found=0;
+    for (;it!=order.end() && found<batch.size();++it)
+    {
+        if (batch.find(&(*it))==batch.end())
         {
-            std::cerr << "CHAT-FWLV-DEBUG: insertContinuousItems() batch of " << items.size()
-                       << " items is not contiguous with the existing sort order, falling back "
-                          "to per-item insert" << std::endl;
+            inRun=false;
+            continue;
         }
-        for (const auto& item : items)
+        if (!inRun)
         {
-            m_llist->insertWidgetAfter(item.widget(),insertItemToContainer(item,true));
+            QWidget* afterWidget=nullptr;
+            if (it!=order.begin())
+            {
+                afterWidget=std::prev(it)->widget();
+            }
+            runs.push_back(Run{afterWidget,{}});
+            inRun=true;
         }
+        runs.back().widgets.push_back(it->widget());
+        ++found;
     }
 
-    checkInvariants("insertContinuousItems");
+    if (fwlvDebugEnabled() && runs.size()>1)
+    {
+        std::cerr << "CHAT-FWLV-DEBUG: batch of " << items.size()
+                   << " items is split into " << runs.size() << " runs" << std::endl;
+    }
+    for (const auto& run : runs)
+    {
+        m_llist->insertWidgetsAfter(run.widgets,run.afterWidget);
+    }
 }
 
 //--------------------------------------------------------------------------
@@ -1197,6 +1306,8 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::clear(bool onDestroy)
     m_lastViewportSortValue=ItemT::defaultSortValue();
     m_wheelOffsetAccumulated=0.0f;
     m_wheelOffsetAccumulatedOther=0.0f;
+    stopScrollFrames();
+    m_prefetchPolicy.reset();
     m_atBegin=true;
     m_atEnd=true;
     m_firstItem=nullptr;
@@ -1268,11 +1379,39 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::wheelEvent(QWheelEvent
            return numSteps;
        };
 
-       scrollMain=evalOffset(m_wheelOffsetAccumulated,false);
+       if (m_smoothScrolling)
+       {
+           // main axis is scrolled by the animator that keeps fractions of pixels itself
+           auto deltaPos=qreal(oprop(angleDelta,OProp::pos));
+           auto distance=m_singleStep*QApplication::wheelScrollLines()*deltaPos/120;
+           if (distance!=0)
+           {
+               m_kineticScroller.scrollBy(-distance);
+           }
+       }
+       else
+       {
+           scrollMain=evalOffset(m_wheelOffsetAccumulated,false);
+       }
        scrollOther=evalOffset(m_wheelOffsetAccumulatedOther,true);
    }
 
-   scroll(-scrollMain);
+   if (m_smoothScrolling)
+   {
+       if (scrollMain!=0)
+       {
+           m_kineticScroller.moveBy(-scrollMain,event->timestamp());
+       }
+       if (event->phase()==Qt::ScrollEnd)
+       {
+           m_kineticScroller.release(event->timestamp());
+       }
+       startScrollFrames();
+   }
+   else
+   {
+       scroll(-scrollMain);
+   }
 
    if (isVertical() && !m_scrollWheelHorizontal)
    {
@@ -1306,6 +1445,60 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::wheelEvent(QWheelEvent
    event->accept();
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::startScrollFrames()
+{
+    if (!m_kineticScroller.isActive() || m_scrollFrameClock.isValid())
+    {
+        return;
+    }
+
+    // the first frame is applied right away so that scrolling responds without a frame of latency
+    m_scrollFrameClock.start();
+    onScrollFrame(KineticScroller::DefaultFrameInterval);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::onScrollFrame(qint64 elapsed)
+{
+    auto delta=m_kineticScroller.advance(static_cast<double>(elapsed));
+    if (delta!=0)
+    {
+        auto oldPos=oprop(m_llist,OProp::pos);
+        scroll(delta);
+        if (oprop(m_llist,OProp::pos)==oldPos)
+        {
+            // edge of the list is reached
+            m_kineticScroller.stop();
+        }
+    }
+
+    if (!m_kineticScroller.isActive())
+    {
+        stopScrollFrames();
+        return;
+    }
+
+    m_scrollFrameTimer.shot(
+        KineticScroller::DefaultFrameInterval,
+        [this]()
+        {
+            onScrollFrame(m_scrollFrameClock.restart());
+        }
+    );
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::stopScrollFrames()
+{
+    m_kineticScroller.stop();
+    m_scrollFrameTimer.clear();
+    m_scrollFrameClock.invalidate();
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::scrollTo(const std::function<int (int, int, int)> &cb)
@@ -1336,6 +1529,11 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::scrollTo(const std::fu
     newCoordinate=qBound(minPos,newCoordinate,maxPos);
     if (newCoordinate!=posCoordinate)
     {
+        if (viewportSize>0)
+        {
+            m_prefetchPolicy.scrolled(static_cast<double>(posCoordinate-newCoordinate)/viewportSize,prefetchClockTime());
+        }
+
         setOProp(pos,OProp::pos,newCoordinate);
         m_llist->move(pos);
         viewportUpdated();
@@ -1457,7 +1655,7 @@ const ItemT* FlyweightListView_p<ItemT,OrderComparer,IdComparer>::itemAtPos(cons
 #if 0
     qDebug() << printCurrentDateTime() << ": itemAtPos() "<<pos << " m_llist->size() " << m_llist->size();
 #endif
-    const auto* widget=directChildWidgetAt(m_llist,pos);
+    const auto* widget=m_llist->widgetAtPos(pos);
     return PointerHolder::getProperty<const ItemT*>(widget,ItemT::Property);
 }
 
@@ -1521,7 +1719,7 @@ const ItemT* FlyweightListView_p<ItemT,OrderComparer,IdComparer>::lastViewportIt
 
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
-void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::clearWidget(typename ItemT::WidgetType* widget)
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::clearWidget(typename ItemT::WidgetType* widget, bool recycle)
 {
     if (!widget)
     {
@@ -1538,9 +1736,86 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::clearWidget(typename I
     widget->removeEventFilter(&m_qobjectHelper);
     QObject::disconnect(widget,nullptr,&m_qobjectHelper,nullptr);
 
+    if (recycle && m_widgetRecyclingLimit!=0)
+    {
+        // taken widget is already hidden and stays parented to the list, so it is ready for reuse as is
+        auto& pool=m_recycledWidgets[std::type_index(typeid(*widget))];
+        if (pool.size()>=m_widgetRecyclingLimit)
+        {
+            compactRecycledWidgets(pool);
+        }
+        if (pool.size()<m_widgetRecyclingLimit)
+        {
+            pool.emplace_back(widget);
+            return;
+        }
+    }
+
     ItemT::dropWidget(widget);
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::setWidgetRecyclingLimit(size_t value)
+{
+    m_widgetRecyclingLimit=value;
+
+    for (auto& it : m_recycledWidgets)
+    {
+        auto& pool=it.second;
+        compactRecycledWidgets(pool);
+        while (pool.size()>m_widgetRecyclingLimit)
+        {
+            ItemT::dropWidget(pool.back().data());
+            pool.pop_back();
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::compactRecycledWidgets(std::vector<QPointer<QWidget>>& pool)
+{
+    // widgets destroyed while they were kept in the pool must neither be dropped nor counted
+    pool.erase(std::remove_if(pool.begin(),pool.end(),[](const QPointer<QWidget>& widget){return widget.isNull();}),pool.end());
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+size_t FlyweightListView_p<ItemT,OrderComparer,IdComparer>::recycledWidgetCount() const noexcept
+{
+    size_t count=0;
+    for (const auto& it : m_recycledWidgets)
+    {
+        count+=static_cast<size_t>(std::count_if(it.second.begin(),it.second.end(),[](const QPointer<QWidget>& widget){return !widget.isNull();}));
+    }
+    return count;
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+QWidget* FlyweightListView_p<ItemT,OrderComparer,IdComparer>::takeRecycledWidget(const std::type_index& type)
+{
+    auto it=m_recycledWidgets.find(type);
+    if (it==m_recycledWidgets.end())
+    {
+        return nullptr;
+    }
+
+    // skip widgets destroyed while they were kept in the pool
+    auto& pool=it->second;
+    while (!pool.empty())
+    {
+        QWidget* widget=pool.back();
+        pool.pop_back();
+        if (widget!=nullptr)
+        {
+            return widget;
+        }
+    }
+    return nullptr;
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::removeItem(const typename ItemT::IdType &id)
@@ -1630,9 +1905,8 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::checkItemCount()
         return;
     }
 
-    auto maxHidden=maxHiddenItemsBeyondEdge();
-    auto minPrefetch=prefetchThreshold();
-    auto prefetch=prefetchItemCountEffective();
+    auto before=prefetchWindow(Direction::HOME);
+    auto after=prefetchWindow(Direction::END);
 
     size_t hiddenBefore=0;
     size_t from=0;
@@ -1663,7 +1937,7 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::checkItemCount()
     bool canFetchBefore=first && m_orderComparer(m_minSortValue,first->sortValue());
 
 #ifdef UISE_DESKTOP_FLYWEIGHTLISTVIEW_DEBUG
-    std::cout << printCurrentDateTime() << ": FlyweightListView_p::checkItemCount hiddenBefore "<<hiddenBefore<<" minPrefetch "<<minPrefetch << " prefetch " << prefetch << " maxHidden "<<maxHidden
+    std::cout << printCurrentDateTime() << ": FlyweightListView_p::checkItemCount hiddenBefore "<<hiddenBefore<<" minPrefetch "<<before.threshold << " prefetch " << before.prefetch << " maxHidden "<<before.maxHidden
              << " m_prefetchItemWindow=" << m_prefetchItemWindow
              << " visibleCount()=" << visibleCount()
              << " m_prefetchScreenCount=" << m_prefetchScreenCount
@@ -1675,11 +1949,11 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::checkItemCount()
              << " to="<<to;
 #endif
 
-    if ((m_currentBatchCount>0 || hiddenBefore<minPrefetch) && canFetchBefore)
+    if ((m_currentBatchCount>0 || hiddenBefore<before.threshold) && canFetchBefore)
     {
         if (m_requestItemsCb)
         {
-            if (hiddenBefore<minPrefetch)
+            if (hiddenBefore<before.threshold)
             {
                 m_currentBatchCount=m_prefetchScreenCount;
             }
@@ -1688,12 +1962,13 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::checkItemCount()
             {
                 m_currentBatchCount=0;
             }
-            m_requestItemsCb(firstItem(),prefetch,Direction::HOME);
+            m_prefetchPolicy.requestStarted(Direction::HOME,prefetchClockTime());
+            m_requestItemsCb(firstItem(),before.prefetch,Direction::HOME);
         }
     }
-    else if (hiddenBefore>maxHidden)
+    else if (hiddenBefore>before.maxHidden)
     {
-        removeExtraItemsFromBegin(hiddenBefore-maxHidden);
+        removeExtraItemsFromBegin(hiddenBefore-before.maxHidden);
     }
 
     size_t hiddenAfter=0;
@@ -1727,11 +2002,11 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::checkItemCount()
 #endif
 
     bool canFetchAfter=last && m_orderComparer(last->sortValue(),m_maxSortValue);
-    if ((m_currentBatchCount>0 || hiddenAfter<minPrefetch)  && canFetchAfter)
+    if ((m_currentBatchCount>0 || hiddenAfter<after.threshold)  && canFetchAfter)
     {
         if (m_requestItemsCb)
         {
-            if (hiddenAfter<minPrefetch)
+            if (hiddenAfter<after.threshold)
             {
                 m_currentBatchCount=m_prefetchScreenCount;
             }
@@ -1740,12 +2015,13 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::checkItemCount()
             {
                 m_currentBatchCount=0;
             }
-            m_requestItemsCb(lastItem(),prefetch,Direction::END);
+            m_prefetchPolicy.requestStarted(Direction::END,prefetchClockTime());
+            m_requestItemsCb(lastItem(),after.prefetch,Direction::END);
         }
     }
-    else if (hiddenAfter>maxHidden)
+    else if (hiddenAfter>after.maxHidden)
     {
-        removeExtraItemsFromEnd(hiddenAfter-maxHidden);
+        removeExtraItemsFromEnd(hiddenAfter-after.maxHidden);
     }
 
     if (!canFetchBefore && !canFetchAfter)
@@ -1899,7 +2175,7 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::removeExtraItemsFromBe
 #ifdef UISE_DESKTOP_FLYWEIGHTLISTVIEW_DEBUG
         qDebug() << printCurrentDateTime() << ": Removed item "<<it->sortValue()<< " before viewport";
 #endif
-        clearWidget(it->widget());
+        clearWidget(it->widget(),true);
         it=order.erase(it);
     }
 
@@ -1936,7 +2212,7 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::removeExtraItemsFromEn
 #ifdef UISE_DESKTOP_FLYWEIGHTLISTVIEW_DEBUG
         qDebug() << printCurrentDateTime() << ": Removed item "<<it->sortValue()<< " after viewport";
 #endif
-        clearWidget(it->widget());
+        clearWidget(it->widget(),true);
         nit = decltype(it){order.erase(std::next(it).base())};
     }
 
@@ -1950,6 +2226,14 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::updateScrollBars()
     m_vbar->blockSignals(true);
     m_hbar->blockSignals(true);
 
+    auto estimate=isScrollEstimationEnabled();
+    if (estimate)
+    {
+        m_scrollEstimator.measureWindow(m_items.size(),oprop(m_llist,OProp::size));
+    }
+    auto estimateV=estimate && !isHorizontal();
+    auto estimateH=estimate && isHorizontal();
+
     switch (m_vbarPolicy)
     {
         case Qt::ScrollBarAlwaysOff:
@@ -1958,17 +2242,24 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::updateScrollBars()
 
         case Qt::ScrollBarAlwaysOn:
             m_vbarHolder->setVisible(true);
-            m_vbar->setMaximum(0);
+            if (!estimateV)
+            {
+                m_vbar->setMaximum(0);
+            }
         break;
 
         case Qt::ScrollBarAsNeeded:
-            m_vbarHolder->setVisible(m_view->height()<m_llist->height());
+            m_vbarHolder->setVisible(estimateV?(estimatedScrollBarMaximum()>0):(m_view->height()<m_llist->height()));
         break;
 
         default:
         break;
     }
-    if (m_view->height()<m_llist->height())
+    if (estimateV)
+    {
+        updateEstimatedScrollBar();
+    }
+    else if (m_view->height()<m_llist->height())
     {
         m_vbar->setMaximum(m_llist->height()-m_view->height());
         m_vbar->setValue(-m_llist->y());
@@ -1990,13 +2281,17 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::updateScrollBars()
         break;
 
         case Qt::ScrollBarAsNeeded:
-            m_hbar->setVisible(m_view->width()<m_llist->width());
+            m_hbar->setVisible(estimateH?(estimatedScrollBarMaximum()>0):(m_view->width()<m_llist->width()));
         break;
 
         default:
         break;
     }
-    if (m_view->width()<m_llist->width())
+    if (estimateH)
+    {
+        updateEstimatedScrollBar();
+    }
+    else if (m_view->width()<m_llist->width())
     {
         m_hbar->setMaximum(m_llist->width()-m_view->width());
         m_hbar->setValue(-m_llist->x());
@@ -2015,11 +2310,140 @@ void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::updateScrollBars()
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::onMainSbarChanged(int value)
 {
+    if (isScrollEstimationEnabled())
+    {
+        // value is estimated position in the whole list, convert it to position in the loaded items
+        auto local=value-estimatedWindowOffset();
+        auto localMax=std::max(0,oprop(m_llist,OProp::size)-oprop(m_view,OProp::size));
+        auto outside=local<0?-local:local-localMax;
+        if (outside>0)
+        {
+            if (mainScrollBar()->isSliderDown())
+            {
+                // wait until the thumb is released, otherwise every step of dragging would request a jump
+                m_pendingEstimatedJump=value;
+                return;
+            }
+            if (outside>static_cast<int>(m_pageStep))
+            {
+                requestEstimatedJump(value);
+                return;
+            }
+
+            // close to the loaded items, scroll to the edge and let prefetching load the rest
+            local=std::clamp(local,0,localMax);
+        }
+        m_pendingEstimatedJump.reset();
+        value=local;
+    }
+
     auto oldPos=oprop(m_llist,OProp::pos);
     auto diff=-value-oldPos;
     scroll(-diff);
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::onMainSbarReleased()
+{
+    if (m_pendingEstimatedJump)
+    {
+        requestEstimatedJump(m_pendingEstimatedJump.value());
+    }
+    else if (isScrollEstimationEnabled())
+    {
+        updateScrollBars();
+    }
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::setEstimatedItemCount(size_t count)
+{
+    m_scrollEstimator.setTotalCount(count);
+    m_pendingEstimatedJump.reset();
+    updateScrollBars();
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+bool FlyweightListView_p<ItemT,OrderComparer,IdComparer>::isScrollEstimationEnabled() const noexcept
+{
+    return m_scrollEstimator.isEnabled() && static_cast<bool>(m_itemIndexCb);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+QScrollBar* FlyweightListView_p<ItemT,OrderComparer,IdComparer>::mainScrollBar() const noexcept
+{
+    return isHorizontal()?m_hbar:m_vbar;
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+int FlyweightListView_p<ItemT,OrderComparer,IdComparer>::estimatedWindowOffset() const
+{
+    auto first=firstItem();
+    if (first==nullptr)
+    {
+        return 0;
+    }
+    return m_scrollEstimator.position(m_itemIndexCb(first));
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+int FlyweightListView_p<ItemT,OrderComparer,IdComparer>::estimatedScrollBarMaximum() const
+{
+    auto viewExtent=oprop(m_view,OProp::size);
+    auto localMax=std::max(0,oprop(m_llist,OProp::size)-viewExtent);
+    auto windowMax=estimatedWindowOffset()+localMax;
+
+    auto last=lastItem();
+    if (last!=nullptr && m_itemIndexCb(last)+1>=m_scrollEstimator.totalCount())
+    {
+        // the end of the list is loaded, so the end of the scrollbar must be exact
+        return windowMax;
+    }
+    return std::max(m_scrollEstimator.totalExtent()-viewExtent,windowMax);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::updateEstimatedScrollBar()
+{
+    auto bar=mainScrollBar();
+    bar->setMaximum(estimatedScrollBarMaximum());
+
+    // while the thumb is dragged its position is the source of truth
+    if (!bar->isSliderDown())
+    {
+        bar->setValue(estimatedWindowOffset()-oprop(m_llist,OProp::pos));
+    }
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::requestEstimatedJump(int value)
+{
+    m_pendingEstimatedJump.reset();
+
+    auto bar=mainScrollBar();
+    auto modifiers=QApplication::keyboardModifiers();
+    if (value<=bar->minimum())
+    {
+        jumpToEdge(Direction::HOME,true,modifiers);
+    }
+    else if (value>=bar->maximum())
+    {
+        jumpToEdge(Direction::END,true,modifiers);
+    }
+    else if (m_jumpToIndexRequestCb)
+    {
+        m_jumpToIndexRequestCb(m_scrollEstimator.itemIndex(value),modifiers);
+    }
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::onOtherSbarChanged(int value)
@@ -2092,6 +2516,20 @@ size_t FlyweightListView_p<ItemT,OrderComparer,IdComparer>::prefetchItemCountEff
     return m_prefetchItemCount.value_or(prefetchItemCountAuto());
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::setAdaptivePrefetchEnabled(bool enable)
+{
+    m_adaptivePrefetch=enable;
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+bool FlyweightListView_p<ItemT,OrderComparer,IdComparer>::isAdaptivePrefetchEnabled() const noexcept
+{
+    return m_adaptivePrefetch;
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView_p<ItemT,OrderComparer,IdComparer>::updateJumpEdgeVisibility()
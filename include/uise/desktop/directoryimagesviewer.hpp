@@ -30,7 +30,7 @@ You may select, at your option, one of the above-listed licenses.
 #include <filesystem>
 
 #include <uise/desktop/uisedesktop.hpp>
-#include <uise/desktop/pixmapproducer.hpp>
+#include <uise/desktop/asyncpixmapsource.hpp>
 #include <uise/desktop/frame.hpp>
 
 class QLineEdit;
@@ -40,15 +40,12 @@ UISE_DESKTOP_NAMESPACE_BEGIN
 class PushButton;
 class AbstractImageViewer;
 
-class UISE_DESKTOP_EXPORT DirectoryImagesSource : public PixmapSource
+//! Images are decoded in worker threads, see AsyncPixmapSource.
+class UISE_DESKTOP_EXPORT DirectoryImagesSource : public AsyncPixmapSource
 {
     public:
 
-        using PixmapSource::PixmapSource;
-
-    protected:
-
-        void doLoadPixmap(const PixmapKey& key) override;
+        using AsyncPixmapSource::AsyncPixmapSource;
 };
 
 class UISE_DESKTOP_EXPORT DirectoryImagesViewer : public WidgetQFrame
@@ -64,6 +64,20 @@ struct HasDropWidget<T,
     constexpr static const bool value=true;
 };
 
+template <typename T, typename Enable=void>
+struct HasRebindWidget
+{
+    constexpr static const bool value=false;
+};
+
+template <typename T>
+struct HasRebindWidget<T,
+            std::enable_if_t<std::is_same<decltype(&T::rebindWidget),decltype(&T::rebindWidget)>::value>
+        >
+{
+    constexpr static const bool value=true;
+};
+
 template <typename T, typename Enable=void>
 struct HasDefaultId
 {
@@ -103,6 +117,12 @@ struct HasDefaultSortValue<T,
  *  - WidgetType* TraitsT::widget(ItemType&);
  *  - auto TraitsT::sortValue(const ItemType&);
  *  - IdType TraitsT::id(const ItemType&);
+ *
+ * Optional static methods:
+ *
+ *  - void TraitsT::dropWidget(QWidget*) to drop widget removed from view;
+ *  - void TraitsT::rebindWidget(ItemType&, WidgetType*) to bind a recycled widget to new item data,
+ *    see FlyweightListView::rebindRecycledWidget().
  */
 template <typename TraitsT>
 class FlyweightListItem
@@ -208,6 +228,27 @@ class FlyweightListItem
             dropWidgetHandler()(widget);
         }
 
+        /**
+         * @brief Check if widgets of this item type can be rebound to new item data.
+         * @return Query result.
+         */
+        constexpr static bool canRebindWidget() noexcept
+        {
+            return detail::HasRebindWidget<TraitsT>::value;
+        }
+
+        /**
+         * @brief Bind a widget taken from the recycle pool to the wrapped item.
+         * @param widget Widget to bind.
+         *
+         * TraitsT::rebindWidget() must update the widget's contents from the item and make the item refer to the widget.
+         */
+        void rebindWidget(WidgetType* widget)
+        {
+            static_assert(canRebindWidget(),"TraitsT::rebindWidget(ItemType&,WidgetType*) must be defined to rebind widgets");
+            TraitsT::rebindWidget(m_item,widget);
+        }
+
         /**
          * @brief Get handler to be used for dropping widget drom view.
          * @return Handler.
@@ -34,6 +34,7 @@ You may select, at your option, one of the above-listed licenses.
 
 #include <uise/desktop/uisedesktop.hpp>
 #include <uise/desktop/utils/enums.hpp>
+#include <uise/desktop/utils/prefetchpolicy.hpp>
 
 class QScrollBar;
 
@@ -70,6 +71,21 @@ struct ComparerWithOrder
     Order order;
 };
 
+/**
+ * @brief Selector of hashed index for looking up items by ID.
+ *
+ * Use it as IdComparer template argument of FlyweightListView to replace the default ordered ID index
+ * with a hashed one, so that looking up items by ID takes constant time instead of comparisons
+ * down a tree. Items are still kept sorted by their sort values.
+ *
+ * @tparam Hash Hash of item ID, if void then std::hash<ItemT::IdType> is used.
+ * @tparam Pred Equality predicate of item IDs.
+ */
+template <typename Hash=void, typename Pred=std::equal_to<>>
+struct HashedIdIndex
+{
+};
+
 enum class FlyweightListViewAlignment : int
 {
     Center,
@@ -104,6 +120,8 @@ class FlyweightListView : public QFrame
         using RequestItemsCb=std::function<void (const ItemT*,size_t,Direction)>;
         using ItemRangeCb=std::function<void (const ItemT*,const ItemT*)>;
         using RequestJumpCb=std::function<void (bool,Qt::KeyboardModifiers)>;
+        using RequestJumpToIndexCb=std::function<void (size_t,Qt::KeyboardModifiers)>;
+        using ItemIndexCb=std::function<size_t (const ItemT*)>;
 
         using InsertItemCb=std::function<void (ItemT*)>;
         using RemoveItemCb=std::function<void (typename ItemT::WidgetType*)>;
@@ -290,6 +308,47 @@ class FlyweightListView : public QFrame
          */
         void setRequestEndCb(RequestJumpCb cb) noexcept;
 
+        /**
+         * @brief Set callback function used to report that user dragged scrollbar to an item that is not loaded into the view.
+         * @param cb Callback function, its first argument is an index of the item in the whole list.
+         *
+         * Used only when scroll position estimation is enabled, see setEstimatedItemCount().
+         * Dragging to the very beginning or end of the scrollbar is reported with RequestHomeCb or RequestEndCb instead.
+         */
+        void setRequestJumpToIndexCb(RequestJumpToIndexCb cb) noexcept;
+
+        /**
+         * @brief Set callback function used to get index of an item in the whole list including items that are not loaded.
+         * @param cb Callback function.
+         *
+         * Required for scroll position estimation, see setEstimatedItemCount().
+         */
+        void setItemIndexCb(ItemIndexCb cb) noexcept;
+
+        /**
+         * @brief Set total number of items in the whole list including items that are not loaded into the view.
+         * @param count Number of items, 0 disables estimation.
+         *
+         * When the total number is set together with ItemIndexCb the scrollbar of the main axis represents the whole list
+         * instead of the loaded items only. Extent of the list is estimated as the total number of items multiplied by
+         * the average extent of the items measured so far, the average is refined as new items are loaded.
+         * Releasing the scrollbar thumb outside of the loaded items requests a jump with RequestJumpToIndexCb,
+         * RequestHomeCb or RequestEndCb.
+         */
+        void setEstimatedItemCount(size_t count);
+
+        /**
+         * @brief Get total number of items used for scroll position estimation.
+         * @return Query result.
+         */
+        size_t estimatedItemCount() const noexcept;
+
+        /**
+         * @brief Get average extent of the item used for scroll position estimation.
+         * @return Query result.
+         */
+        double estimatedItemExtent() const noexcept;
+
         /**
          * @brief Set callback function used to notify listener that an item was inserted into the list.
          * @param cb Callback function.
@@ -335,6 +394,23 @@ class FlyweightListView : public QFrame
          */
         bool isWheelHorizontaScrollEnabled() const noexcept;
 
+        /**
+         * @brief Enable or disable smooth scrolling with the mouse wheel and touchpad.
+         * @param enable Enable if true, disable otherwise.
+         *
+         * When enabled, wheel and touchpad input is accumulated and applied at most once per frame,
+         * wheel notches are scrolled smoothly and scrolling continues with decaying velocity after
+         * a touchpad gesture ends. Scrolling stops at the edges of the list.
+         * Disabled by default.
+         */
+        void setSmoothScrollingEnabled(bool enable);
+
+        /**
+         * @brief Check if smooth scrolling is enabled.
+         * @return True if enabled, false otherwise.
+         */
+        bool isSmoothScrollingEnabled() const noexcept;
+
         /**
          * @brief Clear the view.
          */
@@ -360,6 +436,14 @@ class FlyweightListView : public QFrame
          */
         const ItemT* item(const typename ItemT::IdType& id) const noexcept;
 
+        /**
+         * @brief Find item next to the item with given ID in the sort order.
+         * @param id ID of the item.
+         * @param direction Direction::HOME for the previous item, Direction::END for the next item.
+         * @return Found item or nullptr if the view does not contain the item or the item is at the edge.
+         */
+        const ItemT* neighbourItem(const typename ItemT::IdType& id, Direction direction) const noexcept;
+
         /**
          * @brief Get the first item in the view.
          * @return First item or nullptr if the view is empty.
@@ -607,6 +691,54 @@ class FlyweightListView : public QFrame
          */
         QWidget* itemsParentWidget() const noexcept;
 
+        /**
+         * @brief Enable or disable incremental relayout of item widgets.
+         * @param enable Flag.
+         *
+         * In incremental mode an insertion re-measures only the inserted widgets instead of all
+         * widgets of the prefetch window. See LinkedListView::setIncrementalRelayout().
+         */
+        void setIncrementalRelayout(bool enable);
+        bool isIncrementalRelayout() const noexcept;
+
+        /**
+         * @brief Set maximum number of widgets kept for reuse per widget type.
+         * @param value Maximum number of widgets, 0 disables recycling (default).
+         *
+         * With recycling enabled the widgets of items trimmed from the edges of the flyweight window
+         * are not destroyed but hidden and kept in a pool keyed by widget type, still parented
+         * to \ref itemsParentWidget(), so they need neither reparenting nor repolishing when reused.
+         * Item builders pick them up with takeRecycledWidget() or rebindRecycledWidget().
+         * Widgets of explicitly removed items are dropped as usual.
+         */
+        void setWidgetRecyclingLimit(size_t value);
+        size_t widgetRecyclingLimit() const noexcept;
+
+        /**
+         * @brief Get number of widgets currently kept in the recycle pool.
+         * @return Number of widgets of all types.
+         */
+        size_t recycledWidgetCount() const noexcept;
+
+        /**
+         * @brief Take a widget from the recycle pool.
+         * @return Hidden widget of exactly WidgetT type or nullptr if the pool has no such widgets.
+         *
+         * The widget keeps its previous contents, the caller must refill it before inserting into the view.
+         */
+        template <typename WidgetT=typename ItemT::WidgetType>
+        WidgetT* takeRecycledWidget();
+
+        /**
+         * @brief Take a widget from the recycle pool and bind it to new item data.
+         * @param item Item to bind the widget to.
+         * @return True if a recycled widget was bound, false if the pool has no widgets of WidgetT type.
+         *
+         * Requires rebindWidget() hook in item traits, see FlyweightListItem.
+         */
+        template <typename WidgetT=typename ItemT::WidgetType>
+        bool rebindRecycledWidget(ItemT& item);
+
         void resetCallbacks();
 
         void setSortOrder(Order order) noexcept;
@@ -624,6 +756,24 @@ class FlyweightListView : public QFrame
         size_t prefetchItemCountAuto() noexcept;
         size_t prefetchItemCountEffective() noexcept;
 
+        /**
+         * @brief Enable or disable adaptive prefetching.
+         * @param enable Enable if true, disable otherwise.
+         *
+         * When enabled, number of items to prefetch is evaluated separately for each edge of the list
+         * by prefetchPolicy() from scroll velocity and latency of the backend, i.e. time between
+         * RequestItemsCb and the following insertContinuousItems(). The window in the direction of scrolling
+         * is widened and the trailing window is shrunk. prefetchScreensCount() is used as the window of idle list.
+         * Disabled by default.
+         */
+        void setAdaptivePrefetchEnabled(bool enable);
+        bool isAdaptivePrefetchEnabled() const noexcept;
+
+        /**
+         * @brief Get policy of adaptive prefetching, e.g. for tuning its limits.
+         */
+        PrefetchPolicy& prefetchPolicy() noexcept;
+
         void setJumpEdgeControlEnabled(bool value);
         bool isJumpEdgeControlEnabled() const;
 
@@ -29,9 +29,12 @@ You may select, at your option, one of the above-listed licenses.
 #include <QClipboard>
 #include <QApplication>
 #include <QCursor>
+#include <QElapsedTimer>
 
 #include <uise/desktop/utils/layout.hpp>
+#include <uise/desktop/utils/chatmessagelistadjuster.hpp>
 #include <uise/desktop/utils/directchildwidget.hpp>
+#include <uise/desktop/utils/pointerholder.hpp>
 #include <uise/desktop/style.hpp>
 
 #include <uise/desktop/chatmessage.hpp>
@@ -172,7 +175,9 @@ ChatMessagesView<BaseMessageT,Traits>::ChatMessagesView(QWidget* parent)
     qApp->installEventFilter(this);
 
     m_resizeTimer=new SingleShotTimer(this);
+    m_refineSizesTimer=new SingleShotTimer(this);
     m_selectionModeTimer=new SingleShotTimer(this);
+    m_postTimer=new SingleShotTimer(this);
 
     m_layout=Layout::vertical(this);
 
@@ -250,35 +255,22 @@ ChatMessagesView<BaseMessageT,Traits>::ChatMessagesView(QWidget* parent)
                 {
                     if (selected)
                     {
-                        m_selectedMessages.emplace(item->id(),item->data());
+                        m_selectedMessages.select(item->id(),item->sortValue(),item);
                     }
                     else
                     {
-                        m_selectedMessages.erase(item->id());
+                        m_selectedMessages.deselect(item->id());
                     }
                     emit selectedCountChanged(m_selectedMessages.size());
 
-                    bool noneSelected=m_listView->eachItem(
-                        [](const auto* item)
-                        {
-                            return !item->item()->ui()->isSelected();
-                        }
-                    );
-
-                    if (noneSelected)
+                    if (m_selectedMessages.empty())
                     {
                         QTimer::singleShot(
                             300,
                             this,
                             [this]()
                             {
-                                bool noneSelected=m_listView->eachItem(
-                                    [](const auto* item)
-                                    {
-                                        return !item->item()->ui()->isSelected();
-                                    }
-                                );
-                                if (noneSelected)
+                                if (m_selectedMessages.empty())
                                 {
                                     setSelectionMode(false);
                                 }
@@ -290,6 +282,25 @@ ChatMessagesView<BaseMessageT,Traits>::ChatMessagesView(QWidget* parent)
         }
     );
 
+    m_listView->setRemoveItemCb(
+        [this](auto* widget)
+        {
+            // keep data of selected messages that leave the list
+            const auto* itemW=PointerHolder::getProperty<const ChatMessageViewItemWrapper<BaseMessageT,Traits>*>(
+                widget,ChatMessageViewItemWrapper<BaseMessageT,Traits>::Property
+            );
+            if (itemW!=nullptr)
+            {
+                m_selectedMessages.unload(itemW->id());
+            }
+
+            if (m_onItemRemoved)
+            {
+                m_onItemRemoved(widget);
+            }
+        }
+    );
+
     m_listView->setRequestItemsCb(
         [this](const auto* startItem, size_t maxCount, Direction direction)
         {
@@ -468,6 +479,112 @@ void ChatMessagesView<BaseMessageT,Traits>::onJumpRequested(Direction direction,
 
 //--------------------------------------------------------------------------
 
+template <typename BaseMessageT,typename Traits>
+class ChatMessagesView<BaseMessageT,Traits>::MessageList
+{
+    public:
+
+        using Message=typename ChatMessagesView<BaseMessageT,Traits>::Message;
+
+        explicit MessageList(ChatMessagesView* view) : m_view(view)
+        {}
+
+        Message* prev(Message* msg) const
+        {
+            return neighbour(msg,Direction::HOME);
+        }
+
+        Message* next(Message* msg) const
+        {
+            return neighbour(msg,Direction::END);
+        }
+
+        Message* last() const
+        {
+            auto item=m_view->m_listView->lastItem();
+            return item==nullptr?nullptr:item->item();
+        }
+
+        bool isBefore(Message* l, Message* r) const
+        {
+            return *l<*r;
+        }
+
+        void updateDateSeparator(Message* msg, Message* prev)
+        {
+            auto dt=msg->msg()->dateTime();
+            bool dateVisible=false;
+            bool withYear=false;
+            if (prev==nullptr)
+            {
+                auto current=QDateTime::currentDateTime().date();
+                dateVisible=dt.date()!=current;
+                withYear=dt.date().year()!=current.year();
+            }
+            else
+            {
+                auto prevDt=prev->msg()->dateTime();
+                dateVisible=prevDt.date()!=dt.date();
+                withYear=prevDt.date().year() != dt.date().year();
+            }
+            msg->setDateSeparatorVisible(dateVisible,withYear);
+        }
+
+        bool isUnread(Message* msg) const
+        {
+            return msg->isUnread();
+        }
+
+        bool isUnreadSeparatorVisible(Message* msg) const
+        {
+            return msg->isUnreadSeparatorVisible();
+        }
+
+        void setUnreadSeparatorVisible(Message* msg, bool enable)
+        {
+            if (enable)
+            {
+                msg->setUnreadSeparatorVisible(true,m_view->unreadSeparatorTitle());
+            }
+            else
+            {
+                msg->setUnreadSeparatorVisible(false);
+            }
+        }
+
+        bool isTopSeparatorVisible(Message* msg) const
+        {
+            return msg->isTopSeparatorVisible();
+        }
+
+        bool sameSender(Message* prev, Message* next) const
+        {
+            return prev->msg()->sameSender(next->msg());
+        }
+
+        void setFirstInBatch(Message* msg, bool enable)
+        {
+            msg->ui()->setFirstInBatch(enable);
+        }
+
+        void setLastInBatch(Message* msg, bool enable)
+        {
+            msg->ui()->setLastInBatch(enable);
+        }
+
+    private:
+
+        Message* neighbour(Message* msg, Direction direction) const
+        {
+            auto item=m_view->m_listView->neighbourItem(msg->id(),direction);
+            return item==nullptr?nullptr:item->item();
+        }
+
+        ChatMessagesView* m_view;
+};
+
+//--------------------------------------------------------------------------
+
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::adjustMessageList(std::vector<Message*>& messages)
 {
@@ -480,61 +597,76 @@ void ChatMessagesView<BaseMessageT,Traits>::adjustMessageList(std::vector<Messag
     );
     std::sort(messages.begin(),messages.end(),[](const auto& l, const auto& r) { return *l<*r;});
 
-    bool hasUnreadSep=false;
-    bool prevLastInBatch=true;
-    for (size_t i=0;i<messages.size();i++)
-    {
-        auto msg=messages[i];
+    MessageList list{this};
+    keepUnreadSeparator(ChatMessageListAdjuster<MessageList>::adjust(list,messages));
+}
 
-        // add date separator
-        auto dt=msg->msg()->dateTime();
-        bool dateVisible=false;
-        bool withYear=false;
-        if (i==0)
-        {
-            auto current=QDateTime::currentDateTime().date();
-            dateVisible=dt.date()!=current;
-            withYear=dt.date().year()!=current.year();
-        }
-        else
-        {
-            auto prevDt=messages[i-1]->msg()->dateTime();
-            dateVisible=prevDt.date()!=dt.date();
-            withYear=prevDt.date().year() != dt.date().year();
-        }
-        msg->setDateSeparatorVisible(dateVisible,withYear);
+//--------------------------------------------------------------------------
 
-        // update unread separator
-        if (!hasUnreadSep && msg->isUnread() && i<(messages.size()-1))
-        {
-            msg->setUnreadSeparatorVisible(true,unreadSeparatorTitle());
-            hasUnreadSep=true;
-        }
-        else if (msg->isUnreadSeparatorVisible())
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::adjustMessagesAround(const std::vector<Message*>& touched)
+{
+    Message* unreadHolder=nullptr;
+    if (m_unreadSeparatorId)
+    {
+        unreadHolder=message(m_unreadSeparatorId.value());
+        if (unreadHolder==nullptr || !unreadHolder->isUnreadSeparatorVisible() || !unreadHolder->isUnread())
         {
-            msg->setUnreadSeparatorVisible(false);
+            // message with unread separator was removed, replaced or read, only the full pass can find the next one
+            adjustCurrentMessagesList();
+            return;
         }
+    }
+
+    MessageList list{this};
+    keepUnreadSeparator(ChatMessageListAdjuster<MessageList>::adjustAround(list,touched,unreadHolder));
+}
 
-        // update last in batch for prev msg
-        if (msg->isTopSeparatorVisible() && i>0)
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::addNeighbourIds(const Id& id, std::vector<Id>& ids) const
+{
+    for (auto direction : {Direction::HOME,Direction::END})
+    {
+        auto item=m_listView->neighbourItem(id,direction);
+        if (item!=nullptr)
         {
-            prevLastInBatch=true;
-            messages[i-1]->ui()->setLastInBatch(true);
+            ids.push_back(item->id());
         }
+    }
+}
 
-        // set first in batch
-        msg->ui()->setFirstInBatch(prevLastInBatch);
+//--------------------------------------------------------------------------
 
-        // check if the next message is by same author or last in list
-        auto lastInBatch = i==messages.size()-1;
-        if (!lastInBatch)
+template <typename BaseMessageT,typename Traits>
+std::vector<typename ChatMessagesView<BaseMessageT,Traits>::Message*> ChatMessagesView<BaseMessageT,Traits>::loadedMessages(const std::vector<Id>& ids) const
+{
+    std::vector<Message*> messages;
+    messages.reserve(ids.size());
+    for (const auto& id : ids)
+    {
+        auto msg=message(id);
+        if (msg!=nullptr)
         {
-            lastInBatch=!msg->msg()->sameSender(messages[i+1]->msg());
+            messages.push_back(msg);
         }
-        msg->ui()->setLastInBatch(lastInBatch);
+    }
+    return messages;
+}
 
-        // set prevLastInBatch
-        prevLastInBatch=lastInBatch;
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::keepUnreadSeparator(Message* msg)
+{
+    if (msg==nullptr)
+    {
+        m_unreadSeparatorId.reset();
+    }
+    else
+    {
+        m_unreadSeparatorId=msg->id();
     }
 }
 
@@ -605,14 +737,14 @@ void ChatMessagesView<BaseMessageT,Traits>::insertFetched(bool forLoad, const st
         {
             m_listView->beginUpdate();
 
-            // preprocess list with merged existing and new messages
-            adjustMessageList(messages);
+            // insert items to the list, the list is laid out only in endUpdate()
+            m_listView->insertContinuousItems(messageItems,false);
 
-            // insert items to the list
+            // only the new messages and their neighbours need separators and batches re-evaluated,
+            // do it before measuring so that every message is laid out once with final separators
+            adjustMessagesAround(messages);
             adjustMessagesSizes(&messages);
 
-            m_listView->insertContinuousItems(messageItems,false);
-
             // A batch shorter than requested means the db had nothing more on that side, so the
             // newly-loaded edge item IS the boundary -- set the marker unconditionally (not
             // widen-only as before) from the list's own post-insert edge. The previous
@@ -718,7 +850,12 @@ bool ChatMessagesView<BaseMessageT,Traits>::scrollToMessage(const Id& id, int of
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::clear()
 {
+    m_postTimer->clear();
+    m_postQueue.clear();
+
     m_listView->clear();
+    m_unreadSeparatorId.reset();
+    m_staleSizeMessages.clear();
     m_dateSubtitle->hideNow();
 }
 
@@ -744,10 +881,13 @@ void ChatMessagesView<BaseMessageT,Traits>::adjustCurrentMessagesList()
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::insertMessage(const Data& dbItem)
 {
+    commitPostedMessages();
+
     m_listView->beginUpdate();
 
-    doInsertMessage(dbItem);
-    adjustCurrentMessagesList();
+    auto message=doInsertMessage(dbItem);
+    adjustMessagesAround({message});
+    adjustMesssageSize(message);
 
     m_listView->endUpdate();
 }
@@ -767,15 +907,15 @@ void ChatMessagesView<BaseMessageT,Traits>::readjustList()
 //--------------------------------------------------------------------------
 
 template <typename BaseMessageT,typename Traits>
-void ChatMessagesView<BaseMessageT,Traits>::doInsertMessage(const Data& dbItem)
+typename ChatMessagesView<BaseMessageT,Traits>::Message* ChatMessagesView<BaseMessageT,Traits>::doInsertMessage(const Data& dbItem)
 {
     auto message=makeMessage(dbItem);
-    adjustMesssageSize(message);
     if (m_listView->maxSortValue() < message->msg()->sortValue())
     {
         m_listView->setMaxSortValue(message->msg()->sortValue());
     }
     m_listView->insertItem(message);
+    return message;
 }
 
 //--------------------------------------------------------------------------
@@ -783,10 +923,14 @@ void ChatMessagesView<BaseMessageT,Traits>::doInsertMessage(const Data& dbItem)
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::removeMessage(const Id& id)
 {
+    commitPostedMessages();
+
     m_listView->beginUpdate();
 
+    std::vector<Id> touchedIds;
+    addNeighbourIds(id,touchedIds);
     doRemoveMessage(id);
-    adjustCurrentMessagesList();
+    adjustMessagesAround(loadedMessages(touchedIds));
 
     m_listView->endUpdate();
 }
@@ -796,9 +940,8 @@ void ChatMessagesView<BaseMessageT,Traits>::removeMessage(const Id& id)
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::doRemoveMessage(const Id& id)
 {
-    if (isSelectionMode())
+    if (isSelectionMode() && m_selectedMessages.deselect(id))
     {
-        m_selectedMessages.erase(id);
         emit selectedCountChanged(m_selectedMessages.size());
     }
     m_listView->removeItem(id);    
@@ -809,10 +952,15 @@ void ChatMessagesView<BaseMessageT,Traits>::doRemoveMessage(const Id& id)
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::reorderMessage(const Id& id)
 {
+    commitPostedMessages();
+
     m_listView->beginUpdate();
 
+    // message is unloaded if its new position is out of the loaded range
+    std::vector<Id> touchedIds{id};
+    addNeighbourIds(id,touchedIds);
     doReorderMessage(id);
-    adjustCurrentMessagesList();
+    adjustMessagesAround(loadedMessages(touchedIds));
 
     m_listView->endUpdate();
 }
@@ -823,6 +971,12 @@ template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::doReorderMessage(const Id& id)
 {
     m_listView->reorderItem(id);
+
+    auto msg=message(id);
+    if (msg!=nullptr)
+    {
+        m_selectedMessages.updateSortValue(id,msg->sortValue());
+    }
 }
 
 //--------------------------------------------------------------------------
@@ -830,30 +984,195 @@ void ChatMessagesView<BaseMessageT,Traits>::doReorderMessage(const Id& id)
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::updateMessage(const Data& dbItem)
 {
+    commitPostedMessages();
+
     auto msg=message(Traits::id(dbItem));
     if (msg==nullptr)
     {
         return;
     }
 
+    m_listView->beginUpdate();
+
+    // message is unloaded if a new sort value moves it out of the loaded range
+    const auto id=Traits::id(dbItem);
+    std::vector<Id> touchedIds{id};
+    addNeighbourIds(id,touchedIds);
+    doUpdateMessage(msg,dbItem);
+
+    adjustMessagesAround(loadedMessages(touchedIds));
+    msg=message(id);
+    if (msg!=nullptr)
+    {
+        adjustMesssageSize(msg);
+    }
+
+    m_listView->endUpdate();
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::doUpdateMessage(Message* msg, const Data& dbItem)
+{
     auto oldSortValue=msg->sortValue();
     auto newSortValue=Traits::sortValue(dbItem);
     auto reorder=oldSortValue != newSortValue;
 
     replaceSelectedData(msg);
 
-    m_listView->beginUpdate();
-
     msg->updateData(dbItem);
     if (reorder)
     {
         doReorderMessage(Traits::id(dbItem));
     }
-    adjustMesssageSize(msg);
+}
 
-    adjustCurrentMessagesList();
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::postMessages(const std::vector<Data>& items)
+{
+    for (const auto& item : items)
+    {
+        m_postQueue.postData(Traits::id(item),item);
+    }
+    schedulePostCommit();
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::postMessage(const Data& item)
+{
+    m_postQueue.postData(Traits::id(item),item);
+    schedulePostCommit();
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::postRemoveMessage(const Id& id)
+{
+    m_postQueue.postRemove(id);
+    schedulePostCommit();
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::postReorderMessage(const Id& id)
+{
+    m_postQueue.postReorder(id);
+    schedulePostCommit();
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::schedulePostCommit()
+{
+    if (m_postQueue.empty())
+    {
+        return;
+    }
+
+    // timer is not restarted, so a stream of posts is committed once per interval
+    m_postTimer->shot(PostCommitInterval,
+        [this]()
+        {
+            commitPostedChunk(m_maxPostCommitCount);
+            schedulePostCommit();
+        }
+    );
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::commitPostedMessages()
+{
+    m_postTimer->clear();
+    commitPostedChunk(0);
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::commitPostedChunk(size_t maxCount)
+{
+    if (m_postQueue.empty())
+    {
+        return;
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+
+    auto ops=m_postQueue.take(maxCount);
+
+    m_listView->beginUpdate();
+
+    // keep ids instead of pointers because a message touched by one operation can be removed by the next one
+    std::vector<Id> touchedIds;
+    std::vector<Id> changedIds;
+
+    for (const auto& op : ops)
+    {
+        auto msg=message(op.id);
+        if (op.remove)
+        {
+            if (msg!=nullptr)
+            {
+                addNeighbourIds(op.id,touchedIds);
+                doRemoveMessage(op.id);
+            }
+            continue;
+        }
+
+        if (op.data)
+        {
+            if (msg==nullptr)
+            {
+                msg=doInsertMessage(op.data.value());
+            }
+            else
+            {
+                addNeighbourIds(op.id,touchedIds);
+                doUpdateMessage(msg,op.data.value());
+                msg=message(op.id);
+            }
+            changedIds.push_back(op.id);
+        }
+        if (op.reorder && msg!=nullptr)
+        {
+            // sort value could be changed in place before the data was posted
+            addNeighbourIds(op.id,touchedIds);
+            doReorderMessage(op.id);
+        }
+
+        if (msg!=nullptr)
+        {
+            touchedIds.push_back(op.id);
+        }
+    }
+
+    adjustMessagesAround(loadedMessages(touchedIds));
+
+    // measure inserted and updated messages after their separators and batches are final,
+    // posted operations are merged by ID in the queue, so each message is measured once
+    for (const auto& id : changedIds)
+    {
+        auto msg=message(id);
+        if (msg!=nullptr)
+        {
+            adjustMesssageSize(msg);
+        }
+    }
 
     m_listView->endUpdate();
+
+    m_postQueue.commitDone(clock.elapsed());
 }
 
 //--------------------------------------------------------------------------
@@ -1021,10 +1340,14 @@ ChatMessagesViewItem<BaseMessageT,Traits>* ChatMessagesView<BaseMessageT,Traits>
         replaceSelectedData(message);
     }
 
+    message->ui()->setPaintedWhenIdle(m_paintedRows);
+
     // A message's size hint (and every geometry-related QSS rule feeding it -- min/max-width,
     // padding, ...) is only meaningful after QStyle::polish() has run. Every caller of
-    // makeMessage() measures the widget (adjustMessagesSizes()/adjustMesssageSize()) right after
-    // this call, so it must be fully polished BEFORE that -- not just the first message ever
+    // makeMessage() measures the widget (adjustMessagesSizes()/adjustMesssageSize()) once its
+    // separators and batch flags are evaluated -- before loading for a full load, after inserting
+    // but still before endUpdate() lays out the list for incremental insertions -- so it must
+    // be fully polished BEFORE that -- not just the first message ever
     // built, which is all the old m_messageBubbleOuterWidth==0-gated repolish below used to cover.
     // ensurePolished() recurses into every descendant built by the message builder above
     // (including the content sections, already attached at this point) and is idempotent, so
@@ -1049,15 +1372,9 @@ ChatMessagesViewItem<BaseMessageT,Traits>* ChatMessagesView<BaseMessageT,Traits>
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::replaceSelectedData(Message* msg)
 {
-    if (isSelectionMode())
+    if (isSelectionMode() && m_selectedMessages.reload(msg->id(),msg->sortValue(),msg))
     {
-        auto it=m_selectedMessages.find(msg->id());
-        if (it!=m_selectedMessages.end())
-        {
-            msg->ui()->setSelected(true);
-            m_selectedMessages.erase(it);
-            m_selectedMessages.emplace(msg->id(),msg->data());
-        }
+        msg->ui()->setSelected(true);
     }
 }
 
@@ -1070,20 +1387,31 @@ std::vector<typename Traits::Data> ChatMessagesView<BaseMessageT,Traits>::select
     if (isSelectionMode())
     {
         v.reserve(m_selectedMessages.size());
-        for (const auto& item : m_selectedMessages)
-        {
-            v.emplace_back(item.second);
-        }
-        std::sort(v.begin(),v.end(),[](const auto& l, const auto& r)
-        {
-            return Traits::sortValue(l) < Traits::sortValue(r);
-        });
+        m_selectedMessages.each(
+            [&v](const Data& data)
+            {
+                v.emplace_back(data);
+                return true;
+            }
+        );
     }
     return v;
 }
 
 //--------------------------------------------------------------------------
 
+template <typename BaseMessageT,typename Traits>
+bool ChatMessagesView<BaseMessageT,Traits>::eachSelectedMessage(DataHandler handler) const
+{
+    if (!isSelectionMode())
+    {
+        return true;
+    }
+    return m_selectedMessages.each(handler);
+}
+
+//--------------------------------------------------------------------------
+
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::resizeEvent(QResizeEvent* event)
 {
@@ -1109,12 +1437,50 @@ void ChatMessagesView<BaseMessageT,Traits>::adjustMessagesSizes(std::vector<Mess
     if (messages==nullptr)
     {
         auto maxWidth=messageContentWidth();
-        auto handler=[maxWidth](const auto* item)
+        if (!m_bubbleLayoutCache)
+        {
+            auto handler=[maxWidth](const auto* item)
+            {
+                item->widget()->content()->updateBubbleWidth(maxWidth);
+                return true;
+            };
+            m_listView->eachItem(handler);
+            return;
+        }
+
+        // lay out messages in the viewport for the exact width,
+        // replay cached widths for the rest and refine them later
+        const auto* firstVisible=m_listView->firstViewportItem();
+        const auto* lastVisible=m_listView->lastViewportItem();
+        auto isVisible=[firstVisible,lastVisible](Message* msg)
         {
-            item->widget()->content()->updateBubbleWidth(maxWidth);
+            if (firstVisible==nullptr || lastVisible==nullptr)
+            {
+                return true;
+            }
+            return !(*msg<*firstVisible->item()) && !(*lastVisible->item()<*msg);
+        };
+
+        m_staleSizeMessages.clear();
+        auto handler=[this,maxWidth,&isVisible](const auto* item)
+        {
+            auto content=item->widget()->content();
+            if (isVisible(item->item()) || !content->replayBubbleWidth(maxWidth))
+            {
+                content->updateBubbleWidth(maxWidth);
+            }
+            else
+            {
+                m_staleSizeMessages.push_back(item->id());
+            }
             return true;
         };
         m_listView->eachItem(handler);
+
+        if (!m_staleSizeMessages.empty())
+        {
+            m_refineSizesTimer->shot(RefineSizesInterval,[this](){refineMessagesSizes();});
+        }
     }
     else
     {
@@ -1133,11 +1499,61 @@ void ChatMessagesView<BaseMessageT,Traits>::adjustMessagesSizes(std::vector<Mess
 template <typename BaseMessageT,typename Traits>
 void ChatMessagesView<BaseMessageT,Traits>::adjustMesssageSize(Message* msg)
 {
+    // contents of the message might have changed, widths cached for other widths are obsolete
+    msg->ui()->content()->invalidateBubbleWidthCache();
     msg->ui()->content()->updateBubbleWidth(messageContentWidth());
 }
 
 //--------------------------------------------------------------------------
 
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::setPaintedRowsEnabled(bool enable)
+{
+    if (m_paintedRows==enable)
+    {
+        return;
+    }
+    m_paintedRows=enable;
+
+    m_listView->eachItem(
+        [enable](const auto* item)
+        {
+            item->item()->ui()->setPaintedWhenIdle(enable);
+            return true;
+        }
+    );
+}
+
+//--------------------------------------------------------------------------
+
+template <typename BaseMessageT,typename Traits>
+void ChatMessagesView<BaseMessageT,Traits>::refineMessagesSizes()
+{
+    m_listView->beginUpdate();
+
+    auto maxWidth=messageContentWidth();
+    size_t count=0;
+    while (!m_staleSizeMessages.empty() && count<RefineSizesChunk)
+    {
+        auto msg=message(m_staleSizeMessages.back());
+        m_staleSizeMessages.pop_back();
+        if (msg!=nullptr && msg->ui()->content()->isBubbleWidthStale())
+        {
+            msg->ui()->content()->updateBubbleWidth(maxWidth);
+            count++;
+        }
+    }
+
+    m_listView->endUpdate();
+
+    if (!m_staleSizeMessages.empty())
+    {
+        m_refineSizesTimer->shot(RefineSizesInterval,[this](){refineMessagesSizes();});
+    }
+}
+
+//--------------------------------------------------------------------------
+
 template <typename BaseMessageT,typename Traits>
 int ChatMessagesView<BaseMessageT,Traits>::messageContentWidth() const
 {
@@ -178,6 +178,41 @@ void FlyweightListView<ItemT,OrderComparer,IdComparer>::setRequestEndCb(RequestJ
     pimpl->m_endRequestCb=std::move(cb);
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setRequestJumpToIndexCb(RequestJumpToIndexCb cb) noexcept
+{
+    pimpl->m_jumpToIndexRequestCb=std::move(cb);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setItemIndexCb(ItemIndexCb cb) noexcept
+{
+    pimpl->m_itemIndexCb=std::move(cb);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setEstimatedItemCount(size_t count)
+{
+    pimpl->setEstimatedItemCount(count);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+size_t FlyweightListView<ItemT,OrderComparer,IdComparer>::estimatedItemCount() const noexcept
+{
+    return pimpl->m_scrollEstimator.totalCount();
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+double FlyweightListView<ItemT,OrderComparer,IdComparer>::estimatedItemExtent() const noexcept
+{
+    return pimpl->m_scrollEstimator.averageItemExtent();
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::setInsertItemCb(InsertItemCb cb) noexcept
@@ -243,10 +278,7 @@ void FlyweightListView<ItemT,OrderComparer,IdComparer>::insertItems(const std::v
         beginUpdate();
     }
 
-    for (auto&& item:items)
-    {
-        pimpl->insertItem(item,false);
-    }
+    pimpl->insertItemsBatch(items);
 
     if (autoUpdate)
     {
@@ -346,6 +378,13 @@ const ItemT* FlyweightListView<ItemT,OrderComparer,IdComparer>::lastItem() const
     return pimpl->lastItem();
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+const ItemT* FlyweightListView<ItemT,OrderComparer,IdComparer>::neighbourItem(const typename ItemT::IdType& id, Direction direction) const noexcept
+{
+    return pimpl->neighbourItem(id,direction);
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::jumpToEdge(Direction direction, bool forceLongJump, Qt::KeyboardModifiers modifiers)
@@ -388,6 +427,24 @@ bool FlyweightListView<ItemT,OrderComparer,IdComparer>::isWheelHorizontaScrollEn
     return pimpl->m_scrollWheelHorizontal;
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setSmoothScrollingEnabled(bool enable)
+{
+    pimpl->m_smoothScrolling=enable;
+    if (!enable)
+    {
+        pimpl->stopScrollFrames();
+    }
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+bool FlyweightListView<ItemT,OrderComparer,IdComparer>::isSmoothScrollingEnabled() const noexcept
+{
+    return pimpl->m_smoothScrolling;
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::resizeEvent(QResizeEvent *event)
@@ -527,6 +584,9 @@ template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::setMaxSortValue(const typename ItemT::SortValueType &value) noexcept
 {
     pimpl->m_maxSortValue=value;
+
+    // backend marks the end of items instead of responding with items
+    pimpl->m_prefetchPolicy.requestCancelled(Direction::END);
 }
 
 //--------------------------------------------------------------------------
@@ -541,6 +601,9 @@ template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::setMinSortValue(const typename ItemT::SortValueType &value) noexcept
 {
     pimpl->m_minSortValue=value;
+
+    // backend marks the beginning of items instead of responding with items
+    pimpl->m_prefetchPolicy.requestCancelled(Direction::HOME);
 }
 
 //--------------------------------------------------------------------------
@@ -615,6 +678,66 @@ QWidget* FlyweightListView<ItemT,OrderComparer,IdComparer>::itemsParentWidget()
     return pimpl->m_llist;
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setIncrementalRelayout(bool enable)
+{
+    pimpl->m_llist->setIncrementalRelayout(enable);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+bool FlyweightListView<ItemT,OrderComparer,IdComparer>::isIncrementalRelayout() const noexcept
+{
+    return pimpl->m_llist->isIncrementalRelayout();
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setWidgetRecyclingLimit(size_t value)
+{
+    pimpl->setWidgetRecyclingLimit(value);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+size_t FlyweightListView<ItemT,OrderComparer,IdComparer>::widgetRecyclingLimit() const noexcept
+{
+    return pimpl->m_widgetRecyclingLimit;
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+size_t FlyweightListView<ItemT,OrderComparer,IdComparer>::recycledWidgetCount() const noexcept
+{
+    return pimpl->recycledWidgetCount();
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+template <typename WidgetT>
+WidgetT* FlyweightListView<ItemT,OrderComparer,IdComparer>::takeRecycledWidget()
+{
+    static_assert(std::is_base_of<QWidget,WidgetT>::value,"WidgetT must be a widget type");
+    return static_cast<WidgetT*>(pimpl->takeRecycledWidget(std::type_index(typeid(WidgetT))));
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+template <typename WidgetT>
+bool FlyweightListView<ItemT,OrderComparer,IdComparer>::rebindRecycledWidget(ItemT& item)
+{
+    static_assert(std::is_base_of<typename ItemT::WidgetType,WidgetT>::value,"WidgetT must be derived from item's widget type");
+
+    auto widget=takeRecycledWidget<WidgetT>();
+    if (widget==nullptr)
+    {
+        return false;
+    }
+    item.rebindWidget(widget);
+    return true;
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::setPrefetchScreensCount(double value)
@@ -679,6 +802,27 @@ size_t FlyweightListView<ItemT,OrderComparer,IdComparer>::prefetchItemCountEffec
     return pimpl->prefetchItemCountEffective();
 }
 
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+void FlyweightListView<ItemT,OrderComparer,IdComparer>::setAdaptivePrefetchEnabled(bool enable)
+{
+    pimpl->setAdaptivePrefetchEnabled(enable);
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+bool FlyweightListView<ItemT,OrderComparer,IdComparer>::isAdaptivePrefetchEnabled() const noexcept
+{
+    return pimpl->isAdaptivePrefetchEnabled();
+}
+
+//--------------------------------------------------------------------------
+template <typename ItemT, typename OrderComparer, typename IdComparer>
+PrefetchPolicy& FlyweightListView<ItemT,OrderComparer,IdComparer>::prefetchPolicy() noexcept
+{
+    return pimpl->m_prefetchPolicy;
+}
+
 //--------------------------------------------------------------------------
 template <typename ItemT, typename OrderComparer, typename IdComparer>
 void FlyweightListView<ItemT,OrderComparer,IdComparer>::setJumpEdgeControlEnabled(bool value)
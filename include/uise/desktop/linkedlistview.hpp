@@ -75,6 +75,17 @@ class UISE_DESKTOP_EXPORT LinkedListView : public QFrame
         size_t widgetSeqPos(QObject* widget) const;
         QWidget* widgetAtSeqPos(size_t pos) const;
 
+        /**
+         * @brief Get direct child widget at a position.
+         * @param pos Position in coordinates of this view.
+         * @return Found widget or nullptr if there is no widget at this position.
+         *
+         * Widget is looked up with binary search over the extents of widgets recorded by the last relayout,
+         * so hit testing costs O(log n) instead of probing every child. Falls back to QWidget::childAt()
+         * if the list was changed since then, or in the legacy QBoxLayout-based implementation.
+         */
+        QWidget* widgetAtPos(const QPoint& pos) const;
+
         /**
          * @brief Check if a widget is currently a live member of this list.
          * @param widget Widget to check.
@@ -96,6 +107,32 @@ class UISE_DESKTOP_EXPORT LinkedListView : public QFrame
         void setAlignment(Qt::Alignment alignment) noexcept;
         Qt::Alignment alignment() const noexcept;
 
+        /**
+         * @brief Enable or disable incremental relayout.
+         * @param enable Flag.
+         *
+         * By default every relayout re-queries sizeHint()/minimumSizeHint() of every widget in the
+         * list. In incremental mode the view caches per-widget extents and re-measures only the
+         * widgets that were inserted or reported a change, the rest of the widgets are just shifted.
+         * A change is detected when a widget is shown again, changes font/style or gets its own
+         * QEvent::LayoutRequest, i.e. when a widget managed by a layout changes its contents.
+         * A widget without a layout that changes its size hint directly must be reported with
+         * invalidateWidget(). The aggregate size hint of the list is cached too. Widgets are watched
+         * with an event filter only in incremental mode.
+         *
+         * Ignored in the legacy QBoxLayout-based implementation.
+         */
+        void setIncrementalRelayout(bool enable);
+        bool isIncrementalRelayout() const noexcept;
+
+        /**
+         * @brief Mark cached extents of a widget as outdated and schedule relayout.
+         * @param widget Widget whose size hint changed, if null then all widgets are re-measured.
+         *
+         * Needed only in incremental relayout mode.
+         */
+        void invalidateWidget(QWidget* widget=nullptr);
+
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
         QSize sizeHint() const override;
         QSize minimumSizeHint() const override;
@@ -110,6 +147,7 @@ class UISE_DESKTOP_EXPORT LinkedListView : public QFrame
         void resizeEvent(QResizeEvent* event) override;
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
         bool event(QEvent* event) override;
+        bool eventFilter(QObject* watched, QEvent* event) override;
 #endif
 
     private slots:
@@ -17,7 +17,7 @@ You may select, at your option, one of the above-listed licenses.
 
 /** @file uise/desktop/linkedlistviewitem.hpp
 *
-*  Defines LinkedListViewItem.
+*  Defines LinkedListViewItem and LinkedListViewItemPool.
 *
 */
 
@@ -26,131 +26,213 @@ You may select, at your option, one of the above-listed licenses.
 #ifndef UISE_DESKTOP_LINKEDLISTVIEWITEM_HPP
 #define UISE_DESKTOP_LINKEDLISTVIEWITEM_HPP
 
-#include <memory>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 #include <QPointer>
 #include <QWidget>
 
 #include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/utils/orderstatistictree.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
 
-class UISE_DESKTOP_EXPORT LinkedListViewItem : public std::enable_shared_from_this<LinkedListViewItem>
+/**
+ * @brief Node of LinkedListView.
+ *
+ * Nodes live in LinkedListViewItemPool owned by the view and are linked by plain indexes into
+ * the pool, so that traversing the list neither touches reference counters nor chases nodes
+ * scattered over the heap. Index of the node is also kept in a dynamic property of the widget.
+ */
+class UISE_DESKTOP_EXPORT LinkedListViewItem
 {
     public:
 
         constexpr static const char* Property="uise_dt_LinkedListViewItem";
 
-        LinkedListViewItem(QWidget* widget) : m_widget(widget), m_pos(0)
+        using Index=uint32_t;
+        constexpr static const Index Null=std::numeric_limits<Index>::max();
+
+        using PosIndex=OrderStatisticTree<QWidget*>;
+
+        /**
+         * @brief Layout metrics of the widget as measured by the owning view.
+         *
+         * Used only in incremental relayout mode of LinkedListView, where the view re-measures
+         * a widget only after its extents were invalidated.
+         */
+        struct Extents
+        {
+            QSize sizeHint;
+            QSize minSize;
+            int maxCross=0;
+            bool valid=false;
+        };
+
+        LinkedListViewItem(QWidget* widget=nullptr) : m_widget(widget), m_next(Null), m_prev(Null), m_posHandle(PosIndex::Null)
         {
         }
 
-        void keepInWidgetProperty();
-        static std::shared_ptr<LinkedListViewItem> getFromWidgetProperty(QObject* widget);
+        static void keepInWidgetProperty(QObject* widget, Index index);
+        static Index getFromWidgetProperty(QObject* widget);
         static void clearWidgetProperty(QObject* widget);
 
-        auto next() const noexcept
+        Index next() const noexcept
         {
-            return m_next.lock();
+            return m_next;
         }
 
-        void setNext(std::shared_ptr<LinkedListViewItem> item) noexcept
+        void setNext(Index item) noexcept
         {
-            m_next=std::move(item);
+            m_next=item;
         }
 
-        auto prev() const noexcept
+        Index prev() const noexcept
         {
-            return m_prev.lock();
+            return m_prev;
         }
 
-        void setPrev(std::shared_ptr<LinkedListViewItem> item) noexcept
+        void setPrev(Index item) noexcept
         {
-            m_prev=std::move(item);
+            m_prev=item;
         }
 
-        void setNextAuto(std::shared_ptr<LinkedListViewItem> item) noexcept
+        QWidget* widget() const noexcept
         {
-            auto next=m_next.lock();
-            if (next)
-            {
-                next->setPrev(std::shared_ptr<LinkedListViewItem>());
-            }
-            m_next=std::move(item);
-            next=m_next.lock();
-            if (next)
-            {
-                next->setPrev(shared_from_this());
-            }
+            return m_widget;
+        }
+
+        /**
+         * @brief Get handle of this item in the owning view's position index.
+         *
+         * Position itself is not stored in the item, it is evaluated by the index on demand,
+         * so that inserting or removing an item does not renumber every item that follows it.
+         */
+        PosIndex::Handle posHandle() const noexcept
+        {
+            return m_posHandle;
+        }
+
+        void setPosHandle(PosIndex::Handle handle) noexcept
+        {
+            m_posHandle=handle;
+        }
+
+        //! Cached extents are mutable, they are refreshed lazily when the view is queried for its size hint.
+        Extents& extents() const noexcept
+        {
+            return m_extents;
+        }
+
+        void invalidateExtents() noexcept
+        {
+            m_extents.valid=false;
+        }
+
+        void reset(QWidget* widget=nullptr)
+        {
+            m_widget=widget;
+            m_next=Null;
+            m_prev=Null;
+            m_posHandle=PosIndex::Null;
+            m_extents=Extents{};
         }
 
-        void setPrevAuto(std::shared_ptr<LinkedListViewItem> item) noexcept
+    private:
+
+        QPointer<QWidget> m_widget;
+        Index m_next;
+        Index m_prev;
+        PosIndex::Handle m_posHandle;
+        mutable Extents m_extents;
+};
+
+/**
+ * @brief Arena of LinkedListViewItem nodes.
+ *
+ * Released nodes are recycled, an index stays valid until its own node is released.
+ * References to nodes are invalidated by allocate(), so hold indexes instead.
+ */
+class LinkedListViewItemPool
+{
+    public:
+
+        using Index=LinkedListViewItem::Index;
+        constexpr static const Index Null=LinkedListViewItem::Null;
+
+        Index allocate(QWidget* widget)
         {
-            auto prev=m_prev.lock();
-            if (prev)
+            Index index;
+            if (!m_free.empty())
             {
-                prev->setNext(std::shared_ptr<LinkedListViewItem>());
+                index=m_free.back();
+                m_free.pop_back();
+                m_nodes[index].reset(widget);
             }
-            m_prev=std::move(item);
-            prev=m_prev.lock();
-            if (prev)
+            else
             {
-                prev->setNext(shared_from_this());
+                index=static_cast<Index>(m_nodes.size());
+                m_nodes.emplace_back(widget);
             }
+            return index;
         }
 
-        QWidget* widget() noexcept
+        void release(Index index)
         {
-            return m_widget;
+            m_nodes[index].reset();
+            m_free.push_back(index);
         }
 
-        QWidget* widget() const noexcept
+        void clear() noexcept
         {
-            return m_widget;
+            m_nodes.clear();
+            m_free.clear();
         }
 
-        size_t pos() const noexcept
+        bool isIndexInRange(Index index) const noexcept
         {
-            return m_pos;
+            return index<m_nodes.size();
         }
 
-        void setPos(size_t pos) noexcept
+        LinkedListViewItem& operator[](Index index) noexcept
         {
-            m_pos=pos;
+            return m_nodes[index];
         }
 
-        void incPos() noexcept
+        const LinkedListViewItem& operator[](Index index) const noexcept
         {
-            ++m_pos;
+            return m_nodes[index];
         }
 
-        void decPos() noexcept
+        //! Link two nodes as neighbours, either can be Null.
+        void link(Index prev, Index next) noexcept
         {
-            if (m_pos!=0)
+            if (prev!=Null)
             {
-                --m_pos;
+                m_nodes[prev].setNext(next);
+            }
+            if (next!=Null)
+            {
+                m_nodes[next].setPrev(prev);
             }
         }
 
-        void reset()
+        //! Exclude node from the chain linking its neighbours with each other.
+        void unlink(Index index) noexcept
         {
-            m_pos=0;
-            m_next.reset();
-            m_prev.reset();;
+            auto& node=m_nodes[index];
+            link(node.prev(),node.next());
+            node.setPrev(Null);
+            node.setNext(Null);
         }
 
     private:
 
-        QPointer<QWidget> m_widget;
-        std::weak_ptr<LinkedListViewItem> m_next;
-        std::weak_ptr<LinkedListViewItem> m_prev;
-        size_t m_pos;
+        std::vector<LinkedListViewItem> m_nodes;
+        std::vector<Index> m_free;
 };
 
-using LinkedListViewItemSharedPtr=std::shared_ptr<LinkedListViewItem>;
-
 UISE_DESKTOP_NAMESPACE_END
 
-Q_DECLARE_METATYPE(UISE_DESKTOP_NAMESPACE::LinkedListViewItemSharedPtr)
-
 #endif // UISE_DESKTOP_LINKEDLISTVIEWITEM_HPP
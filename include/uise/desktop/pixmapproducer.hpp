@@ -42,6 +42,8 @@ You may select, at your option, one of the above-listed licenses.
 #include <uise/desktop/imageanimator.hpp>
 #include <uise/desktop/utils/singleshottimer.hpp>
 #include <uise/desktop/utils/withpathandsize.hpp>
+#include <uise/desktop/utils/bytebudgetlru.hpp>
+#include <uise/desktop/utils/iconmodetable.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
 
@@ -221,6 +223,12 @@ class UISE_DESKTOP_EXPORT PixmapProducer : public QObject,
             return m_animation;
         }
 
+        //! Size in bytes of pixmaps held by the producer, the default pixmap is shared and not accounted.
+        size_t pixmapBytes() const noexcept;
+
+        //! Check if a consumer of the producer belongs to a widget that is at least partially visible on the screen.
+        bool hasVisibleConsumer() const;
+
     signals:
 
         void pixmapUpdated();
@@ -274,8 +282,12 @@ class UISE_DESKTOP_EXPORT PixmapProducer : public QObject,
 
         QPixmap m_defaultPixmap;
 
-        std::map<IconMode,QPixmap> m_onPixmaps;
-        std::map<IconMode,QPixmap> m_offPixmaps;
+        static int stateIndex(QIcon::State state) noexcept
+        {
+            return state==QIcon::State::On ? 1 : 0;
+        }
+
+        IconModeTable<QPixmap> m_pixmaps;
 
         std::shared_ptr<SvgIcon> m_svgIcon;
 
@@ -435,6 +447,42 @@ class UISE_DESKTOP_EXPORT PixmapSource : public std::enable_shared_from_this<Pix
 
         std::vector<std::shared_ptr<PixmapProducer>> producers(const WithPath& path) const;
 
+        //! Get producer registered for the key or nullptr.
+        std::shared_ptr<PixmapProducer> producer(const PixmapKey& key) const;
+
+        /**
+         * @brief Set memory budget of pixmaps held by producers.
+         * @param bytes Budget in bytes, 0 disables the budget.
+         *
+         * With the budget producers released by all consumers are not destroyed after the destroying delay.
+         * Instead they are kept as long as total size of pixmaps of all producers fits the budget, and
+         * the least recently used released producers are destroyed when the budget is exceeded.
+         * Producers in use are accounted but never destroyed. Disabled by default.
+         */
+        void setCacheBudget(size_t bytes);
+
+        size_t cacheBudget() const noexcept
+        {
+            return m_cache.budget();
+        }
+
+        //! Total size in bytes of pixmaps held by producers.
+        size_t cachedBytes() const noexcept
+        {
+            return m_cache.totalBytes();
+        }
+
+        //! Hits and misses of acquireProducer() and evictions of released producers.
+        const ByteBudgetLruStats& cacheStats() const noexcept
+        {
+            return m_cache.stats();
+        }
+
+        void resetCacheStats() noexcept
+        {
+            m_cache.resetStats();
+        }
+
     protected:
 
         virtual void doLoadProducer(const PixmapKey& key)
@@ -449,8 +497,24 @@ class UISE_DESKTOP_EXPORT PixmapSource : public std::enable_shared_from_this<Pix
 
         virtual void doLoadPixmap(const PixmapKey& key) =0;
 
+        //! Invoked when the last consumer releases a producer. The producer is kept until the destroying delay expires,
+        //! so pending work for the key can be cancelled here before doUnloadProducer().
+        virtual void doReleaseProducer(const PixmapKey& key)
+        {
+            std::ignore=key;
+        }
+
+        //! Invoked when a released producer is acquired again before it was destroyed.
+        virtual void doReacquireProducer(const PixmapKey& key)
+        {
+            std::ignore=key;
+        }
+
         void removeProducer(PixmapKey key, PixmapProducer* producer);
 
+        void trimCache();
+        void updateCachedBytes(PixmapProducer* producer);
+
         QPixmap m_defaultPixmap;
 
         using PixmapKeyIdxFn=boost::multi_index::const_mem_fun<
@@ -497,6 +561,9 @@ class UISE_DESKTOP_EXPORT PixmapSource : public std::enable_shared_from_this<Pix
         size_t m_producerDestroyingDelayMs;
 
         Qt::AspectRatioMode m_aspectRatioMode;
+
+        ByteBudgetLru<PixmapKey> m_cache;
+        bool m_cacheTrimScheduled=false;
 };
 
 UISE_DESKTOP_NAMESPACE_END
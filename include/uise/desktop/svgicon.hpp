@@ -26,15 +26,22 @@ You may select, at your option, one of the above-listed licenses.
 #ifndef UISE_DESKTOP_SVG_ICON_HPP
 #define UISE_DESKTOP_SVG_ICON_HPP
 
+#include <algorithm>
 #include <memory>
 #include <map>
 #include <set>
+#include <vector>
 
 #include <QDebug>
 #include <QIcon>
 #include <QIconEngine>
+#include <QImage>
 
 #include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/utils/iconmodetable.hpp>
+#include <uise/desktop/svgiconatlas.hpp>
+
+class QThreadPool;
 
 UISE_DESKTOP_NAMESPACE_BEGIN
 
@@ -51,6 +58,9 @@ enum class IconMode : int
     User=0x100
 };
 
+static_assert(static_cast<int>(IconMode::CheckedHovered)+1==IconModeTable<int>::FixedModeCount,
+              "Predefined icon modes must fit fixed slots of IconModeTable");
+
 inline std::map<QString,IconMode> defaultModeMap()
 {
     std::map<QString,IconMode> m{
@@ -99,7 +109,7 @@ class IconPixmapSet
         {
             if (fallback(state)->isNull() && !pixmaps(state)->empty())
             {
-                return pixmaps(state)->begin()->second;
+                return pixmaps(state)->front().second;
             }
             return *fallback(state);
         }
@@ -113,7 +123,19 @@ class IconPixmapSet
         {
             // qDebug() << "IconPixmapSet::addPixmap state=" << state << " size="<<px.size() << " "<<this;
 
-            pixmaps(state)->emplace(px.size(),std::move(px));
+            // sizes are kept sorted, an existing size is not replaced
+            auto* sizes=pixmaps(state);
+            auto size=px.size();
+            auto it=std::lower_bound(sizes->begin(),sizes->end(),size,
+                [](const std::pair<QSize,QPixmap>& entry, const QSize& value)
+                {
+                    return compareQSize{}(entry.first,value);
+                }
+            );
+            if (it==sizes->end() || it->first!=size)
+            {
+                sizes->emplace(it,size,std::move(px));
+            }
         }
 
         QPixmap pixmap(const QSize& size, QIcon::State state=QIcon::On) const
@@ -126,11 +148,14 @@ class IconPixmapSet
                 return pixmap(state);
             }
 
-            auto it=pixmaps(state)->find(size);
-            if (it!=pixmaps(state)->end())
+            // an icon is cached in a couple of sizes, linear search is faster than a tree walk
+            for (const auto& entry : *pixmaps(state))
             {
-                // qDebug()<<"IconPixmapSet::pixmap found";
-                return it->second;
+                if (entry.first==size)
+                {
+                    // qDebug()<<"IconPixmapSet::pixmap found";
+                    return entry.second;
+                }
             }
             // qDebug()<<"IconPixmapSet::pixmap not found "<< this;
             return pixmap(state);
@@ -175,7 +200,9 @@ class IconPixmapSet
             return &m_fallback;
         }
 
-        const std::map<QSize,QPixmap,compareQSize>* pixmaps(QIcon::State state) const
+        using Pixmaps=std::vector<std::pair<QSize,QPixmap>>;
+
+        const Pixmaps* pixmaps(QIcon::State state) const
         {
             if (state==QIcon::Off)
             {
@@ -193,7 +220,7 @@ class IconPixmapSet
             return &m_fallback;
         }
 
-        std::map<QSize,QPixmap,compareQSize>* pixmaps(QIcon::State state)
+        Pixmaps* pixmaps(QIcon::State state)
         {
             if (state==QIcon::Off)
             {
@@ -202,10 +229,10 @@ class IconPixmapSet
             return &m_offPixmaps;
         }
 
-        std::map<QSize,QPixmap,compareQSize> m_pixmaps;
+        Pixmaps m_pixmaps;
         QPixmap m_fallback;
 
-        std::map<QSize,QPixmap,compareQSize> m_offPixmaps;
+        Pixmaps m_offPixmaps;
         QPixmap m_fallbackOff;
 };
 
@@ -311,6 +338,12 @@ class UISE_DESKTOP_EXPORT SvgIcon : public std::enable_shared_from_this<SvgIcon>
         };
 
         SvgIcon() =default;
+        ~SvgIcon();
+
+        SvgIcon(const SvgIcon&)=delete;
+        SvgIcon(SvgIcon&&)=delete;
+        SvgIcon& operator=(const SvgIcon&)=delete;
+        SvgIcon& operator=(SvgIcon&&)=delete;
 
         void paint(QPainter *painter, const QRect &rect, IconVariant mode,  QIcon::State state=QIcon::Off, bool cache=true);
         void paint(QPainter *painter, const QRect &rect)
@@ -377,7 +410,9 @@ class UISE_DESKTOP_EXPORT SvgIcon : public std::enable_shared_from_this<SvgIcon>
 
         void reset()
         {
+            cancelWarmUp();
             m_pixmapSets.clear();
+            releaseAtlasSlots();
             m_initialContent.clear();
             m_onContent.clear();
             m_offContent.clear();
@@ -416,7 +451,9 @@ class UISE_DESKTOP_EXPORT SvgIcon : public std::enable_shared_from_this<SvgIcon>
             m_initialContent=other->m_initialContent;
             m_onContent=other->m_onContent;
             m_offContent=other->m_offContent;
+            cancelWarmUp();
             m_pixmapSets.clear();
+            releaseAtlasSlots();
 
             for (auto&& it : m_refs)
             {
@@ -438,8 +475,75 @@ class UISE_DESKTOP_EXPORT SvgIcon : public std::enable_shared_from_this<SvgIcon>
 
         QPixmap makePixmap(const QSize &size, IconVariant mode=IconMode::Normal,  QIcon::State state=QIcon::On, bool cache=true, const QColor& background=Qt::transparent, QRect rect={});
 
+        /**
+         * @brief Set atlas for rasterised variants of the icon.
+         *
+         * With atlas cached painting draws the icon from the atlas and sizes warmed on loading are rendered
+         * to the atlas instead of separate pixmaps. Slots of the icon are released when the icon is destroyed,
+         * reloaded or moved to another atlas.
+         *
+         * @param atlas Atlas, nullptr to disable (default).
+         */
+        void setAtlas(std::shared_ptr<SvgIconAtlas> atlas)
+        {
+            releaseAtlasSlots();
+            m_atlas=std::move(atlas);
+        }
+
+        std::shared_ptr<SvgIconAtlas> atlas() const
+        {
+            return m_atlas;
+        }
+
+        /**
+         * @brief Set thread pool for rendering of sizes warmed on loading.
+         *
+         * With pool loadFromData() renders the sizes to images in worker threads and puts them to the cache
+         * in GUI thread, until then cached painting renders the icon directly from SVG content.
+         * Without pool, or if the icon is not owned by std::shared_ptr, the sizes are rendered synchronously.
+         *
+         * @param pool Thread pool, nullptr to disable.
+         */
+        void setWarmUpPool(std::shared_ptr<QThreadPool> pool)
+        {
+            m_warmUpPool=std::move(pool);
+        }
+
+        std::shared_ptr<QThreadPool> warmUpPool() const
+        {
+            return m_warmUpPool;
+        }
+
+        //! Check if sizes warmed on loading are still being rendered in background.
+        bool isWarmingUp() const noexcept
+        {
+            return m_warmUpCount!=0;
+        }
+
     private:
 
+        struct WarmUpItem
+        {
+            IconVariant mode;
+            QIcon::State state;
+            QSize size;
+            QByteArray content;
+            QImage image;
+        };
+
+        const SvgIconAtlas::Slot* atlasSlot(const QSize& size, IconVariant mode, QIcon::State state,
+                                            const SvgIconAtlas::RenderFn& render={});
+        void releaseAtlasSlots();
+
+        void warmUp(std::vector<WarmUpItem> items);
+        void onWarmUpReady(quint64 generation, const std::vector<WarmUpItem>& items);
+
+        void cancelWarmUp() noexcept
+        {
+            m_warmUpGeneration++;
+            m_warmUpCount=0;
+        }
+
         QString m_name;
         QString m_context;
 
@@ -447,24 +551,14 @@ class UISE_DESKTOP_EXPORT SvgIcon : public std::enable_shared_from_this<SvgIcon>
         const IconPixmapSet* pixmapSet(T mode) const
         {
             IconVariant st(mode);
-            auto it=m_pixmapSets.find(st);
-            if (it!=m_pixmapSets.end())
-            {
-                return &it->second;
-            }
-            return nullptr;
+            return m_pixmapSets.find(st);
         }
 
         template <typename T>
         IconPixmapSet* pixmapSet(T mode)
         {
             IconVariant st(mode);
-            auto it=m_pixmapSets.find(st);
-            if (it!=m_pixmapSets.end())
-            {
-                return &it->second;
-            }
-            return nullptr;
+            return m_pixmapSets.find(st);
         }
 
         QByteArray offContent(IconVariant mode) const
@@ -523,7 +617,14 @@ class UISE_DESKTOP_EXPORT SvgIcon : public std::enable_shared_from_this<SvgIcon>
         std::map<IconVariant,QByteArray> m_onContent;
         std::map<IconVariant,QByteArray> m_offContent;
 
-        std::map<IconVariant,IconPixmapSet> m_pixmapSets;
+        IconModeTable<IconPixmapSet,1> m_pixmapSets;
+
+        std::shared_ptr<SvgIconAtlas> m_atlas;
+        IconModeTable<std::vector<std::pair<QSize,SvgIconAtlas::Slot>>> m_atlasSlots;
+
+        std::shared_ptr<QThreadPool> m_warmUpPool;
+        int m_warmUpCount=0;
+        quint64 m_warmUpGeneration=0;
 
         std::vector<std::weak_ptr<SvgIcon>> m_refs;
 };
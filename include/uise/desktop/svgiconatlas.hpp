@@ -0,0 +1,150 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/svgiconatlas.hpp
+*
+*  Declares SvgIconAtlas class.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_SVG_ICON_ATLAS_HPP
+#define UISE_DESKTOP_SVG_ICON_ATLAS_HPP
+
+#include <functional>
+#include <vector>
+
+#include <QPixmap>
+#include <QRect>
+
+#include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/utils/shelfpacker.hpp>
+
+class QPainter;
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Atlas of rasterised icons packed into a few shared pages.
+ *
+ * Each icon variant is rendered once into a rectangle of a large page pixmap and is drawn later as
+ * a sub-rectangle of the page. All icons of a theme share the pages, so painting many icons needs neither
+ * an allocation of a pixmap per icon nor a switch of the source pixmap between draws.
+ *
+ * Icons release their slots when they are dropped or reloaded. A page whose slots are all released
+ * is freed and reused for new icons. When the theme changes the atlas must be cleared,
+ * slots handed out before clear() become invalid, see isValid().
+ *
+ * The atlas must be used only in GUI thread.
+ */
+class UISE_DESKTOP_EXPORT SvgIconAtlas
+{
+    public:
+
+        constexpr static const int DefaultPageSize=1024;
+        constexpr static const int Padding=1;
+
+        //! Location of an icon in the atlas.
+        struct Slot
+        {
+            int page=-1;
+            QRect rect;
+            quint64 generation=0;
+        };
+
+        using RenderFn=std::function<void (QPainter* painter, const QRect& rect)>;
+
+        /**
+         * @brief Constructor.
+         * @param pageSize Width and height of a page.
+         */
+        explicit SvgIconAtlas(int pageSize=DefaultPageSize);
+
+        SvgIconAtlas(const SvgIconAtlas&)=delete;
+        SvgIconAtlas(SvgIconAtlas&&)=delete;
+        SvgIconAtlas& operator=(const SvgIconAtlas&)=delete;
+        SvgIconAtlas& operator=(SvgIconAtlas&&)=delete;
+
+        int pageSize() const noexcept
+        {
+            return m_packer.pageWidth();
+        }
+
+        /**
+         * @brief Render an icon into the atlas.
+         * @param size Size of the icon in pixels.
+         * @param render Renderer of the icon, it gets a painter of the page and the rectangle to paint in.
+         * @return Slot of the icon, invalid if the size does not fit a page.
+         */
+        Slot insert(const QSize& size, const RenderFn& render);
+
+        //! Check if the slot was made by this atlas after the last clear().
+        bool isValid(const Slot& slot) const noexcept
+        {
+            return slot.page>=0 && slot.generation==m_generation;
+        }
+
+        /**
+         * @brief Draw an icon.
+         * @param painter Painter.
+         * @param target Target rectangle.
+         * @param slot Slot of the icon.
+         * @return False if the slot is not valid.
+         */
+        bool draw(QPainter* painter, const QRect& target, const Slot& slot) const;
+
+        //! Get a copy of an icon as a standalone pixmap.
+        QPixmap pixmap(const Slot& slot) const;
+
+        int pageCount() const noexcept
+        {
+            return static_cast<int>(m_pages.size());
+        }
+
+        const QPixmap& page(int index) const
+        {
+            return m_pages.at(index);
+        }
+
+        //! Number of icons in the atlas.
+        size_t count() const noexcept
+        {
+            return m_packer.count();
+        }
+
+        /**
+         * @brief Release a slot.
+         * @param slot Slot of an icon, invalid slots are ignored.
+         *
+         * The page of the slot is freed when it was the last slot of the page.
+         */
+        void release(const Slot& slot);
+
+        //! Remove all icons and pages.
+        void clear();
+
+    private:
+
+        ShelfPacker m_packer;
+        std::vector<QPixmap> m_pages;
+        quint64 m_generation=1;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_SVG_ICON_ATLAS_HPP
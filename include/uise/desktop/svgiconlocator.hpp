@@ -26,6 +26,11 @@ You may select, at your option, one of the above-listed licenses.
 #ifndef UISE_DESKTOP_SVG_ICON_LOCATOR_HPP
 #define UISE_DESKTOP_SVG_ICON_LOCATOR_HPP
 
+#include <algorithm>
+
+#include <QThread>
+#include <QThreadPool>
+
 #include <uise/desktop/uisedesktop.hpp>
 #include <uise/desktop/stylecontext.hpp>
 #include <uise/desktop/svgicon.hpp>
@@ -194,7 +199,9 @@ class UISE_DESKTOP_EXPORT SvgIconLocator
         using IconConfig=SvgIconConfig;
 
         SvgIconLocator() : m_defaultColorMapsPtr(&m_defaultColorMaps)
-        {}
+        {
+            m_warmUpPool->setMaxThreadCount(std::clamp(QThread::idealThreadCount()/2,1,4));
+        }
 
         std::shared_ptr<SvgIcon> icon(const QString& name, const StyleContext& ={}) const;
 
@@ -303,6 +310,41 @@ class UISE_DESKTOP_EXPORT SvgIconLocator
             return m_defaultSizes;
         }
 
+        /**
+         * @brief Set atlas shared by icons made by the locator.
+         *
+         * Atlas is opt-in, by default rasterised icons are kept in separate pixmaps. The atlas is set to icons
+         * when they are created, so it should be set before icons are loaded.
+         *
+         * @param atlas Atlas, nullptr to keep rasterised icons in separate pixmaps.
+         */
+        void setIconAtlas(std::shared_ptr<SvgIconAtlas> atlas)
+        {
+            m_iconAtlas=std::move(atlas);
+        }
+
+        std::shared_ptr<SvgIconAtlas> iconAtlas() const
+        {
+            return m_iconAtlas;
+        }
+
+        /**
+         * @brief Set thread pool for rendering of default sizes of icons made by the locator.
+         *
+         * By default the locator has its own pool, see SvgIcon::setWarmUpPool().
+         *
+         * @param pool Thread pool, nullptr to render default sizes synchronously.
+         */
+        void setWarmUpPool(std::shared_ptr<QThreadPool> pool)
+        {
+            m_warmUpPool=std::move(pool);
+        }
+
+        std::shared_ptr<QThreadPool> warmUpPool() const
+        {
+            return m_warmUpPool;
+        }
+
         void setFallbackIcon(const QString& name)
         {
             m_fallbackIcon=iconPriv(name,true);
@@ -326,6 +368,10 @@ class UISE_DESKTOP_EXPORT SvgIconLocator
         void reload()
         {
             clearCache();
+            if (m_iconAtlas)
+            {
+                m_iconAtlas->clear();
+            }
             reload(this);
 
             for (auto& it:m_selectorContexts)
@@ -427,6 +473,8 @@ class UISE_DESKTOP_EXPORT SvgIconLocator
         colorMapsT m_defaultColorMaps;
         colorMapsT* m_defaultColorMapsPtr=nullptr;
         SizeSet m_defaultSizes;
+        std::shared_ptr<SvgIconAtlas> m_iconAtlas;
+        std::shared_ptr<QThreadPool> m_warmUpPool=std::make_shared<QThreadPool>();
 
         std::shared_ptr<SvgIcon> m_fallbackIcon;
 };
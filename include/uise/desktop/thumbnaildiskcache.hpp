@@ -0,0 +1,128 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/thumbnaildiskcache.hpp
+*
+*  Declares on-disk cache of thumbnails.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_THUMBNAIL_DISK_CACHE_HPP
+#define UISE_DESKTOP_THUMBNAIL_DISK_CACHE_HPP
+
+#include <mutex>
+
+#include <QString>
+#include <QImage>
+
+#include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/utils/withpathandsize.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief On-disk cache of scaled images keyed by PixmapKey.
+ *
+ * Each image is stored in a separate file with raw pixels in a format ready for QPixmap, so an image is
+ * loaded by memory mapping of the file without any image codec. Each entry holds a fingerprint of the content
+ * it was made from, an entry with another fingerprint is treated as stale.
+ *
+ * Total size of the cache is kept within maxBytes(). The size of existing files is counted on the first write,
+ * and when a write exceeds the budget the least recently written entries are removed down to 3/4 of the budget.
+ *
+ * Methods can be called in any thread. Concurrent writes of the same key are safe, the last one wins.
+ */
+class UISE_DESKTOP_EXPORT ThumbnailDiskCache
+{
+    public:
+
+        constexpr static const quint32 FormatVersion=1;
+        constexpr static const qint64 DefaultMaxBytes=256*1024*1024;
+
+        /**
+         * @brief Constructor.
+         * @param directory Directory of cache files, created on the first write.
+         * @param maxBytes Maximum total size of cache files, 0 for unlimited.
+         */
+        explicit ThumbnailDiskCache(QString directory, qint64 maxBytes=DefaultMaxBytes);
+
+        ThumbnailDiskCache(const ThumbnailDiskCache&)=delete;
+        ThumbnailDiskCache(ThumbnailDiskCache&&)=delete;
+        ThumbnailDiskCache& operator=(const ThumbnailDiskCache&)=delete;
+        ThumbnailDiskCache& operator=(ThumbnailDiskCache&&)=delete;
+
+        QString directory() const
+        {
+            return m_directory;
+        }
+
+        qint64 maxBytes() const noexcept
+        {
+            return m_maxBytes;
+        }
+
+        /**
+         * @brief Load image.
+         * @param key Pixmap key.
+         * @param fingerprint Fingerprint of the content.
+         * @return Loaded image or null image if there is no valid entry for the key and fingerprint.
+         */
+        QImage load(const PixmapKey& key, quint64 fingerprint) const;
+
+        /**
+         * @brief Store image.
+         * @param key Pixmap key.
+         * @param fingerprint Fingerprint of the content.
+         * @param image Image.
+         * @return True on success.
+         */
+        bool store(const PixmapKey& key, quint64 fingerprint, const QImage& image) const;
+
+        void remove(const PixmapKey& key) const;
+
+        //! Remove all entries.
+        void clear() const;
+
+        /**
+         * @brief Remove the least recently written entries until total size of the cache fits the limit.
+         * @param maxBytes Maximum total size.
+         */
+        void trim(qint64 maxBytes) const;
+
+        //! Name of the file of the entry.
+        QString fileName(const PixmapKey& key) const;
+
+        //! Fingerprint of a file made of its size and modification time.
+        static quint64 fileFingerprint(const QString& fileName);
+
+    private:
+
+        qint64 doTrim(qint64 maxBytes) const;
+        void accountWritten(qint64 delta) const;
+
+        QString m_directory;
+        qint64 m_maxBytes;
+
+        mutable std::mutex m_mutex;
+        mutable qint64 m_totalBytes=-1;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_THUMBNAIL_DISK_CACHE_HPP
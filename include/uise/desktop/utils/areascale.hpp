@@ -0,0 +1,389 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/areascale.hpp
+*
+*  Defines areaScale32() downscaling 32-bit pixels by area averaging.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_AREASCALE_HPP
+#define UISE_DESKTOP_AREASCALE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#define UISE_DESKTOP_AREASCALE_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#define UISE_DESKTOP_AREASCALE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define UISE_DESKTOP_AREASCALE_NEON
+#include <arm_neon.h>
+#endif
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Rectangle of a source image in fractional pixels.
+ */
+struct AreaScaleRect
+{
+    double x=0.0;
+    double y=0.0;
+    double width=0.0;
+    double height=0.0;
+};
+
+namespace detail {
+
+/**
+ * @brief Source pixels covered by each destination pixel along one axis.
+ *
+ * Pixels inside a span are covered entirely and have the same weight, only the first and the last pixels
+ * may be covered partially. So inner pixels are summed with integer additions and only two pixels
+ * of a span are weighted individually.
+ */
+struct AreaScaleAxis
+{
+    struct Span
+    {
+        int first=0;
+        int count=1;
+        float firstWeight=1.0f;
+        float innerWeight=0.0f;
+        float lastWeight=0.0f;
+
+        float weight(int k) const noexcept
+        {
+            if (k==0)
+            {
+                return firstWeight;
+            }
+            return k==count-1 ? lastWeight : innerWeight;
+        }
+    };
+
+    std::vector<Span> spans;
+
+    AreaScaleAxis(double start, double length, int dstCount, int srcCount)
+    {
+        spans.reserve(dstCount);
+
+        double scale=length/dstCount;
+        for (int i=0;i<dstCount;i++)
+        {
+            double a=std::clamp(start+i*scale,0.0,double(srcCount));
+            double b=std::clamp(start+(i+1)*scale,0.0,double(srcCount));
+            int from=std::min(static_cast<int>(std::floor(a)),srcCount-1);
+            int to=std::max(std::min(static_cast<int>(std::ceil(b)),srcCount),from+1);
+
+            Span span;
+            span.first=from;
+            double total=b-a;
+            if (to-from>1 && total>0.0)
+            {
+                span.count=to-from;
+                span.firstWeight=static_cast<float>((from+1.0-a)/total);
+                span.innerWeight=static_cast<float>(1.0/total);
+                span.lastWeight=static_cast<float>((b-(to-1.0))/total);
+            }
+            // otherwise the span is inside one pixel, or outside of the source and the nearest pixel is taken
+            spans.push_back(span);
+        }
+    }
+};
+
+#if defined(UISE_DESKTOP_AREASCALE_SSE2)
+
+inline __m128 areaScaleLoad(const std::uint8_t* px)
+{
+    const __m128i zero=_mm_setzero_si128();
+    std::int32_t v;
+    std::memcpy(&v,px,4);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v),zero),zero));
+}
+
+inline __m128 areaScaleSum(const std::uint8_t* px, int count)
+{
+    const __m128i zero=_mm_setzero_si128();
+    __m128i total=_mm_setzero_si128();
+    while (count>0)
+    {
+        // 16-bit lanes hold sums of two pixels of each step, 512 pixels do not overflow them
+        int chunk=std::min(count,512);
+        count-=chunk;
+        __m128i acc=_mm_setzero_si128();
+        for (;chunk>=4;chunk-=4,px+=16)
+        {
+            auto v=_mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+            acc=_mm_add_epi16(acc,_mm_add_epi16(_mm_unpacklo_epi8(v,zero),_mm_unpackhi_epi8(v,zero)));
+        }
+        if (chunk>=2)
+        {
+            auto v=_mm_loadl_epi64(reinterpret_cast<const __m128i*>(px));
+            acc=_mm_add_epi16(acc,_mm_unpacklo_epi8(v,zero));
+            chunk-=2;
+            px+=8;
+        }
+        if (chunk==1)
+        {
+            std::int32_t v;
+            std::memcpy(&v,px,4);
+            acc=_mm_add_epi16(acc,_mm_unpacklo_epi8(_mm_cvtsi32_si128(v),zero));
+            px+=4;
+        }
+        total=_mm_add_epi32(total,_mm_add_epi32(_mm_unpacklo_epi16(acc,zero),_mm_unpackhi_epi16(acc,zero)));
+    }
+    return _mm_cvtepi32_ps(total);
+}
+
+#elif defined(UISE_DESKTOP_AREASCALE_NEON)
+
+inline float32x4_t areaScaleLoad(const std::uint8_t* px)
+{
+    std::uint32_t v;
+    std::memcpy(&v,px,4);
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v))))));
+}
+
+inline float32x4_t areaScaleSum(const std::uint8_t* px, int count)
+{
+    uint32x4_t total=vdupq_n_u32(0);
+    while (count>0)
+    {
+        // 16-bit lanes hold sums of one pixel of each step, 512 pixels do not overflow them
+        int chunk=std::min(count,512);
+        count-=chunk;
+        uint16x8_t acc=vdupq_n_u16(0);
+        for (;chunk>=2;chunk-=2,px+=8)
+        {
+            acc=vaddw_u8(acc,vld1_u8(px));
+        }
+        total=vaddq_u32(total,vaddl_u16(vget_low_u16(acc),vget_high_u16(acc)));
+        if (chunk==1)
+        {
+            std::uint32_t v;
+            std::memcpy(&v,px,4);
+            total=vaddq_u32(total,vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v))))));
+            px+=4;
+        }
+    }
+    return vcvtq_f32_u32(total);
+}
+
+#endif
+
+//! Average source pixels of a row covered by each destination pixel, 4 floats per destination pixel.
+inline void areaScaleRow(const std::uint8_t* row, const AreaScaleAxis& axis, float* out)
+{
+    for (size_t i=0;i<axis.spans.size();i++)
+    {
+        const auto& span=axis.spans[i];
+        auto px=row+static_cast<size_t>(span.first)*4;
+
+#if defined(UISE_DESKTOP_AREASCALE_SSE2)
+        auto sum=_mm_mul_ps(areaScaleLoad(px),_mm_set1_ps(span.firstWeight));
+        if (span.count>1)
+        {
+            sum=_mm_add_ps(sum,_mm_mul_ps(areaScaleLoad(px+(span.count-1)*4),_mm_set1_ps(span.lastWeight)));
+        }
+        if (span.count>2)
+        {
+            sum=_mm_add_ps(sum,_mm_mul_ps(areaScaleSum(px+4,span.count-2),_mm_set1_ps(span.innerWeight)));
+        }
+        _mm_storeu_ps(out+i*4,sum);
+#elif defined(UISE_DESKTOP_AREASCALE_NEON)
+        auto sum=vmulq_n_f32(areaScaleLoad(px),span.firstWeight);
+        if (span.count>1)
+        {
+            sum=vmlaq_n_f32(sum,areaScaleLoad(px+(span.count-1)*4),span.lastWeight);
+        }
+        if (span.count>2)
+        {
+            sum=vmlaq_n_f32(sum,areaScaleSum(px+4,span.count-2),span.innerWeight);
+        }
+        vst1q_f32(out+i*4,sum);
+#else
+        auto last=px+(span.count-1)*4;
+        for (int c=0;c<4;c++)
+        {
+            float sum=px[c]*span.firstWeight;
+            if (span.count>1)
+            {
+                sum+=last[c]*span.lastWeight;
+            }
+            if (span.count>2)
+            {
+                std::uint32_t inner=0;
+                for (int k=1;k<span.count-1;k++)
+                {
+                    inner+=px[k*4+c];
+                }
+                sum+=inner*span.innerWeight;
+            }
+            out[i*4+c]=sum;
+        }
+#endif
+    }
+}
+
+//! Add a row multiplied by the weight to the accumulator.
+inline void areaScaleAccumulate(float* acc, const float* row, float weight, size_t count)
+{
+    size_t i=0;
+#if defined(UISE_DESKTOP_AREASCALE_AVX2)
+    const __m256 w8=_mm256_set1_ps(weight);
+    for (;i+8<=count;i+=8)
+    {
+        _mm256_storeu_ps(acc+i,_mm256_add_ps(_mm256_loadu_ps(acc+i),_mm256_mul_ps(_mm256_loadu_ps(row+i),w8)));
+    }
+#endif
+#if defined(UISE_DESKTOP_AREASCALE_SSE2)
+    const __m128 w4=_mm_set1_ps(weight);
+    for (;i+4<=count;i+=4)
+    {
+        _mm_storeu_ps(acc+i,_mm_add_ps(_mm_loadu_ps(acc+i),_mm_mul_ps(_mm_loadu_ps(row+i),w4)));
+    }
+#elif defined(UISE_DESKTOP_AREASCALE_NEON)
+    for (;i+4<=count;i+=4)
+    {
+        vst1q_f32(acc+i,vmlaq_n_f32(vld1q_f32(acc+i),vld1q_f32(row+i),weight));
+    }
+#endif
+    for (;i<count;i++)
+    {
+        acc[i]+=row[i]*weight;
+    }
+}
+
+//! Round accumulated channels to 8-bit pixels.
+inline void areaScaleStore(const float* acc, std::uint8_t* dst, size_t pixels, std::uint32_t orMask)
+{
+    for (size_t i=0;i<pixels;i++)
+    {
+        std::uint32_t px;
+#if defined(UISE_DESKTOP_AREASCALE_SSE2)
+        auto v=_mm_cvtps_epi32(_mm_loadu_ps(acc+i*4));
+        v=_mm_packs_epi32(v,v);
+        v=_mm_packus_epi16(v,v);
+        px=static_cast<std::uint32_t>(_mm_cvtsi128_si32(v));
+#elif defined(UISE_DESKTOP_AREASCALE_NEON)
+        auto v=vcvtq_u32_f32(vaddq_f32(vld1q_f32(acc+i*4),vdupq_n_f32(0.5f)));
+        auto v16=vqmovn_u32(v);
+        auto v8=vqmovn_u16(vcombine_u16(v16,v16));
+        px=vget_lane_u32(vreinterpret_u32_u8(v8),0);
+#else
+        std::uint8_t bytes[4];
+        for (int c=0;c<4;c++)
+        {
+            bytes[c]=static_cast<std::uint8_t>(std::min(static_cast<int>(acc[i*4+c]+0.5f),255));
+        }
+        std::memcpy(&px,bytes,4);
+#endif
+        px|=orMask;
+        std::memcpy(dst+i*4,&px,4);
+    }
+}
+
+}
+
+//! Name of the instruction set used by areaScale32().
+constexpr const char* areaScaleInstructionSet() noexcept
+{
+#if defined(UISE_DESKTOP_AREASCALE_AVX2)
+    return "AVX2";
+#elif defined(UISE_DESKTOP_AREASCALE_SSE2)
+    return "SSE2";
+#elif defined(UISE_DESKTOP_AREASCALE_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+/**
+ * @brief Scale a rectangle of 32-bit pixels by area averaging.
+ * @param src Source pixels.
+ * @param srcStride Bytes per line of the source.
+ * @param srcWidth Width of the source.
+ * @param srcHeight Height of the source.
+ * @param rect Rectangle of the source to scale, the part outside of the source is clamped.
+ * @param dst Destination pixels.
+ * @param dstStride Bytes per line of the destination.
+ * @param dstWidth Width of the destination.
+ * @param dstHeight Height of the destination.
+ * @param orMask Mask applied to each destination pixel, e.g. to make alpha opaque.
+ *
+ * Each destination pixel is the average of the source pixels it covers weighted by the covered area, which is
+ * the right filter for downscaling. Channels are averaged independently, so any 4-channel 8-bit format works,
+ * colors with alpha must be premultiplied. Each source row is filtered horizontally once, rows are then
+ * accumulated vertically. Inner loops use SSE2 or NEON, and AVX2 for vertical accumulation when enabled
+ * at compile time.
+ */
+inline void areaScale32(const std::uint8_t* src, std::ptrdiff_t srcStride, int srcWidth, int srcHeight,
+                        const AreaScaleRect& rect,
+                        std::uint8_t* dst, std::ptrdiff_t dstStride, int dstWidth, int dstHeight,
+                        std::uint32_t orMask=0)
+{
+    if (src==nullptr || dst==nullptr || srcWidth<=0 || srcHeight<=0 || dstWidth<=0 || dstHeight<=0)
+    {
+        return;
+    }
+
+    detail::AreaScaleAxis xAxis{rect.x,rect.width,dstWidth,srcWidth};
+    detail::AreaScaleAxis yAxis{rect.y,rect.height,dstHeight,srcHeight};
+
+    auto channels=static_cast<size_t>(dstWidth)*4;
+    std::vector<float> row(channels);
+    std::vector<float> acc(channels);
+
+    // a source row on the border of two destination rows is filtered once for both
+    int filteredRow=-1;
+    for (int y=0;y<dstHeight;y++)
+    {
+        const auto& span=yAxis.spans[y];
+        std::fill(acc.begin(),acc.end(),0.0f);
+        for (int k=0;k<span.count;k++)
+        {
+            int srcRow=span.first+k;
+            if (srcRow!=filteredRow)
+            {
+                detail::areaScaleRow(src+srcRow*srcStride,xAxis,row.data());
+                filteredRow=srcRow;
+            }
+            detail::areaScaleAccumulate(acc.data(),row.data(),span.weight(k),channels);
+        }
+        detail::areaScaleStore(acc.data(),dst+y*dstStride,static_cast<size_t>(dstWidth),orMask);
+    }
+}
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_AREASCALE_HPP
@@ -0,0 +1,238 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/bytebudgetlru.hpp
+*
+*  Defines ByteBudgetLru.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_BYTEBUDGETLRU_HPP
+#define UISE_DESKTOP_BYTEBUDGETLRU_HPP
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Counters of ByteBudgetLru.
+ */
+struct ByteBudgetLruStats
+{
+    size_t hits=0;
+    size_t misses=0;
+    size_t evictions=0;
+};
+
+/**
+ * @brief Accounting of least recently used entries limited by total size in bytes.
+ *
+ * The class does not hold values, it only tracks keys, their sizes and recency and decides which keys must be
+ * evicted when total size exceeds the budget. Pinned entries, e.g. entries in use, are accounted in total size
+ * but never evicted.
+ */
+template <typename KeyT>
+class ByteBudgetLru
+{
+    public:
+
+        /**
+         * @brief Set budget.
+         * @param bytes Maximum total size, 0 means no budget.
+         */
+        void setBudget(size_t bytes) noexcept
+        {
+            m_budget=bytes;
+        }
+
+        size_t budget() const noexcept
+        {
+            return m_budget;
+        }
+
+        size_t totalBytes() const noexcept
+        {
+            return m_totalBytes;
+        }
+
+        size_t size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+        bool contains(const KeyT& key) const
+        {
+            return m_index.find(key)!=m_index.end();
+        }
+
+        bool isOverBudget() const noexcept
+        {
+            return m_budget!=0 && m_totalBytes>m_budget;
+        }
+
+        /**
+         * @brief Insert entry as the most recently used one or touch existing entry.
+         */
+        void insert(const KeyT& key, size_t bytes=0, bool pinned=true)
+        {
+            auto it=m_index.find(key);
+            if (it!=m_index.end())
+            {
+                setBytes(it->second,bytes);
+                it->second->pinned=pinned;
+                touch(it->second);
+                return;
+            }
+            m_entries.push_front(Entry{key,bytes,pinned});
+            m_index.emplace(key,m_entries.begin());
+            m_totalBytes+=bytes;
+        }
+
+        void setBytes(const KeyT& key, size_t bytes)
+        {
+            auto it=m_index.find(key);
+            if (it!=m_index.end())
+            {
+                setBytes(it->second,bytes);
+            }
+        }
+
+        //! Make entry the most recently used one.
+        void touch(const KeyT& key)
+        {
+            auto it=m_index.find(key);
+            if (it!=m_index.end())
+            {
+                touch(it->second);
+            }
+        }
+
+        void setPinned(const KeyT& key, bool pinned)
+        {
+            auto it=m_index.find(key);
+            if (it!=m_index.end())
+            {
+                it->second->pinned=pinned;
+            }
+        }
+
+        void erase(const KeyT& key)
+        {
+            auto it=m_index.find(key);
+            if (it!=m_index.end())
+            {
+                m_totalBytes-=it->second->bytes;
+                m_entries.erase(it->second);
+                m_index.erase(it);
+            }
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+            m_index.clear();
+            m_totalBytes=0;
+        }
+
+        /**
+         * @brief Evict the least recently used unpinned entries until total size fits the budget.
+         * @return Evicted keys, the coldest first.
+         */
+        std::vector<KeyT> evict()
+        {
+            std::vector<KeyT> keys;
+            if (!isOverBudget())
+            {
+                return keys;
+            }
+
+            auto it=m_entries.end();
+            while (it!=m_entries.begin() && isOverBudget())
+            {
+                --it;
+                if (it->pinned)
+                {
+                    continue;
+                }
+
+                keys.push_back(it->key);
+                m_totalBytes-=it->bytes;
+                m_index.erase(it->key);
+                it=m_entries.erase(it);
+                m_stats.evictions++;
+            }
+            return keys;
+        }
+
+        void recordHit() noexcept
+        {
+            m_stats.hits++;
+        }
+
+        void recordMiss() noexcept
+        {
+            m_stats.misses++;
+        }
+
+        const ByteBudgetLruStats& stats() const noexcept
+        {
+            return m_stats;
+        }
+
+        void resetStats() noexcept
+        {
+            m_stats=ByteBudgetLruStats{};
+        }
+
+    private:
+
+        struct Entry
+        {
+            KeyT key;
+            size_t bytes=0;
+            bool pinned=true;
+        };
+
+        using Iterator=typename std::list<Entry>::iterator;
+
+        void setBytes(Iterator it, size_t bytes) noexcept
+        {
+            m_totalBytes=m_totalBytes-it->bytes+bytes;
+            it->bytes=bytes;
+        }
+
+        void touch(Iterator it)
+        {
+            m_entries.splice(m_entries.begin(),m_entries,it);
+        }
+
+        std::list<Entry> m_entries;
+        std::map<KeyT,Iterator> m_index;
+        size_t m_budget=0;
+        size_t m_totalBytes=0;
+        ByteBudgetLruStats m_stats;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_BYTEBUDGETLRU_HPP
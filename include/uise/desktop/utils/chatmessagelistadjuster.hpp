@@ -0,0 +1,213 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/chatmessagelistadjuster.hpp
+*
+*  Defines ChatMessageListAdjuster.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_CHATMESSAGELISTADJUSTER_HPP
+#define UISE_DESKTOP_CHATMESSAGELISTADJUSTER_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Evaluates separators and batch flags of messages in a chat.
+ *
+ * Rules applied to the messages in the order of the list:
+ *  - date separator of a message depends on the date of the previous message;
+ *  - unread separator is shown on the first unread message unless it is the last message in the list;
+ *  - a message is the first in a batch if it is the first message, or it has a top separator,
+ *    or the previous message is from another sender;
+ *  - a message is the last in a batch if it is the last message, or the next message has a top separator,
+ *    or the next message is from another sender.
+ *
+ * ListT is an adapter of the list of messages that must provide:
+ *  - type Message;
+ *  - Message* prev(Message*) and Message* next(Message*), nullptr at the edges;
+ *  - Message* last();
+ *  - bool isBefore(Message*, Message*) for ordering messages;
+ *  - void updateDateSeparator(Message* msg, Message* prev), prev is nullptr for the first message;
+ *  - bool isUnread(Message*), bool isUnreadSeparatorVisible(Message*) and void setUnreadSeparatorVisible(Message*,bool);
+ *  - bool isTopSeparatorVisible(Message*);
+ *  - bool sameSender(Message* prev, Message* next);
+ *  - void setFirstInBatch(Message*,bool) and void setLastInBatch(Message*,bool).
+ *
+ * Navigation methods are used only by adjustAround().
+ */
+template <typename ListT>
+class ChatMessageListAdjuster
+{
+    public:
+
+        using Message=typename ListT::Message;
+
+        /**
+         * @brief Evaluate all messages.
+         * @param list List adapter.
+         * @param messages All messages sorted in the order of the list.
+         * @return Message with unread separator or nullptr.
+         */
+        static Message* adjust(ListT& list, const std::vector<Message*>& messages)
+        {
+            Message* unreadHolder=nullptr;
+            for (size_t i=0;i<messages.size();i++)
+            {
+                auto msg=messages[i];
+                list.updateDateSeparator(msg,i==0?nullptr:messages[i-1]);
+
+                if (unreadHolder==nullptr && list.isUnread(msg) && i<(messages.size()-1))
+                {
+                    list.setUnreadSeparatorVisible(msg,true);
+                    unreadHolder=msg;
+                }
+                else if (list.isUnreadSeparatorVisible(msg))
+                {
+                    list.setUnreadSeparatorVisible(msg,false);
+                }
+            }
+
+            for (size_t i=0;i<messages.size();i++)
+            {
+                auto msg=messages[i];
+                list.setFirstInBatch(msg,isFirstInBatch(list,msg,i==0?nullptr:messages[i-1]));
+                list.setLastInBatch(msg,isLastInBatch(list,msg,i==messages.size()-1?nullptr:messages[i+1]));
+            }
+
+            return unreadHolder;
+        }
+
+        /**
+         * @brief Re-evaluate only messages around the changed ones.
+         * @param list List adapter.
+         * @param touched Messages that were inserted or moved, or whose neighbours were inserted, moved or removed.
+         * @param unreadHolder Message with unread separator as returned by the previous evaluation.
+         * @return Message with unread separator or nullptr.
+         *
+         * All other messages must be in the state left by the previous evaluation.
+         */
+        static Message* adjustAround(ListT& list, const std::vector<Message*>& touched, Message* unreadHolder)
+        {
+            // date separators depend on the previous message
+            std::vector<Message*> separators;
+            separators.reserve(touched.size()*2+2);
+            for (auto msg : touched)
+            {
+                separators.push_back(msg);
+                addIfNotNull(separators,list.next(msg));
+            }
+            unique(separators);
+            for (auto msg : separators)
+            {
+                list.updateDateSeparator(msg,list.prev(msg));
+            }
+
+            // the first unread message is either the previous one or one of the changed messages,
+            // including a message that used to be the last one before messages were appended after it
+            Message* firstUnread=nullptr;
+            auto consider=[&list,&firstUnread](Message* msg)
+            {
+                if (msg!=nullptr && list.isUnread(msg) && (firstUnread==nullptr || list.isBefore(msg,firstUnread)))
+                {
+                    firstUnread=msg;
+                }
+            };
+            consider(unreadHolder);
+            for (auto msg : touched)
+            {
+                consider(msg);
+                consider(list.prev(msg));
+            }
+            auto newUnreadHolder=(firstUnread!=nullptr && firstUnread!=list.last())?firstUnread:nullptr;
+            if (newUnreadHolder!=unreadHolder)
+            {
+                if (unreadHolder!=nullptr)
+                {
+                    list.setUnreadSeparatorVisible(unreadHolder,false);
+                    separators.push_back(unreadHolder);
+                }
+                if (newUnreadHolder!=nullptr)
+                {
+                    list.setUnreadSeparatorVisible(newUnreadHolder,true);
+                    separators.push_back(newUnreadHolder);
+                }
+            }
+            for (auto msg : touched)
+            {
+                if (msg!=newUnreadHolder && list.isUnreadSeparatorVisible(msg))
+                {
+                    list.setUnreadSeparatorVisible(msg,false);
+                }
+            }
+
+            // batch flags depend on the neighbours and their separators
+            std::vector<Message*> batches;
+            batches.reserve(separators.size()*3);
+            for (auto msg : separators)
+            {
+                addIfNotNull(batches,list.prev(msg));
+                batches.push_back(msg);
+                addIfNotNull(batches,list.next(msg));
+            }
+            unique(batches);
+            for (auto msg : batches)
+            {
+                list.setFirstInBatch(msg,isFirstInBatch(list,msg,list.prev(msg)));
+                list.setLastInBatch(msg,isLastInBatch(list,msg,list.next(msg)));
+            }
+
+            return newUnreadHolder;
+        }
+
+    private:
+
+        static bool isFirstInBatch(ListT& list, Message* msg, Message* prev)
+        {
+            return prev==nullptr || list.isTopSeparatorVisible(msg) || !list.sameSender(prev,msg);
+        }
+
+        static bool isLastInBatch(ListT& list, Message* msg, Message* next)
+        {
+            return next==nullptr || list.isTopSeparatorVisible(next) || !list.sameSender(msg,next);
+        }
+
+        static void addIfNotNull(std::vector<Message*>& messages, Message* msg)
+        {
+            if (msg!=nullptr)
+            {
+                messages.push_back(msg);
+            }
+        }
+
+        static void unique(std::vector<Message*>& messages)
+        {
+            std::sort(messages.begin(),messages.end());
+            messages.erase(std::unique(messages.begin(),messages.end()),messages.end());
+        }
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_CHATMESSAGELISTADJUSTER_HPP
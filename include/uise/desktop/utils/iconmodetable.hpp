@@ -0,0 +1,215 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/iconmodetable.hpp
+*
+*  Defines IconModeTable.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_ICONMODETABLE_HPP
+#define UISE_DESKTOP_ICONMODETABLE_HPP
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Table of values indexed by icon mode and icon state.
+ *
+ * Values of the predefined modes, from 0 to FixedModeCount-1, are kept in fixed slots, so a lookup
+ * is a single index computation. Other modes, e.g. IconMode::User values, go to a small overflow vector
+ * that is searched linearly.
+ *
+ * @tparam T Type of values.
+ * @tparam StateCount Number of states, a state is an index from 0 to StateCount-1.
+ */
+template <typename T, int StateCount=2>
+class IconModeTable
+{
+    public:
+
+        //! Number of modes kept in fixed slots, see IconMode.
+        constexpr static const int FixedModeCount=6;
+
+        /**
+         * @brief Find value.
+         * @param mode Icon mode.
+         * @param state Index of state.
+         * @return Value or nullptr if not found.
+         */
+        const T* find(int mode, int state=0) const noexcept
+        {
+            if (isFixed(mode))
+            {
+                auto idx=slot(mode,state);
+                return m_used[idx] ? &m_slots[idx] : nullptr;
+            }
+            for (const auto& entry : m_overflow)
+            {
+                if (entry.mode==mode && entry.state==state)
+                {
+                    return &entry.value;
+                }
+            }
+            return nullptr;
+        }
+
+        T* find(int mode, int state=0) noexcept
+        {
+            return const_cast<T*>(std::as_const(*this).find(mode,state));
+        }
+
+        /**
+         * @brief Get value, a default value is inserted if not found.
+         * @param mode Icon mode.
+         * @param state Index of state.
+         * @return Value.
+         */
+        T& value(int mode, int state=0)
+        {
+            if (isFixed(mode))
+            {
+                auto idx=slot(mode,state);
+                m_used[idx]=true;
+                return m_slots[idx];
+            }
+            auto existing=find(mode,state);
+            if (existing!=nullptr)
+            {
+                return *existing;
+            }
+            m_overflow.push_back(Entry{mode,state,T{}});
+            return m_overflow.back().value;
+        }
+
+        /**
+         * @brief Set value.
+         * @param mode Icon mode.
+         * @param state Index of state.
+         * @param value Value.
+         */
+        void set(int mode, int state, T value)
+        {
+            this->value(mode,state)=std::move(value);
+        }
+
+        /**
+         * @brief Remove value.
+         * @param mode Icon mode.
+         * @param state Index of state.
+         * @return True if value was found.
+         */
+        bool erase(int mode, int state=0)
+        {
+            if (isFixed(mode))
+            {
+                auto idx=slot(mode,state);
+                bool found=m_used[idx];
+                m_used[idx]=false;
+                m_slots[idx]=T{};
+                return found;
+            }
+            for (auto it=m_overflow.begin();it!=m_overflow.end();++it)
+            {
+                if (it->mode==mode && it->state==state)
+                {
+                    m_overflow.erase(it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void clear()
+        {
+            m_slots.fill(T{});
+            m_used.fill(false);
+            m_overflow.clear();
+        }
+
+        size_t size() const noexcept
+        {
+            size_t count=m_overflow.size();
+            for (auto used : m_used)
+            {
+                if (used)
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        bool empty() const noexcept
+        {
+            return size()==0;
+        }
+
+        /**
+         * @brief Invoke a handler for each value.
+         * @param handler Handler with signature (int mode, int state, const T& value).
+         */
+        template <typename HandlerT>
+        void forEach(HandlerT&& handler) const
+        {
+            for (size_t i=0;i<m_slots.size();i++)
+            {
+                if (m_used[i])
+                {
+                    handler(static_cast<int>(i)/StateCount,static_cast<int>(i)%StateCount,m_slots[i]);
+                }
+            }
+            for (const auto& entry : m_overflow)
+            {
+                handler(entry.mode,entry.state,entry.value);
+            }
+        }
+
+    private:
+
+        struct Entry
+        {
+            int mode;
+            int state;
+            T value;
+        };
+
+        constexpr static bool isFixed(int mode) noexcept
+        {
+            return mode>=0 && mode<FixedModeCount;
+        }
+
+        constexpr static size_t slot(int mode, int state) noexcept
+        {
+            return static_cast<size_t>(mode*StateCount+state);
+        }
+
+        std::array<T,FixedModeCount*StateCount> m_slots;
+        std::array<bool,FixedModeCount*StateCount> m_used{};
+        std::vector<Entry> m_overflow;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_ICONMODETABLE_HPP
@@ -0,0 +1,239 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/kineticscroller.hpp
+*
+*  Defines KineticScroller.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_KINETICSCROLLER_HPP
+#define UISE_DESKTOP_KINETICSCROLLER_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Frame-clocked scroll animator.
+ *
+ * Scroll input is only accumulated here, the owner advances the animator once per frame
+ * with advance() and applies the returned number of pixels in a single scroll operation.
+ * Three kinds of input are supported:
+ *  - scrollBy() for coarse deltas such as mouse wheel notches, the distance is covered smoothly
+ *    with exponential easing;
+ *  - moveBy() for precise deltas such as touchpad pixel deltas, the deltas are applied as is on the next frame
+ *    and are used for tracking velocity of the gesture;
+ *  - release() for the end of the gesture, the scrolling continues with the tracked velocity that decays
+ *    exponentially.
+ *
+ * Time values are in milliseconds, distances are in pixels.
+ * Fractions of pixels are carried over to the next frames.
+ */
+class KineticScroller
+{
+    public:
+
+        constexpr static const int DefaultFrameInterval=16;
+        constexpr static const double DefaultSmoothingTime=60.0;
+        constexpr static const double DefaultDecelerationTime=325.0;
+        constexpr static const double MinFlingVelocity=0.3;
+        constexpr static const double StopVelocity=0.02;
+        constexpr static const double VelocitySampleTimeout=100.0;
+
+        /**
+         * @brief Set time constant of easing of coarse deltas.
+         */
+        void setSmoothingTime(double value) noexcept
+        {
+            m_smoothingTime=std::max(value,1.0);
+        }
+
+        double smoothingTime() const noexcept
+        {
+            return m_smoothingTime;
+        }
+
+        /**
+         * @brief Set time constant of velocity decay after the gesture is released.
+         */
+        void setDecelerationTime(double value) noexcept
+        {
+            m_decelerationTime=std::max(value,1.0);
+        }
+
+        double decelerationTime() const noexcept
+        {
+            return m_decelerationTime;
+        }
+
+        /**
+         * @brief Scroll smoothly by coarse distance.
+         * @param distance Distance to scroll by.
+         *
+         * Scrolling in opposite direction drops the distance that is not covered yet.
+         */
+        void scrollBy(double distance) noexcept
+        {
+            if (distance*m_pending<0.0 || distance*m_velocity<0.0)
+            {
+                stop();
+            }
+            m_velocity=0.0;
+            m_pending+=distance;
+        }
+
+        /**
+         * @brief Move by precise delta of an ongoing gesture.
+         * @param delta Delta to move by.
+         * @param timestamp Time of the delta.
+         */
+        void moveBy(double delta, double timestamp) noexcept
+        {
+            if (delta*m_immediate<0.0 || delta*m_pending<0.0)
+            {
+                stop();
+            }
+            m_velocity=0.0;
+            m_immediate+=delta;
+
+            auto elapsed=timestamp-m_lastSampleTime;
+            if (!m_hasSample || elapsed>VelocitySampleTimeout || elapsed<0.0)
+            {
+                m_sampleVelocity=0.0;
+            }
+            else
+            {
+                auto sample=delta/std::max(elapsed,1.0);
+                m_sampleVelocity=0.8*sample+0.2*m_sampleVelocity;
+            }
+            m_hasSample=true;
+            m_lastSampleTime=timestamp;
+        }
+
+        /**
+         * @brief Release the gesture and continue scrolling with velocity of the gesture.
+         * @param timestamp Time of release.
+         * @return True if scrolling continues.
+         */
+        bool release(double timestamp) noexcept
+        {
+            if (m_hasSample
+                && (timestamp-m_lastSampleTime)<=VelocitySampleTimeout
+                && std::abs(m_sampleVelocity)>=MinFlingVelocity
+                )
+            {
+                m_velocity=m_sampleVelocity;
+            }
+            m_hasSample=false;
+            m_sampleVelocity=0.0;
+            return isActive();
+        }
+
+        /**
+         * @brief Stop scrolling, e.g. when an edge of the list is reached.
+         */
+        void stop() noexcept
+        {
+            m_pending=0.0;
+            m_immediate=0.0;
+            m_velocity=0.0;
+            m_remainder=0.0;
+        }
+
+        /**
+         * @brief Check if there is anything to scroll by in the next frames.
+         */
+        bool isActive() const noexcept
+        {
+            return m_immediate!=0.0 || std::abs(m_pending)>=PendingEpsilon || m_velocity!=0.0;
+        }
+
+        /**
+         * @brief Get current velocity of release scrolling.
+         */
+        double velocity() const noexcept
+        {
+            return m_velocity;
+        }
+
+        /**
+         * @brief Advance animation by a frame.
+         * @param elapsed Time elapsed since the previous frame.
+         * @return Number of whole pixels to scroll by in this frame.
+         */
+        int advance(double elapsed) noexcept
+        {
+            elapsed=std::max(elapsed,0.0);
+
+            auto distance=m_immediate;
+            m_immediate=0.0;
+
+            if (m_pending!=0.0)
+            {
+                auto part=m_pending*(1.0-std::exp(-elapsed/m_smoothingTime));
+                if (std::abs(m_pending-part)<PendingEpsilon)
+                {
+                    part=m_pending;
+                }
+                m_pending-=part;
+                distance+=part;
+            }
+
+            if (m_velocity!=0.0)
+            {
+                auto decay=std::exp(-elapsed/m_decelerationTime);
+                distance+=m_velocity*m_decelerationTime*(1.0-decay);
+                m_velocity*=decay;
+                if (std::abs(m_velocity)<StopVelocity)
+                {
+                    m_velocity=0.0;
+                }
+            }
+
+            m_remainder+=distance;
+            auto step=static_cast<int>(m_remainder+std::copysign(RemainderEpsilon,m_remainder));
+            m_remainder-=step;
+            return step;
+        }
+
+    private:
+
+        constexpr static const double PendingEpsilon=0.5;
+        constexpr static const double RemainderEpsilon=0.000001;
+
+        double m_smoothingTime=DefaultSmoothingTime;
+        double m_decelerationTime=DefaultDecelerationTime;
+
+        double m_pending=0.0;
+        double m_immediate=0.0;
+        double m_velocity=0.0;
+        double m_remainder=0.0;
+
+        bool m_hasSample=false;
+        double m_lastSampleTime=0.0;
+        double m_sampleVelocity=0.0;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_KINETICSCROLLER_HPP
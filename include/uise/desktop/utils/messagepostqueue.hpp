@@ -0,0 +1,227 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/messagepostqueue.hpp
+*
+*  Defines MessagePostQueue.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_MESSAGEPOSTQUEUE_HPP
+#define UISE_DESKTOP_MESSAGEPOSTQUEUE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Statistics of MessagePostQueue.
+ */
+struct MessagePostStats
+{
+    //! Number of posted operations.
+    size_t posted=0;
+
+    //! Number of posted operations merged into operations already pending for the same message.
+    size_t coalesced=0;
+
+    //! Number of operations taken for committing.
+    size_t committed=0;
+
+    //! Number of commits.
+    size_t commits=0;
+
+    //! Number of commits that left operations in the queue because of the commit limit.
+    size_t deferredCommits=0;
+
+    //! Maximum number of pending operations.
+    size_t maxPending=0;
+
+    //! Duration of the last commit in milliseconds.
+    int64_t lastCommitDuration=0;
+
+    //! Maximum duration of a commit in milliseconds.
+    int64_t maxCommitDuration=0;
+};
+
+/**
+ * @brief Queue of pending changes of messages in a chat.
+ *
+ * Operations posted for the same message are merged into a single operation so that only the final state
+ * of the message is committed. Operations are taken in the order of the first post for each message.
+ */
+template <typename IdT, typename DataT>
+class MessagePostQueue
+{
+    public:
+
+        struct Operation
+        {
+            IdT id;
+
+            //! Data to insert or update the message with.
+            std::optional<DataT> data;
+
+            //! Remove the message.
+            bool remove=false;
+
+            //! Reorder the message after its sort value was changed.
+            bool reorder=false;
+        };
+
+        /**
+         * @brief Post data of a message to insert or to update.
+         */
+        void postData(const IdT& id, DataT data)
+        {
+            auto& op=operation(id);
+            op.data=std::move(data);
+            op.remove=false;
+        }
+
+        /**
+         * @brief Post removal of a message.
+         */
+        void postRemove(const IdT& id)
+        {
+            auto& op=operation(id);
+            op.data.reset();
+            op.reorder=false;
+            op.remove=true;
+        }
+
+        /**
+         * @brief Post reordering of a message.
+         */
+        void postReorder(const IdT& id)
+        {
+            auto& op=operation(id);
+            if (!op.remove)
+            {
+                op.reorder=true;
+            }
+        }
+
+        /**
+         * @brief Take pending operations.
+         * @param maxCount Maximum number of operations to take, 0 means all.
+         */
+        std::vector<Operation> take(size_t maxCount=0)
+        {
+            auto count=m_operations.size();
+            if (maxCount!=0)
+            {
+                count=std::min(count,maxCount);
+            }
+
+            std::vector<Operation> ops;
+            ops.reserve(count);
+            for (size_t i=0;i<count;i++)
+            {
+                auto& op=m_operations.front();
+                m_index.erase(op.id);
+                ops.emplace_back(std::move(op));
+                m_operations.pop_front();
+            }
+
+            if (!ops.empty())
+            {
+                m_stats.committed+=ops.size();
+                m_stats.commits++;
+                if (!m_operations.empty())
+                {
+                    m_stats.deferredCommits++;
+                }
+            }
+            return ops;
+        }
+
+        /**
+         * @brief Account duration of the last commit.
+         * @param duration Duration in milliseconds.
+         */
+        void commitDone(int64_t duration) noexcept
+        {
+            m_stats.lastCommitDuration=duration;
+            m_stats.maxCommitDuration=std::max(m_stats.maxCommitDuration,duration);
+        }
+
+        size_t size() const noexcept
+        {
+            return m_operations.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_operations.empty();
+        }
+
+        //! Drop pending operations, statistics are kept.
+        void clear()
+        {
+            m_operations.clear();
+            m_index.clear();
+        }
+
+        const MessagePostStats& stats() const noexcept
+        {
+            return m_stats;
+        }
+
+        void resetStats() noexcept
+        {
+            m_stats=MessagePostStats{};
+            m_stats.maxPending=m_operations.size();
+        }
+
+    private:
+
+        Operation& operation(const IdT& id)
+        {
+            m_stats.posted++;
+
+            auto it=m_index.find(id);
+            if (it!=m_index.end())
+            {
+                m_stats.coalesced++;
+                return *it->second;
+            }
+
+            m_operations.push_back(Operation{id,std::nullopt,false,false});
+            auto opIt=std::prev(m_operations.end());
+            m_index.emplace(id,opIt);
+            m_stats.maxPending=std::max(m_stats.maxPending,m_operations.size());
+            return *opIt;
+        }
+
+        std::list<Operation> m_operations;
+        std::map<IdT,typename std::list<Operation>::iterator> m_index;
+        MessagePostStats m_stats;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_MESSAGEPOSTQUEUE_HPP
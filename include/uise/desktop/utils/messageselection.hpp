@@ -0,0 +1,213 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/messageselection.hpp
+*
+*  Defines MessageSelection.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_MESSAGESELECTION_HPP
+#define UISE_DESKTOP_MESSAGESELECTION_HPP
+
+#include <optional>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Set of selected messages that does not copy data of loaded messages.
+ *
+ * A selected message is referred by pointer while it is loaded. Data of the message is copied only when
+ * the message is unloaded while it is still selected, see unload(). Selected messages are kept sorted
+ * by sort value, so they can be iterated in order without sorting.
+ *
+ * MessageT must provide data() returning DataT or a reference to it.
+ */
+template <typename IdT, typename SortValueT, typename MessageT, typename DataT>
+class MessageSelection
+{
+    public:
+
+        struct Entry
+        {
+            IdT id;
+            SortValueT sortValue;
+
+            //! Loaded message or nullptr.
+            mutable MessageT* message=nullptr;
+
+            //! Copy of data of unloaded message.
+            mutable std::optional<DataT> data;
+        };
+
+        /**
+         * @brief Select loaded message.
+         * @return True if the message was not selected before.
+         */
+        bool select(const IdT& id, const SortValueT& sortValue, MessageT* message)
+        {
+            auto& idx=m_entries.template get<ById>();
+            auto it=idx.find(id);
+            if (it!=idx.end())
+            {
+                reload(it,sortValue,message);
+                return false;
+            }
+            idx.insert(Entry{id,sortValue,message,std::nullopt});
+            return true;
+        }
+
+        /**
+         * @brief Deselect message.
+         * @return True if the message was selected.
+         */
+        bool deselect(const IdT& id)
+        {
+            return m_entries.template get<ById>().erase(id)!=0;
+        }
+
+        bool contains(const IdT& id) const
+        {
+            const auto& idx=m_entries.template get<ById>();
+            return idx.find(id)!=idx.end();
+        }
+
+        size_t size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+        }
+
+        /**
+         * @brief Keep data of selected message that is going to be unloaded.
+         * @return True if the message is selected.
+         */
+        bool unload(const IdT& id)
+        {
+            const auto& idx=m_entries.template get<ById>();
+            auto it=idx.find(id);
+            if (it==idx.end())
+            {
+                return false;
+            }
+            if (it->message!=nullptr)
+            {
+                it->data.emplace(it->message->data());
+                it->message=nullptr;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Bind selected message to its loaded instance.
+         * @return True if the message is selected.
+         */
+        bool reload(const IdT& id, const SortValueT& sortValue, MessageT* message)
+        {
+            const auto& idx=m_entries.template get<ById>();
+            auto it=idx.find(id);
+            if (it==idx.end())
+            {
+                return false;
+            }
+            reload(it,sortValue,message);
+            return true;
+        }
+
+        /**
+         * @brief Update sort value of selected message.
+         */
+        void updateSortValue(const IdT& id, const SortValueT& sortValue)
+        {
+            auto& idx=m_entries.template get<ById>();
+            auto it=idx.find(id);
+            if (it!=idx.end() && (it->sortValue<sortValue || sortValue<it->sortValue))
+            {
+                idx.modify(it,[&sortValue](Entry& entry){entry.sortValue=sortValue;});
+            }
+        }
+
+        /**
+         * @brief Iterate data of selected messages in the order of sort values.
+         * @param handler Handler invoked with data of each message, iteration stops if it returns false.
+         * @return False if iteration was stopped by the handler.
+         */
+        template <typename HandlerT>
+        bool each(HandlerT&& handler) const
+        {
+            for (const auto& entry : m_entries.template get<BySortValue>())
+            {
+                bool next=entry.message!=nullptr ? handler(entry.message->data()) : handler(entry.data.value());
+                if (!next)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+
+        struct ById{};
+        struct BySortValue{};
+
+        using Container=boost::multi_index::multi_index_container
+            <
+                Entry,
+                boost::multi_index::indexed_by<
+                    boost::multi_index::ordered_unique<
+                        boost::multi_index::tag<ById>,
+                        boost::multi_index::member<Entry,IdT,&Entry::id>
+                    >,
+                    boost::multi_index::ordered_non_unique<
+                        boost::multi_index::tag<BySortValue>,
+                        boost::multi_index::member<Entry,SortValueT,&Entry::sortValue>
+                    >
+                >
+            >;
+
+        template <typename IteratorT>
+        void reload(IteratorT it, const SortValueT& sortValue, MessageT* message)
+        {
+            it->message=message;
+            it->data.reset();
+            updateSortValue(it->id,sortValue);
+        }
+
+        Container m_entries;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_MESSAGESELECTION_HPP
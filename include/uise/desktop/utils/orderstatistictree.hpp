@@ -0,0 +1,415 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/orderstatistictree.hpp
+*
+*  Defines OrderStatisticTree.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_ORDERSTATISTICTREE_HPP
+#define UISE_DESKTOP_ORDERSTATISTICTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Sequence of values with O(log n) positional access.
+ *
+ * The order of values is defined purely by where they were inserted (insertAfter()/insertBefore()
+ * relative to an existing element), not by comparing them, i.e. this is an implicit-key treap.
+ * Every node keeps the size of its subtree, so both directions of the position mapping --
+ * rank() (handle to position) and at() (position to handle) -- cost O(log n) expected, as do
+ * insertion and removal anywhere in the sequence. Compare with keeping an explicit position in
+ * every element, where inserting or removing near the front renumbers everything that follows.
+ *
+ * Nodes live in a single vector and are linked by 32-bit indexes, so a Handle stays valid until
+ * its own element is erased or the tree is cleared, regardless of other insertions/removals.
+ * Freed slots are recycled.
+ */
+template <typename T>
+class OrderStatisticTree
+{
+    public:
+
+        using Handle=uint32_t;
+        constexpr static const Handle Null=std::numeric_limits<Handle>::max();
+
+        /**
+         * @brief Get number of values in the sequence.
+         */
+        size_t size() const noexcept
+        {
+            return m_root==Null?0:m_nodes[m_root].size;
+        }
+
+        /**
+         * @brief Check if the sequence is empty.
+         */
+        bool empty() const noexcept
+        {
+            return m_root==Null;
+        }
+
+        /**
+         * @brief Remove all values and release all handles.
+         */
+        void clear() noexcept
+        {
+            m_nodes.clear();
+            m_free.clear();
+            m_root=Null;
+        }
+
+        /**
+         * @brief Get value of a node.
+         * @param handle Handle of the node, must be valid.
+         */
+        const T& value(Handle handle) const noexcept
+        {
+            return m_nodes[handle].value;
+        }
+
+        T& value(Handle handle) noexcept
+        {
+            return m_nodes[handle].value;
+        }
+
+        /**
+         * @brief Check if a handle refers to a live node of this tree holding a value.
+         * @param handle Handle to check, may be Null or belong to another tree.
+         * @param value Expected value of the node.
+         */
+        bool contains(Handle handle, const T& value) const noexcept
+        {
+            return handle<m_nodes.size() && m_nodes[handle].size!=0 && m_nodes[handle].value==value;
+        }
+
+        /**
+         * @brief Insert a value right after an existing node.
+         * @param existing Node to insert after. If Null then the value is inserted at the front.
+         * @param value Value to insert.
+         * @return Handle of the new node.
+         */
+        Handle insertAfter(Handle existing, T value)
+        {
+            auto h=allocate(std::move(value));
+            if (m_root==Null)
+            {
+                m_root=h;
+                return h;
+            }
+
+            if (existing==Null)
+            {
+                attach(leftmost(m_root),h,true);
+            }
+            else if (m_nodes[existing].right==Null)
+            {
+                attach(existing,h,false);
+            }
+            else
+            {
+                attach(leftmost(m_nodes[existing].right),h,true);
+            }
+            return h;
+        }
+
+        /**
+         * @brief Insert a value right before an existing node.
+         * @param existing Node to insert before. If Null then the value is appended to the end.
+         * @param value Value to insert.
+         * @return Handle of the new node.
+         */
+        Handle insertBefore(Handle existing, T value)
+        {
+            auto h=allocate(std::move(value));
+            if (m_root==Null)
+            {
+                m_root=h;
+                return h;
+            }
+
+            if (existing==Null)
+            {
+                attach(rightmost(m_root),h,false);
+            }
+            else if (m_nodes[existing].left==Null)
+            {
+                attach(existing,h,true);
+            }
+            else
+            {
+                attach(rightmost(m_nodes[existing].left),h,false);
+            }
+            return h;
+        }
+
+        /**
+         * @brief Remove a node from the sequence.
+         * @param handle Node to remove. Null is ignored.
+         */
+        void erase(Handle handle)
+        {
+            if (handle==Null)
+            {
+                return;
+            }
+
+            // rotate the node down until it has at most one child, then splice it out
+            for (;;)
+            {
+                const auto& node=m_nodes[handle];
+                if (node.left==Null || node.right==Null)
+                {
+                    break;
+                }
+                if (m_nodes[node.left].priority<m_nodes[node.right].priority)
+                {
+                    rotateUp(node.left);
+                }
+                else
+                {
+                    rotateUp(node.right);
+                }
+            }
+
+            auto& node=m_nodes[handle];
+            auto child=node.left!=Null?node.left:node.right;
+            auto parent=node.parent;
+            if (child!=Null)
+            {
+                m_nodes[child].parent=parent;
+            }
+            replaceChild(parent,handle,child);
+            for (auto p=parent; p!=Null; p=m_nodes[p].parent)
+            {
+                --m_nodes[p].size;
+            }
+
+            node=Node{};
+            m_free.push_back(handle);
+        }
+
+        /**
+         * @brief Get position of a node in the sequence.
+         * @param handle Handle of the node, must be valid.
+         * @return Zero-based position.
+         */
+        size_t rank(Handle handle) const noexcept
+        {
+            size_t result=subtreeSize(m_nodes[handle].left);
+            for (auto h=handle; m_nodes[h].parent!=Null; h=m_nodes[h].parent)
+            {
+                const auto& parent=m_nodes[m_nodes[h].parent];
+                if (parent.right==h)
+                {
+                    result+=subtreeSize(parent.left)+1;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Find node at a position.
+         * @param pos Zero-based position.
+         * @return Handle of the node or Null if position is out of range.
+         */
+        Handle at(size_t pos) const noexcept
+        {
+            auto h=m_root;
+            while (h!=Null)
+            {
+                const auto& node=m_nodes[h];
+                auto leftSize=subtreeSize(node.left);
+                if (pos<leftSize)
+                {
+                    h=node.left;
+                }
+                else if (pos==leftSize)
+                {
+                    return h;
+                }
+                else
+                {
+                    pos-=leftSize+1;
+                    h=node.right;
+                }
+            }
+            return Null;
+        }
+
+    private:
+
+        struct Node
+        {
+            Handle left=Null;
+            Handle right=Null;
+            Handle parent=Null;
+            uint32_t size=0;
+            uint32_t priority=0;
+            T value{};
+        };
+
+        size_t subtreeSize(Handle h) const noexcept
+        {
+            return h==Null?0:m_nodes[h].size;
+        }
+
+        void updateSize(Handle h) noexcept
+        {
+            auto& node=m_nodes[h];
+            node.size=static_cast<uint32_t>(subtreeSize(node.left)+subtreeSize(node.right)+1);
+        }
+
+        Handle leftmost(Handle h) const noexcept
+        {
+            while (m_nodes[h].left!=Null)
+            {
+                h=m_nodes[h].left;
+            }
+            return h;
+        }
+
+        Handle rightmost(Handle h) const noexcept
+        {
+            while (m_nodes[h].right!=Null)
+            {
+                h=m_nodes[h].right;
+            }
+            return h;
+        }
+
+        uint32_t nextPriority() noexcept
+        {
+            // xorshift32, deterministic so that layouts are reproducible between runs
+            m_seed^=m_seed<<13;
+            m_seed^=m_seed>>17;
+            m_seed^=m_seed<<5;
+            return m_seed;
+        }
+
+        Handle allocate(T value)
+        {
+            Handle h;
+            if (!m_free.empty())
+            {
+                h=m_free.back();
+                m_free.pop_back();
+            }
+            else
+            {
+                h=static_cast<Handle>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+            auto& node=m_nodes[h];
+            node.size=1;
+            node.priority=nextPriority();
+            node.value=std::move(value);
+            return h;
+        }
+
+        void replaceChild(Handle parent, Handle oldChild, Handle newChild) noexcept
+        {
+            if (parent==Null)
+            {
+                m_root=newChild;
+            }
+            else if (m_nodes[parent].left==oldChild)
+            {
+                m_nodes[parent].left=newChild;
+            }
+            else
+            {
+                m_nodes[parent].right=newChild;
+            }
+        }
+
+        //! Hang leaf h as the left or right child of parent, then restore heap order by priority.
+        void attach(Handle parent, Handle h, bool asLeft)
+        {
+            if (asLeft)
+            {
+                m_nodes[parent].left=h;
+            }
+            else
+            {
+                m_nodes[parent].right=h;
+            }
+            m_nodes[h].parent=parent;
+            for (auto p=parent; p!=Null; p=m_nodes[p].parent)
+            {
+                ++m_nodes[p].size;
+            }
+
+            while (m_nodes[h].parent!=Null && m_nodes[h].priority<m_nodes[m_nodes[h].parent].priority)
+            {
+                rotateUp(h);
+            }
+        }
+
+        //! Rotate h above its parent, keeping in-order sequence and subtree sizes intact.
+        void rotateUp(Handle h) noexcept
+        {
+            auto p=m_nodes[h].parent;
+            auto g=m_nodes[p].parent;
+
+            if (m_nodes[p].left==h)
+            {
+                auto moved=m_nodes[h].right;
+                m_nodes[p].left=moved;
+                if (moved!=Null)
+                {
+                    m_nodes[moved].parent=p;
+                }
+                m_nodes[h].right=p;
+            }
+            else
+            {
+                auto moved=m_nodes[h].left;
+                m_nodes[p].right=moved;
+                if (moved!=Null)
+                {
+                    m_nodes[moved].parent=p;
+                }
+                m_nodes[h].left=p;
+            }
+            m_nodes[p].parent=h;
+            m_nodes[h].parent=g;
+            replaceChild(g,p,h);
+
+            updateSize(p);
+            updateSize(h);
+        }
+
+        std::vector<Node> m_nodes;
+        std::vector<Handle> m_free;
+        Handle m_root=Null;
+        uint32_t m_seed=2463534242u;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_ORDERSTATISTICTREE_HPP
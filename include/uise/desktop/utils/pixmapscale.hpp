@@ -20,6 +20,8 @@ You may select, at your option, one of the above-listed licenses.
 *  Declares scaledAndCropped(), scaledToFit() and scaledToFitPadded() - the
 *  aspect-ratio policies used to fit a source pixmap into a target box, shared
 *  by every preview/thumbnail widget instead of each call site scaling ad hoc.
+*  Downscaling goes through areaScaledOnCanvas(), an area-averaging kernel that crops and pads in
+*  the same pass. Also defines ImageMipChain used for downscaling one image to several sizes.
 *
 */
 
@@ -28,15 +30,106 @@ You may select, at your option, one of the above-listed licenses.
 #ifndef UISE_DESKTOP_PIXMAPSCALE_HPP
 #define UISE_DESKTOP_PIXMAPSCALE_HPP
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <QPixmap>
+#include <QImage>
 #include <QSize>
 #include <QRect>
 #include <QPainter>
 
 #include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/utils/areascale.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
 
+/**
+ * @brief Convert an image to the format used for scaling, Format_ARGB32_Premultiplied or Format_RGB32.
+ */
+inline QImage areaScaleFormat(const QImage& image)
+{
+    auto format=image.hasAlphaChannel()?QImage::Format_ARGB32_Premultiplied:QImage::Format_RGB32;
+    return image.format()==format?image:image.convertToFormat(format);
+}
+
+/**
+ * @brief Downscale a part of an image by area averaging and place it onto a transparent canvas.
+ * @param src Source image.
+ * @param srcRect Part of the source to scale, in source pixels, may be fractional.
+ * @param canvasSize Size of the result.
+ * @param targetRect Rectangle of the canvas the part is scaled to, must be inside the canvas.
+ * @return Image of canvasSize, transparent outside targetRect. The format is the source format if
+ *  targetRect covers the whole canvas and Format_ARGB32_Premultiplied otherwise.
+ *
+ * Crop, scaling and padding are done in a single pass over the pixels: only the source pixels inside
+ * srcRect are read and each pixel of the canvas is written once. Use it for downscaling only, when
+ * enlarging it degrades to nearest-neighbour sampling.
+ */
+inline QImage areaScaledOnCanvas(const QImage& src, const QRectF& srcRect, const QSize& canvasSize, const QRect& targetRect)
+{
+    if (src.isNull() || canvasSize.isEmpty() || !QRect(QPoint(0,0),canvasSize).contains(targetRect))
+    {
+        return QImage{};
+    }
+
+    auto img=areaScaleFormat(src);
+    bool padded=targetRect.size()!=canvasSize;
+    QImage canvas{canvasSize,padded?QImage::Format_ARGB32_Premultiplied:img.format()};
+    if (canvas.isNull())
+    {
+        return canvas;
+    }
+    canvas.setDevicePixelRatio(src.devicePixelRatio());
+
+    if (padded)
+    {
+        auto lineBytes=static_cast<size_t>(canvas.bytesPerLine());
+        for (int y=0;y<canvas.height();y++)
+        {
+            auto line=canvas.scanLine(y);
+            if (y<targetRect.top() || y>targetRect.bottom())
+            {
+                std::memset(line,0,lineBytes);
+                continue;
+            }
+            std::memset(line,0,static_cast<size_t>(targetRect.left())*4);
+            std::memset(line+static_cast<size_t>(targetRect.right()+1)*4,0,
+                        static_cast<size_t>(canvas.width()-targetRect.right()-1)*4);
+        }
+    }
+
+    if (!targetRect.isEmpty())
+    {
+        // opaque pixels stay opaque on a canvas with alpha channel
+        std::uint32_t orMask=(!img.hasAlphaChannel() && canvas.hasAlphaChannel()) ? 0xff000000u : 0u;
+        areaScale32(img.constBits(),img.bytesPerLine(),img.width(),img.height(),
+                    AreaScaleRect{srcRect.x(),srcRect.y(),srcRect.width(),srcRect.height()},
+                    canvas.bits()+targetRect.y()*canvas.bytesPerLine()+targetRect.x()*4,canvas.bytesPerLine(),
+                    targetRect.width(),targetRect.height(),
+                    orMask);
+    }
+    return canvas;
+}
+
+/**
+ * @brief Downscale an image by area averaging.
+ * @param src Source image.
+ * @param size Size of the result.
+ * @param srcRect Part of the source to scale, the whole image if null.
+ */
+inline QImage areaScaledImage(const QImage& src, const QSize& size, const QRectF& srcRect=QRectF())
+{
+    return areaScaledOnCanvas(src,srcRect.isNull()?QRectF(src.rect()):srcRect,size,QRect(QPoint(0,0),size));
+}
+
+//! Check if scaling from one size to another does not enlarge any dimension, so area averaging applies.
+inline bool isDownscale(const QSize& from, const QSize& to)
+{
+    return !to.isEmpty() && to.width()<=from.width() && to.height()<=from.height();
+}
+
 /**
  * @brief Scale a pixmap to COVER a box and centre-crop the overflow, so the result is exactly
  *  targetSize regardless of the source's aspect ratio.
@@ -59,14 +152,29 @@ UISE_DESKTOP_NAMESPACE_BEGIN
  */
 inline QPixmap scaledAndCropped(const QPixmap& src, const QSize& targetSize)
 {
-    auto scaled=src.scaled(targetSize,Qt::KeepAspectRatioByExpanding,Qt::SmoothTransformation);
-    QRect cropRect(
-        (scaled.width()-targetSize.width())/2,
-        (scaled.height()-targetSize.height())/2,
-        targetSize.width(),
-        targetSize.height()
+    auto scaledSize=src.size().scaled(targetSize,Qt::KeepAspectRatioByExpanding);
+    if (src.isNull() || targetSize.isEmpty() || !isDownscale(src.size(),scaledSize))
+    {
+        auto scaled=src.scaled(targetSize,Qt::KeepAspectRatioByExpanding,Qt::SmoothTransformation);
+        QRect cropRect(
+            (scaled.width()-targetSize.width())/2,
+            (scaled.height()-targetSize.height())/2,
+            targetSize.width(),
+            targetSize.height()
+        );
+        return scaled.copy(cropRect);
+    }
+
+    // the crop is mapped back to the source, so the overflow is never scaled
+    auto fx=static_cast<qreal>(src.width())/scaledSize.width();
+    auto fy=static_cast<qreal>(src.height())/scaledSize.height();
+    QRectF srcRect(
+        ((scaledSize.width()-targetSize.width())/2)*fx,
+        ((scaledSize.height()-targetSize.height())/2)*fy,
+        targetSize.width()*fx,
+        targetSize.height()*fy
     );
-    return scaled.copy(cropRect);
+    return QPixmap::fromImage(areaScaledImage(src.toImage(),targetSize,srcRect));
 }
 
 /**
@@ -101,17 +209,33 @@ inline QPixmap scaledAndCropped(const QPixmap& src, const QSize& targetSize)
  *  contentSize defaults to the source's own size). Used for previews whose true aspect ratio
  *  should be visible (e.g. the file-upload dialog's big image preview).
  */
+inline QSize scaledToFitSize(const QSize& srcSize, const QSize& boxSize, const QSize& contentSize=QSize(), qreal maxUpscale=1.0);
+
 inline QPixmap scaledToFit(const QPixmap& src, const QSize& boxSize, const QSize& contentSize=QSize(), qreal maxUpscale=1.0)
 {
-    // Never upscale beyond the ORIGINAL image's own size, times maxUpscale (this function's own
-    // documented contract above) -- clamp the scale target to boxSize on each axis. When src
-    // already fits and is itself the original, target equals src.size() and scaled() below is a
-    // same-size no-op; deliberately still routed through scaled() rather than returning src
-    // directly, so every result -- shrunk, enlarged or unchanged -- is a freshly produced QPixmap
-    // via the identical path a RoundedImage brush-texture paint (roundedimage.cpp) has always
-    // received here, rather than the caller's original QPixmap object (which callers may go on to
-    // mutate/reuse, e.g. FileUploadItem::image() callers).
-    const QSize nat=(contentSize.isValid() && !contentSize.isEmpty()) ? contentSize : src.size();
+    // A downscale goes through the area-averaging kernel, anything else through Qt's smooth scaler.
+    // When src already fits and is itself the original, the size equals src.size() and scaled()
+    // below is a same-size no-op; deliberately still routed through scaled() rather than returning
+    // src directly, so every result -- shrunk, enlarged or unchanged -- is produced via the identical
+    // path a RoundedImage brush-texture paint (roundedimage.cpp) has always received here, rather
+    // than the caller's original QPixmap object (which callers may go on to mutate/reuse, e.g.
+    // FileUploadItem::image() callers).
+    auto size=scaledToFitSize(src.size(),boxSize,contentSize,maxUpscale);
+    if (!src.isNull() && size!=src.size() && isDownscale(src.size(),size))
+    {
+        return QPixmap::fromImage(areaScaledImage(src.toImage(),size));
+    }
+    return src.scaled(size,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+}
+
+/**
+ * @brief Get size of the pixmap scaledToFit() returns for the same arguments.
+ */
+inline QSize scaledToFitSize(const QSize& srcSize, const QSize& boxSize, const QSize& contentSize, qreal maxUpscale)
+{
+    // Never upscale beyond the ORIGINAL image's own size, times maxUpscale (scaledToFit()'s own
+    // documented contract) -- clamp the scale target to boxSize on each axis.
+    const QSize nat=(contentSize.isValid() && !contentSize.isEmpty()) ? contentSize : srcSize;
     const QSize limit=(maxUpscale>1.0)
         ? QSize(qRound(nat.width()*maxUpscale),qRound(nat.height()*maxUpscale))
         : nat;
@@ -119,7 +243,9 @@ inline QPixmap scaledToFit(const QPixmap& src, const QSize& boxSize, const QSize
         qMin(limit.width(),boxSize.width()),
         qMin(limit.height(),boxSize.height())
     );
-    return src.scaled(target,Qt::KeepAspectRatio,Qt::SmoothTransformation);
+    // QPixmap::scaled() never returns an empty pixmap for a non-empty source
+    auto size=srcSize.scaled(target,Qt::KeepAspectRatio);
+    return QSize(qMax(size.width(),1),qMax(size.height(),1));
 }
 
 /**
@@ -151,6 +277,19 @@ inline QPixmap scaledToFit(const QPixmap& src, const QSize& boxSize, const QSize
  */
 inline QPixmap scaledToFitPadded(const QPixmap& src, const QSize& targetSize, const QSize& contentSize=QSize(), qreal maxUpscale=1.0)
 {
+    if (!src.isNull() && targetSize.width()>0 && targetSize.height()>0)
+    {
+        auto fittedSize=scaledToFitSize(src.size(),targetSize,contentSize,maxUpscale);
+        QRect fittedRect(QPoint(0,0),fittedSize);
+        fittedRect.moveCenter(QRect(QPoint(0,0),targetSize).center());
+        if (isDownscale(src.size(),fittedSize) && QRect(QPoint(0,0),targetSize).contains(fittedRect))
+        {
+            // scaled straight into the canvas, without an intermediate pixmap and a painter composite
+            auto image=src.toImage();
+            return QPixmap::fromImage(areaScaledOnCanvas(image,QRectF(image.rect()),targetSize,fittedRect));
+        }
+    }
+
     QPixmap canvas(targetSize);
     canvas.fill(Qt::transparent);
     if (src.isNull() || targetSize.width()<=0 || targetSize.height()<=0)
@@ -169,6 +308,114 @@ inline QPixmap scaledToFitPadded(const QPixmap& src, const QSize& targetSize, co
     return canvas;
 }
 
+/**
+ * @brief Downscale an image to half of its size with a box filter.
+ */
+inline QImage halvedImage(const QImage& src)
+{
+    return areaScaledImage(src,QSize(std::max(1,src.width()/2),std::max(1,src.height()/2)));
+}
+
+/**
+ * @brief Chain of images each half the size of the previous one, starting from the original image.
+ *
+ * A large image is downscaled to a small size by taking the smallest level that is still not smaller than
+ * the target size and applying a single smooth scaling step to it, that is much cheaper than smooth scaling of
+ * the original image. Levels are built down to the smallest size the chain is constructed for.
+ *
+ * Const methods can be used in multiple threads.
+ */
+class ImageMipChain
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param image Original image.
+         * @param minSize Smallest size that will be requested, the chain is not built below it.
+         */
+        ImageMipChain(const QImage& image, const QSize& minSize)
+        {
+            m_levels.push_back(areaScaleFormat(image));
+            if (!minSize.isValid())
+            {
+                return;
+            }
+            for (;;)
+            {
+                const auto& last=m_levels.back();
+                if (last.width()/2<minSize.width() || last.height()/2<minSize.height())
+                {
+                    break;
+                }
+                m_levels.push_back(halvedImage(last));
+            }
+        }
+
+        const QImage& original() const noexcept
+        {
+            return m_levels.front();
+        }
+
+        size_t levelCount() const noexcept
+        {
+            return m_levels.size();
+        }
+
+        /**
+         * @brief Get size of the original image scaled to the target.
+         */
+        QSize scaledSize(const QSize& size, Qt::AspectRatioMode mode=Qt::KeepAspectRatio) const
+        {
+            return original().size().scaled(size,mode);
+        }
+
+        /**
+         * @brief Get the smallest level not smaller than the size.
+         */
+        const QImage& level(const QSize& size) const
+        {
+            for (auto it=m_levels.rbegin();it!=m_levels.rend();++it)
+            {
+                if (it->width()>=size.width() && it->height()>=size.height())
+                {
+                    return *it;
+                }
+            }
+            return original();
+        }
+
+        /**
+         * @brief Scale the image to the size.
+         * @param size Target size.
+         * @param mode Aspect ratio mode.
+         */
+        QImage scaled(const QSize& size, Qt::AspectRatioMode mode=Qt::KeepAspectRatio) const
+        {
+            return scaledLevel(level(scaledSize(size,mode)),scaledSize(size,mode));
+        }
+
+        /**
+         * @brief Scale a level to the final size.
+         */
+        static QImage scaledLevel(const QImage& level, const QSize& finalSize)
+        {
+            if (level.size()==finalSize)
+            {
+                return level;
+            }
+            if (isDownscale(level.size(),finalSize))
+            {
+                return areaScaledImage(level,finalSize);
+            }
+            return level.scaled(finalSize,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+        }
+
+    private:
+
+        std::vector<QImage> m_levels;
+};
+
 UISE_DESKTOP_NAMESPACE_END
 
 #endif // UISE_DESKTOP_PIXMAPSCALE_HPP
@@ -0,0 +1,252 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/prefetchpolicy.hpp
+*
+*  Defines PrefetchPolicy.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_PREFETCHPOLICY_HPP
+#define UISE_DESKTOP_PREFETCHPOLICY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+#include <uise/desktop/uisedesktop.hpp>
+#include <uise/desktop/utils/enums.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Adaptive policy of prefetching items beyond the edges of the viewport.
+ *
+ * The policy measures scroll velocity and latency of the backend, i.e. time between requesting items
+ * and receiving them. Window of prefetched items is measured in screens. When the list is idle the window
+ * is the same in both directions. When the list is scrolled the window in the direction of travel is widened
+ * to cover the distance scrolled while the request is in flight, and the trailing window is shrunk.
+ *
+ * Time values are in milliseconds, distances are in screens, positive distances are towards Direction::END.
+ */
+class PrefetchPolicy
+{
+    public:
+
+        constexpr static const double DefaultBaseScreens=2.0;
+        constexpr static const double DefaultMaxScreens=10.0;
+        constexpr static const double DefaultMinTrailingScreens=0.5;
+        constexpr static const double DefaultLatency=100.0;
+        constexpr static const double IdleTimeout=200.0;
+        //! Pending request older than this is treated as lost and is not accounted in latency.
+        constexpr static const double RequestTimeout=5000.0;
+
+        //! Window in screens in both directions when the list is idle.
+        void setBaseScreens(double value) noexcept
+        {
+            m_baseScreens=std::max(value,0.0);
+        }
+
+        double baseScreens() const noexcept
+        {
+            return m_baseScreens;
+        }
+
+        //! Upper limit of window in the direction of travel.
+        void setMaxScreens(double value) noexcept
+        {
+            m_maxScreens=std::max(value,0.0);
+        }
+
+        double maxScreens() const noexcept
+        {
+            return m_maxScreens;
+        }
+
+        //! Lower limit of window behind the direction of travel.
+        void setMinTrailingScreens(double value) noexcept
+        {
+            m_minTrailingScreens=std::max(value,0.0);
+        }
+
+        double minTrailingScreens() const noexcept
+        {
+            return m_minTrailingScreens;
+        }
+
+        /**
+         * @brief Account scrolling of the list.
+         * @param distance Scrolled distance.
+         * @param timestamp Time of scrolling.
+         */
+        void scrolled(double distance, double timestamp) noexcept
+        {
+            auto elapsed=timestamp-m_lastScrollTime;
+            if (!m_scrolled || elapsed>IdleTimeout || elapsed<0.0)
+            {
+                // the first step after idle is accounted as if it took the whole idle timeout
+                m_velocity=distance/IdleTimeout;
+            }
+            else
+            {
+                auto sample=distance/std::max(elapsed,1.0);
+                m_velocity=0.5*sample+0.5*m_velocity;
+            }
+            m_scrolled=true;
+            m_lastScrollTime=timestamp;
+        }
+
+        /**
+         * @brief Get scroll velocity in screens per millisecond.
+         * @param timestamp Current time.
+         */
+        double velocity(double timestamp) const noexcept
+        {
+            if (!m_scrolled || (timestamp-m_lastScrollTime)>IdleTimeout)
+            {
+                return 0.0;
+            }
+            return m_velocity;
+        }
+
+        /**
+         * @brief Account request of items sent to the backend.
+         *
+         * Repeated requests before response keep the time of the first one unless it is older than RequestTimeout.
+         */
+        void requestStarted(Direction direction, double timestamp) noexcept
+        {
+            auto& pending=pendingRequest(direction);
+            if (!pending || isStale(pending.value(),timestamp))
+            {
+                pending=timestamp;
+            }
+        }
+
+        /**
+         * @brief Forget pending request without accounting its latency.
+         *
+         * Call it when the backend responds with no items or the request is dropped.
+         */
+        void requestCancelled(Direction direction) noexcept
+        {
+            pendingRequest(direction).reset();
+        }
+
+        /**
+         * @brief Account items received from the backend.
+         */
+        void requestFinished(Direction direction, double timestamp) noexcept
+        {
+            auto& pending=pendingRequest(direction);
+            if (!pending)
+            {
+                return;
+            }
+
+            auto sample=std::max(timestamp-pending.value(),0.0);
+            pending.reset();
+            if (sample>RequestTimeout)
+            {
+                return;
+            }
+            if (!m_hasLatency)
+            {
+                m_latency=sample;
+                m_hasLatency=true;
+            }
+            else
+            {
+                m_latency=0.7*m_latency+0.3*sample;
+            }
+        }
+
+        /**
+         * @brief Get running average latency of the backend.
+         */
+        double latency() const noexcept
+        {
+            return m_hasLatency?m_latency:DefaultLatency;
+        }
+
+        /**
+         * @brief Get window to prefetch in given direction.
+         * @param direction Direction.
+         * @param timestamp Current time.
+         * @return Window in screens.
+         */
+        double screens(Direction direction, double timestamp) const noexcept
+        {
+            auto v=velocity(timestamp);
+            if (direction==Direction::HOME)
+            {
+                v=-v;
+            }
+
+            // twice the distance scrolled during the round trip to the backend so that the
+            // next request is sent before the previous window is exhausted
+            auto travel=std::abs(v)*latency()*2.0;
+            if (v>0.0)
+            {
+                return std::max(m_baseScreens,std::min(m_baseScreens+travel,m_maxScreens));
+            }
+            if (v<0.0)
+            {
+                return std::min(m_baseScreens,std::max(m_baseScreens-travel,m_minTrailingScreens));
+            }
+            return m_baseScreens;
+        }
+
+        void reset() noexcept
+        {
+            m_scrolled=false;
+            m_velocity=0.0;
+            m_pendingHome.reset();
+            m_pendingEnd.reset();
+        }
+
+    private:
+
+        static bool isStale(double started, double timestamp) noexcept
+        {
+            return (timestamp-started)>RequestTimeout;
+        }
+
+        std::optional<double>& pendingRequest(Direction direction) noexcept
+        {
+            return direction==Direction::HOME?m_pendingHome:m_pendingEnd;
+        }
+
+        double m_baseScreens=DefaultBaseScreens;
+        double m_maxScreens=DefaultMaxScreens;
+        double m_minTrailingScreens=DefaultMinTrailingScreens;
+
+        bool m_scrolled=false;
+        double m_lastScrollTime=0.0;
+        double m_velocity=0.0;
+
+        bool m_hasLatency=false;
+        double m_latency=0.0;
+        std::optional<double> m_pendingHome;
+        std::optional<double> m_pendingEnd;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_PREFETCHPOLICY_HPP
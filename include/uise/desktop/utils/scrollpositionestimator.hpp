@@ -0,0 +1,197 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/scrollpositionestimator.hpp
+*
+*  Defines ScrollPositionEstimator.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_SCROLLPOSITIONESTIMATOR_HPP
+#define UISE_DESKTOP_SCROLLPOSITIONESTIMATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Estimator of scroll positions in a list of items of variable extent where only a window of items is loaded.
+ *
+ * Total extent of the list is estimated as the known total number of items multiplied by the running
+ * average extent of the items measured so far. The average is refined every time a new loaded window is measured.
+ * Samples are weighted by the number of items in them, the accumulated weight is capped with maxSampleWeight()
+ * so that the average keeps following the items seen recently.
+ */
+class ScrollPositionEstimator
+{
+    public:
+
+        constexpr static const double DefaultItemExtent=50.0;
+        constexpr static const size_t DefaultMaxSampleWeight=1000;
+
+        /**
+         * @brief Set total number of items in the list including items that are not loaded.
+         * @param count Number of items, 0 disables estimation.
+         */
+        void setTotalCount(size_t count) noexcept
+        {
+            m_totalCount=count;
+        }
+
+        size_t totalCount() const noexcept
+        {
+            return m_totalCount;
+        }
+
+        bool isEnabled() const noexcept
+        {
+            return m_totalCount!=0;
+        }
+
+        /**
+         * @brief Set extent of item used until the first window is measured.
+         */
+        void setDefaultItemExtent(double value) noexcept
+        {
+            m_defaultItemExtent=std::max(value,1.0);
+        }
+
+        double defaultItemExtent() const noexcept
+        {
+            return m_defaultItemExtent;
+        }
+
+        void setMaxSampleWeight(size_t value) noexcept
+        {
+            m_maxSampleWeight=std::max(value,size_t(1));
+        }
+
+        size_t maxSampleWeight() const noexcept
+        {
+            return m_maxSampleWeight;
+        }
+
+        /**
+         * @brief Account measured window of loaded items.
+         * @param count Number of items in the window.
+         * @param extent Sum of extents of the items.
+         * @return True if the average was updated.
+         *
+         * The same window reported several times in a row is accounted only once.
+         */
+        bool measureWindow(size_t count, double extent) noexcept
+        {
+            if (count==0 || extent<=0.0 || (count==m_lastCount && extent==m_lastExtent))
+            {
+                return false;
+            }
+            m_lastCount=count;
+            m_lastExtent=extent;
+
+            auto sample=extent/static_cast<double>(count);
+            if (m_weight==0)
+            {
+                m_average=sample;
+            }
+            else
+            {
+                m_average+=(sample-m_average)*static_cast<double>(count)/static_cast<double>(m_weight+count);
+            }
+            m_weight=std::min(m_weight+count,m_maxSampleWeight);
+            return true;
+        }
+
+        /**
+         * @brief Get running average extent of an item.
+         */
+        double averageItemExtent() const noexcept
+        {
+            return m_weight==0?m_defaultItemExtent:m_average;
+        }
+
+        /**
+         * @brief Forget all measured samples.
+         */
+        void reset() noexcept
+        {
+            m_weight=0;
+            m_average=0.0;
+            m_lastCount=0;
+            m_lastExtent=0.0;
+        }
+
+        /**
+         * @brief Get estimated extent of all items.
+         */
+        int totalExtent() const noexcept
+        {
+            return clamp(static_cast<double>(m_totalCount)*averageItemExtent());
+        }
+
+        /**
+         * @brief Get estimated scroll position.
+         * @param itemIndex Index of item in the whole list.
+         * @param offset Offset relative to beginning of the item.
+         */
+        int position(size_t itemIndex, int offset=0) const noexcept
+        {
+            return clamp(static_cast<double>(itemIndex)*averageItemExtent()+offset);
+        }
+
+        /**
+         * @brief Get index of item at estimated scroll position.
+         * @param position Scroll position.
+         * @return Index of item in the whole list, always less than totalCount() unless the list is empty.
+         */
+        size_t itemIndex(int position) const noexcept
+        {
+            if (m_totalCount==0 || position<=0)
+            {
+                return 0;
+            }
+            auto index=static_cast<size_t>(std::floor(static_cast<double>(position)/averageItemExtent()));
+            return std::min(index,m_totalCount-1);
+        }
+
+    private:
+
+        static int clamp(double value) noexcept
+        {
+            return static_cast<int>(std::min(std::max(value,0.0),static_cast<double>(std::numeric_limits<int>::max())));
+        }
+
+        size_t m_totalCount=0;
+        double m_defaultItemExtent=DefaultItemExtent;
+        size_t m_maxSampleWeight=DefaultMaxSampleWeight;
+
+        double m_average=0.0;
+        size_t m_weight=0;
+
+        size_t m_lastCount=0;
+        double m_lastExtent=0.0;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_SCROLLPOSITIONESTIMATOR_HPP
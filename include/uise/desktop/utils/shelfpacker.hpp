@@ -0,0 +1,247 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/shelfpacker.hpp
+*
+*  Defines ShelfPacker.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_SHELFPACKER_HPP
+#define UISE_DESKTOP_SHELFPACKER_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Position of a rectangle allocated by ShelfPacker.
+ */
+struct ShelfPackerAllocation
+{
+    int page=-1;
+    int x=0;
+    int y=0;
+
+    bool isValid() const noexcept
+    {
+        return page>=0;
+    }
+};
+
+/**
+ * @brief Packer of rectangles into pages using shelves.
+ *
+ * A page is split into horizontal shelves, each shelf is filled from left to right with rectangles not higher
+ * than the shelf. A rectangle goes to the shelf with the least height that fits it, a new shelf is opened
+ * if existing shelves are much higher than the rectangle, a new page is opened if no page has space for a new shelf.
+ * That suits sets of a few distinct heights, like icons of standard sizes.
+ *
+ * Space of a single released rectangle is not reused, a page is reset and reused as a whole
+ * when all its rectangles are released.
+ */
+class ShelfPacker
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param pageWidth Width of a page.
+         * @param pageHeight Height of a page.
+         * @param padding Gap between rectangles.
+         */
+        ShelfPacker(int pageWidth, int pageHeight, int padding=0)
+            : m_pageWidth(pageWidth),
+              m_pageHeight(pageHeight),
+              m_padding(padding)
+        {}
+
+        int pageWidth() const noexcept
+        {
+            return m_pageWidth;
+        }
+
+        int pageHeight() const noexcept
+        {
+            return m_pageHeight;
+        }
+
+        int padding() const noexcept
+        {
+            return m_padding;
+        }
+
+        /**
+         * @brief Allocate a rectangle.
+         * @param width Width.
+         * @param height Height.
+         * @return Allocation, invalid if the rectangle is empty or does not fit a page.
+         */
+        ShelfPackerAllocation allocate(int width, int height)
+        {
+            if (width<=0 || height<=0 || width>m_pageWidth || height>m_pageHeight)
+            {
+                return ShelfPackerAllocation{};
+            }
+            auto w=std::min(width+m_padding,m_pageWidth);
+            auto h=std::min(height+m_padding,m_pageHeight);
+
+            // the lowest shelf with space for the rectangle
+            Shelf* best=nullptr;
+            for (auto& shelf : m_shelves)
+            {
+                if (shelf.height>=h && m_pageWidth-shelf.used>=w
+                    && (best==nullptr || shelf.height<best->height))
+                {
+                    best=&shelf;
+                }
+            }
+            if (best!=nullptr && best->height-h<=maxWaste(h))
+            {
+                return place(*best,w);
+            }
+
+            // new shelf on a page with space left
+            for (size_t page=0;page<m_pageHeights.size();page++)
+            {
+                if (m_pageHeight-m_pageHeights[page]>=h)
+                {
+                    return place(addShelf(static_cast<int>(page),h),w);
+                }
+            }
+
+            // too high shelf is better than a new page
+            if (best!=nullptr)
+            {
+                return place(*best,w);
+            }
+
+            m_pageHeights.push_back(0);
+            m_pageCounts.push_back(0);
+            return place(addShelf(static_cast<int>(m_pageHeights.size()-1),h),w);
+        }
+
+        //! Number of pages.
+        int pageCount() const noexcept
+        {
+            return static_cast<int>(m_pageHeights.size());
+        }
+
+        //! Number of allocated rectangles.
+        size_t count() const noexcept
+        {
+            return m_count;
+        }
+
+        //! Number of rectangles allocated in a page.
+        size_t count(int page) const noexcept
+        {
+            if (page<0 || page>=pageCount())
+            {
+                return 0;
+            }
+            return m_pageCounts[page];
+        }
+
+        /**
+         * @brief Release a rectangle.
+         * @param allocation Allocation of the rectangle.
+         * @return True if it was the last rectangle of the page and the page is empty now.
+         */
+        bool release(const ShelfPackerAllocation& allocation)
+        {
+            auto page=allocation.page;
+            if (count(page)==0)
+            {
+                return false;
+            }
+            m_count--;
+            if (--m_pageCounts[page]!=0)
+            {
+                return false;
+            }
+
+            // page is kept, so allocations in other pages stay as they are
+            m_shelves.erase(std::remove_if(m_shelves.begin(),m_shelves.end(),
+                [page](const Shelf& shelf)
+                {
+                    return shelf.page==page;
+                }),
+                m_shelves.end()
+            );
+            m_pageHeights[page]=0;
+            return true;
+        }
+
+        //! Remove all allocations and pages.
+        void clear()
+        {
+            m_shelves.clear();
+            m_pageHeights.clear();
+            m_pageCounts.clear();
+            m_count=0;
+        }
+
+    private:
+
+        struct Shelf
+        {
+            int page;
+            int y;
+            int height;
+            int used;
+        };
+
+        static int maxWaste(int height) noexcept
+        {
+            return std::max(2,height/4);
+        }
+
+        Shelf& addShelf(int page, int height)
+        {
+            m_shelves.push_back(Shelf{page,m_pageHeights[page],height,0});
+            m_pageHeights[page]+=height;
+            return m_shelves.back();
+        }
+
+        ShelfPackerAllocation place(Shelf& shelf, int width)
+        {
+            ShelfPackerAllocation allocation{shelf.page,shelf.used,shelf.y};
+            shelf.used+=width;
+            m_pageCounts[shelf.page]++;
+            m_count++;
+            return allocation;
+        }
+
+        int m_pageWidth;
+        int m_pageHeight;
+        int m_padding;
+
+        std::vector<Shelf> m_shelves;
+        std::vector<int> m_pageHeights;
+        std::vector<size_t> m_pageCounts;
+        size_t m_count=0;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_SHELFPACKER_HPP
@@ -0,0 +1,130 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/utils/widthbucketcache.hpp
+*
+*  Defines WidthBucketCache.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef UISE_DESKTOP_WIDTHBUCKETCACHE_HPP
+#define UISE_DESKTOP_WIDTHBUCKETCACHE_HPP
+
+#include <array>
+#include <optional>
+
+#include <uise/desktop/uisedesktop.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+/**
+ * @brief Small cache of layout results keyed by available width.
+ *
+ * Widths are grouped into buckets of BucketWidth pixels so that results evaluated for a width
+ * can be replayed for nearby widths, e.g. while a splitter is being dragged. A replayed result is
+ * an approximation and must be refined for the exact width later.
+ *
+ * The cache holds up to Capacity buckets, the oldest bucket is replaced when the cache is full.
+ */
+template <typename ValueT, int BucketWidth=16, size_t Capacity=4>
+class WidthBucketCache
+{
+    public:
+
+        static_assert(BucketWidth>0,"Bucket width must be positive");
+        static_assert(Capacity>0,"Capacity must be positive");
+
+        /**
+         * @brief Get bucket of the width.
+         */
+        constexpr static int bucket(int width) noexcept
+        {
+            return width>=0 ? width/BucketWidth : -((-width+BucketWidth-1)/BucketWidth);
+        }
+
+        /**
+         * @brief Find value evaluated for a width in the same bucket.
+         */
+        std::optional<ValueT> find(int width) const
+        {
+            auto b=bucket(width);
+            for (const auto& entry : m_entries)
+            {
+                if (entry && entry->bucket==b)
+                {
+                    return entry->value;
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Store value evaluated for the width.
+         */
+        void store(int width, ValueT value)
+        {
+            auto b=bucket(width);
+            for (auto& entry : m_entries)
+            {
+                if (entry && entry->bucket==b)
+                {
+                    entry->value=std::move(value);
+                    return;
+                }
+            }
+            m_entries[m_next]=Entry{b,std::move(value)};
+            m_next=(m_next+1)%Capacity;
+        }
+
+        void clear()
+        {
+            for (auto& entry : m_entries)
+            {
+                entry.reset();
+            }
+            m_next=0;
+        }
+
+        bool isEmpty() const noexcept
+        {
+            for (const auto& entry : m_entries)
+            {
+                if (entry)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+
+        struct Entry
+        {
+            int bucket;
+            ValueT value;
+        };
+
+        std::array<std::optional<Entry>,Capacity> m_entries;
+        size_t m_next=0;
+};
+
+UISE_DESKTOP_NAMESPACE_END
+
+#endif // UISE_DESKTOP_WIDTHBUCKETCACHE_HPP
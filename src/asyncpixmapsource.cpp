@@ -0,0 +1,492 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/asyncpixmapsource.cpp
+*
+*  Defines pixmap source decoding images in worker threads.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+
+#include <QCoreApplication>
+#include <QImageReader>
+#include <QThread>
+
+#include <uise/desktop/asyncpixmapsource.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+//--------------------------------------------------------------------------
+
+struct AsyncPixmapSource::Job
+{
+    std::atomic<bool> cancelled{false};
+};
+
+//--------------------------------------------------------------------------
+
+AsyncPixmapSource::AsyncPixmapSource()
+{
+    // decoding is memory bound, a couple of threads is enough and leaves cores for the GUI thread
+    m_pool.setMaxThreadCount(std::clamp(QThread::idealThreadCount()/2,1,4));
+}
+
+//--------------------------------------------------------------------------
+
+AsyncPixmapSource::~AsyncPixmapSource()
+{
+    for (auto& running : m_running)
+    {
+        running.second.job->cancelled=true;
+    }
+    m_pool.clear();
+    m_pool.waitForDone(-1);
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::setMaxThreadCount(int count)
+{
+    m_pool.setMaxThreadCount(count);
+}
+
+//--------------------------------------------------------------------------
+
+int AsyncPixmapSource::maxThreadCount() const
+{
+    return m_pool.maxThreadCount();
+}
+
+//--------------------------------------------------------------------------
+
+bool AsyncPixmapSource::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+//--------------------------------------------------------------------------
+
+QString AsyncPixmapSource::imageFileName(const PixmapKey& key) const
+{
+    return QString::fromStdString(key.toFilePath().string());
+}
+
+//--------------------------------------------------------------------------
+
+quint64 AsyncPixmapSource::imageFingerprint(const PixmapKey& key, const QString& fileName) const
+{
+    std::ignore=key;
+    return ThumbnailDiskCache::fileFingerprint(fileName);
+}
+
+//--------------------------------------------------------------------------
+
+QImage AsyncPixmapSource::readImage(const QString& fileName, const QSize& size, Qt::AspectRatioMode mode)
+{
+    QImageReader reader(fileName);
+    reader.setAutoTransform(true);
+
+    if (size.isValid())
+    {
+        auto imageSize=reader.size();
+        if (imageSize.isValid())
+        {
+            // scaled size is applied by the decoder before the orientation transformation
+            auto targetSize=size;
+            if (reader.transformation().testFlag(QImageIOHandler::TransformationRotate90))
+            {
+                targetSize.transpose();
+            }
+            auto scaledSize=imageSize.scaled(targetSize,mode);
+            if (scaledSize.width()<imageSize.width() && scaledSize.height()<imageSize.height())
+            {
+                reader.setScaledSize(scaledSize);
+            }
+        }
+    }
+
+    return reader.read();
+}
+
+//--------------------------------------------------------------------------
+
+size_t AsyncPixmapSource::pendingCount() const noexcept
+{
+    size_t count=0;
+    for (const auto& request : m_queue)
+    {
+        count+=request.second.keys.size();
+    }
+    for (const auto& running : m_running)
+    {
+        count+=running.second.keys.size();
+    }
+    return count;
+}
+
+//--------------------------------------------------------------------------
+
+int AsyncPixmapSource::loadPriority(const PixmapKey& key) const
+{
+    if (key.data(PriorityHintKey).toString()==QLatin1String("visible"))
+    {
+        return 1;
+    }
+    auto p=producer(key);
+    if (p && p->hasVisibleConsumer())
+    {
+        return 1;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::doLoadPixmap(const PixmapKey& key)
+{
+    m_cancelledKeys.erase(key);
+
+    // key is decoded already, wait for the running job
+    auto running=m_running.find(key.toWithPath());
+    if (running!=m_running.end() && running->second.targets.find(key)!=running->second.targets.end())
+    {
+        running->second.keys.insert(key);
+        return;
+    }
+
+    removeKey(key);
+
+    if (m_diskCache && !key.isAnySize() && key.size().isValid())
+    {
+        // cached image is loaded without decoding, it is cheap enough for the GUI thread
+        auto image=m_diskCache->load(key,imageFingerprint(key,imageFileName(key)));
+        if (!image.isNull())
+        {
+            updatePixmap(key,QPixmap::fromImage(std::move(image)));
+            return;
+        }
+    }
+
+    auto& request=m_queue[key.toWithPath()];
+    request.keys.insert(key);
+    request.seq=++m_requestSeq;
+    m_rankingValid=false;
+    scheduleDispatch();
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::scheduleDispatch()
+{
+    if (m_dispatchScheduled)
+    {
+        return;
+    }
+
+    auto app=QCoreApplication::instance();
+    if (app==nullptr)
+    {
+        dispatch();
+        return;
+    }
+
+    // requests made within the same iteration of the event loop are coalesced and ordered before start
+    m_dispatchScheduled=true;
+    std::weak_ptr<PixmapSource> weakSelf=weak_from_this();
+    QMetaObject::invokeMethod(app,
+        [weakSelf]()
+        {
+            auto self=weakSelf.lock();
+            if (self)
+            {
+                auto source=static_cast<AsyncPixmapSource*>(self.get());
+                source->m_dispatchScheduled=false;
+                source->dispatch();
+            }
+        },
+        Qt::QueuedConnection
+    );
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::rankQueue()
+{
+    struct Rank
+    {
+        WithPath path;
+        int priority;
+        size_t seq;
+    };
+    std::vector<Rank> ranks;
+    ranks.reserve(m_queue.size());
+    for (const auto& request : m_queue)
+    {
+        int priority=0;
+        for (const auto& key : request.second.keys)
+        {
+            priority=std::max(priority,loadPriority(key));
+        }
+        ranks.push_back(Rank{request.first,priority,request.second.seq});
+    }
+    std::sort(ranks.begin(),ranks.end(),
+        [](const Rank& l, const Rank& r)
+        {
+            if (l.priority!=r.priority)
+            {
+                return l.priority>r.priority;
+            }
+            return l.seq>r.seq;
+        }
+    );
+
+    m_ranking.clear();
+    m_ranking.reserve(ranks.size());
+    for (auto& rank : ranks)
+    {
+        m_ranking.push_back(std::move(rank.path));
+    }
+    m_rankingValid=true;
+    m_rankingClock.start();
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::dispatch()
+{
+    auto maxRunning=static_cast<size_t>(std::max(1,m_pool.maxThreadCount()));
+    if (m_running.size()>=maxRunning || m_queue.empty())
+    {
+        return;
+    }
+
+    // visibility of consumers is queried only when the queue is ranked, not for every started request
+    if (!m_rankingValid || m_priorityRefreshInterval<=0 || m_rankingClock.hasExpired(m_priorityRefreshInterval))
+    {
+        rankQueue();
+    }
+
+    std::vector<WithPath> waiting;
+    waiting.reserve(m_ranking.size());
+    for (auto& path : m_ranking)
+    {
+        auto it=m_queue.find(path);
+        if (it==m_queue.end())
+        {
+            // started or released meanwhile
+            continue;
+        }
+        if (m_running.size()>=maxRunning || m_running.find(path)!=m_running.end())
+        {
+            // no free threads or path is being decoded at other sizes, wait for it
+            waiting.push_back(std::move(path));
+            continue;
+        }
+
+        auto keys=std::move(it->second.keys);
+        m_queue.erase(it);
+        start(path,std::move(keys));
+    }
+    m_ranking=std::move(waiting);
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::start(const WithPath& path, std::set<PixmapKey> keys)
+{
+    // decode once to the size covering all requested sizes
+    QSize decodeSize;
+    bool original=false;
+    for (const auto& key : keys)
+    {
+        if (key.isAnySize() || !key.size().isValid())
+        {
+            original=true;
+            break;
+        }
+        decodeSize=decodeSize.expandedTo(key.size());
+    }
+    if (original)
+    {
+        decodeSize=QSize{};
+    }
+
+    const auto& firstKey=*keys.begin();
+    auto fileName=imageFileName(firstKey);
+    auto diskCache=m_diskCache;
+    quint64 fingerprint=0;
+    if (diskCache)
+    {
+        fingerprint=imageFingerprint(firstKey,fileName);
+    }
+
+    auto job=std::make_shared<Job>();
+    std::vector<PixmapKey> targets{keys.begin(),keys.end()};
+    auto targetSet=keys;
+    m_running.emplace(path,Running{job,std::move(keys),std::move(targetSet)});
+
+    std::weak_ptr<PixmapSource> weakSelf=weak_from_this();
+    m_pool.start(
+        [weakSelf,path,job,targets=std::move(targets),fileName,decodeSize,mode=aspectRatioMode(),diskCache,fingerprint]()
+        {
+            if (job->cancelled)
+            {
+                return;
+            }
+
+            std::vector<std::pair<PixmapKey,QImage>> images;
+            auto image=readImage(fileName,decodeSize,mode);
+            if (!image.isNull())
+            {
+                images.reserve(targets.size());
+                for (const auto& key : targets)
+                {
+                    if (job->cancelled)
+                    {
+                        return;
+                    }
+                    if (key.isAnySize() || !key.size().isValid())
+                    {
+                        images.emplace_back(key,image);
+                        continue;
+                    }
+
+                    auto scaled=image.size()==key.size() ? image : image.scaled(key.size(),mode,Qt::SmoothTransformation);
+                    if (diskCache)
+                    {
+                        diskCache->store(key,fingerprint,scaled);
+                    }
+                    images.emplace_back(key,std::move(scaled));
+                }
+            }
+            if (job->cancelled)
+            {
+                return;
+            }
+
+            auto app=QCoreApplication::instance();
+            if (app!=nullptr)
+            {
+                QMetaObject::invokeMethod(app,
+                    [weakSelf,path,job,images=std::move(images)]()
+                    {
+                        auto self=weakSelf.lock();
+                        if (self)
+                        {
+                            static_cast<AsyncPixmapSource*>(self.get())->onImagesDecoded(path,job,images);
+                        }
+                    },
+                    Qt::QueuedConnection
+                );
+            }
+        }
+    );
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::onImagesDecoded(const WithPath& path, const std::shared_ptr<Job>& job,
+                                        const std::vector<std::pair<PixmapKey,QImage>>& images)
+{
+    auto it=m_running.find(path);
+    if (it==m_running.end() || it->second.job!=job)
+    {
+        // decoding was cancelled meanwhile
+        return;
+    }
+    auto keys=std::move(it->second.keys);
+    m_running.erase(it);
+
+    for (const auto& image : images)
+    {
+        // keys released during decoding are skipped
+        if (!image.second.isNull() && keys.find(image.first)!=keys.end())
+        {
+            updatePixmap(image.first,QPixmap::fromImage(image.second));
+        }
+    }
+
+    dispatch();
+}
+
+//--------------------------------------------------------------------------
+
+bool AsyncPixmapSource::removeKey(const PixmapKey& key)
+{
+    bool found=false;
+    const auto& path=key.toWithPath();
+
+    auto queued=m_queue.find(path);
+    if (queued!=m_queue.end() && queued->second.keys.erase(key)!=0)
+    {
+        found=true;
+        if (queued->second.keys.empty())
+        {
+            m_queue.erase(queued);
+        }
+    }
+
+    auto running=m_running.find(path);
+    if (running!=m_running.end() && running->second.keys.erase(key)!=0)
+    {
+        found=true;
+        if (running->second.keys.empty())
+        {
+            running->second.job->cancelled=true;
+            m_running.erase(running);
+            scheduleDispatch();
+        }
+    }
+
+    return found;
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::doReleaseProducer(const PixmapKey& key)
+{
+    if (removeKey(key))
+    {
+        m_cancelledKeys.insert(key);
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::doReacquireProducer(const PixmapKey& key)
+{
+    if (m_cancelledKeys.erase(key)!=0)
+    {
+        doLoadPixmap(key);
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void AsyncPixmapSource::doUnloadProducer(const PixmapKey& key)
+{
+    removeKey(key);
+    m_cancelledKeys.erase(key);
+}
+
+//--------------------------------------------------------------------------
+
+UISE_DESKTOP_NAMESPACE_END
@@ -25,10 +25,14 @@ You may select, at your option, one of the above-listed licenses.
 
 #include <algorithm>
 
+#include <QApplication>
+#include <QCursor>
 #include <QPointer>
 #include <QMouseEvent>
+#include <QEnterEvent>
 #include <QLabel>
 #include <QLocale>
+#include <QPainter>
 #include <QResizeEvent>
 
 #include <uise/desktop/style.hpp>
@@ -36,6 +40,7 @@ You may select, at your option, one of the above-listed licenses.
 #include <uise/desktop/avatar.hpp>
 #include <uise/desktop/icontextbutton.hpp>
 #include <uise/desktop/checkbox.hpp>
+#include <uise/desktop/utils/singleshottimer.hpp>
 #include <uise/desktop/chatmessage.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
@@ -51,6 +56,40 @@ constexpr int BubbleWidthSlack=10;
 //! bubbleWidthHint() widens the bubble for a too-narrow body -- see DefaultNarrowBodyWidth.
 constexpr int BottomGap=10;
 
+//! Delay after the last interaction before an idle bubble is replaced with its snapshot, see
+//! AbstractChatMessage::setPaintedWhenIdle().
+constexpr int PaintIdleDelay=500;
+
+//! Events telling that a widget of a bubble hidden behind its snapshot looks different now.
+//! Repaints of hidden widgets are dropped by Qt, so they cannot be watched.
+bool isSnapshotChange(QEvent* event, bool descendant)
+{
+    switch (event->type())
+    {
+        case QEvent::DynamicPropertyChange:
+        case QEvent::StyleChange:
+        case QEvent::PaletteChange:
+        case QEvent::FontChange:
+        case QEvent::EnabledChange:
+            return true;
+
+        // timers, animations and other helpers do not change the bubble
+        case QEvent::ChildAdded:
+        case QEvent::ChildRemoved:
+            return static_cast<QChildEvent*>(event)->child()->isWidgetType();
+
+        // the bubble itself is shown and hidden by the wrapper
+        case QEvent::ShowToParent:
+        case QEvent::HideToParent:
+        case QEvent::LayoutRequest:
+            return descendant;
+
+        default:
+            break;
+    }
+    return false;
+}
+
 } // anonymous namespace
 
 /***************************AbstractChatMessage******************************/
@@ -126,15 +165,49 @@ void AbstractChatMessageContent::updateBubbleWidth(int forMaxWidthIn)
         widthHint=forMaxWidth;
     }
 
+    m_bubbleWidthCache.store(forMaxWidthIn,widthHint);
+    m_bubbleWidthStale=false;
+
     setMaximumBubbleWidth(widthHint);
     emit bubbleWidthUpdated();
 }
 
 //--------------------------------------------------------------------------
 
+bool AbstractChatMessageContent::replayBubbleWidth(int forMaxWidthIn)
+{
+    if (!m_everNegotiated)
+    {
+        return false;
+    }
+
+    // Sections are not queried here, so the body-hint memo of the previous pass must not be
+    // reused against the new width.
+    m_lastForMaxWidth=forMaxWidthIn;
+    m_bodyWidthHintValid=false;
+    m_bubbleWidthStale=true;
+
+    auto forMaxWidth=forMaxWidthIn-horizontalTotalMargin(this)-BubbleWidthSlack;
+    auto widthHint=m_bubbleWidthCache.find(forMaxWidthIn).value_or(m_maximumBubbleWidth);
+    if (widthHint>forMaxWidth)
+    {
+        widthHint=forMaxWidth;
+    }
+
+    if (widthHint!=m_maximumBubbleWidth)
+    {
+        setMaximumBubbleWidth(widthHint);
+        emit bubbleWidthUpdated();
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------
+
 void AbstractChatMessageContent::rebuildSections()
 {
     m_sections.clear();
+    invalidateBubbleWidthCache();
 
     auto attach=[this](ChatMessageContentSection* section)
     {
@@ -163,6 +236,8 @@ void AbstractChatMessageContent::renegotiateBubbleWidth()
         // No real forMaxWidthIn to repeat yet -- see this function's own doc comment.
         return;
     }
+    // natural size of a section changed, widths negotiated for other widths are obsolete
+    invalidateBubbleWidthCache();
     updateBubbleWidth(m_lastForMaxWidth);
 }
 
@@ -601,12 +676,111 @@ void ChatMessageContentWrapper::updatePosition()
         return;
     }
 
+    // snapshot no longer matches the bubble
+    invalidateSnapshot();
+
     m_content->resize(m_content->sizeHint());
     applyContentPosition();
 }
 
 //--------------------------------------------------------------------------
 
+void ChatMessageContentWrapper::setPainted(bool enable)
+{
+    if (m_content==nullptr || m_painted==enable)
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        if (!m_content->isVisible())
+        {
+            // nothing to take snapshot of
+            return;
+        }
+        m_snapshot=m_content->grab();
+        m_painted=true;
+        m_content->hide();
+        watchContent(true);
+    }
+    else
+    {
+        watchContent(false);
+        m_painted=false;
+        m_content->show();
+        m_snapshot=QPixmap{};
+    }
+    update();
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessageContentWrapper::watchContent(bool enable)
+{
+    // the bubble itself is always filtered, see setContent()
+    const auto widgets=m_content->findChildren<QWidget*>();
+    for (auto widget : widgets)
+    {
+        if (enable)
+        {
+            widget->installEventFilter(this);
+        }
+        else
+        {
+            widget->removeEventFilter(this);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessageContentWrapper::invalidateSnapshot()
+{
+    if (m_painted)
+    {
+        // the owner decides when to take a new snapshot
+        setPainted(false);
+        emit paintedInvalidated();
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessageContentWrapper::invalidateSnapshotOf(QWidget* widget)
+{
+    // widgets of a painted bubble are hidden, visible widget is not in a painted bubble
+    if (widget==nullptr || widget->isVisible())
+    {
+        return;
+    }
+
+    for (auto w=widget->parentWidget();w!=nullptr;w=w->parentWidget())
+    {
+        auto wrapper=qobject_cast<ChatMessageContentWrapper*>(w);
+        if (wrapper!=nullptr)
+        {
+            wrapper->invalidateSnapshot();
+            return;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessageContentWrapper::paintEvent(QPaintEvent *event)
+{
+    QFrame::paintEvent(event);
+
+    if (m_painted && m_content!=nullptr)
+    {
+        QPainter painter(this);
+        painter.drawPixmap(m_content->pos(),m_snapshot);
+    }
+}
+
+//--------------------------------------------------------------------------
+
 void ChatMessageContentWrapper::applyContentPosition()
 {
     if (!m_content)
@@ -633,6 +807,16 @@ bool ChatMessageContentWrapper::eventFilter(QObject *obj, QEvent *event)
         updatePosition();
         updateGeometry();
     }
+    else if (obj == m_content && event->type() == QEvent::LayoutRequest)
+    {
+        // sections of the bubble were changed while it was hidden behind the snapshot
+        invalidateSnapshot();
+    }
+    else if (m_painted && isSnapshotChange(event,obj!=m_content))
+    {
+        // a widget of the bubble was changed while it was hidden behind the snapshot
+        invalidateSnapshot();
+    }
     return QFrame::eventFilter(obj, event);
 }
 
@@ -736,6 +920,9 @@ class ChatMessage_p
         //! Built lazily by ChatMessage::ensureSelector(), so null until multi-select mode is
         //! first entered on this message. Every read must be guarded.
         AbstractChatMessageSelector* selector=nullptr;
+
+        //! Built on first use by ChatMessage::schedulePainting().
+        SingleShotTimer* paintTimer=nullptr;
 };
 
 //--------------------------------------------------------------------------
@@ -780,6 +967,15 @@ void ChatMessage::construct()
     pimpl->avatarFramePlaceholder->setSizePolicy(QSizePolicy::Fixed,QSizePolicy::Preferred);
 
     pimpl->contentFrame=new ChatMessageContentWrapper(pimpl->main);
+    connect(
+        pimpl->contentFrame,
+        &ChatMessageContentWrapper::paintedInvalidated,
+        this,
+        [this]()
+        {
+            schedulePainting();
+        }
+    );
 
     pimpl->bottomSpace=new QFrame(this);
     pimpl->bottomSpace->setObjectName("bottomSpace");
@@ -879,6 +1075,10 @@ void ChatMessage::updateSelectionMode()
 
 void ChatMessage::updateSelection()
 {
+    // the snapshot would show the previous selection state
+    setPainted(false);
+    schedulePainting();
+
     content()->setSelected(isSelected());
     pimpl->avatarFrame->setSelected(isSelected());
 
@@ -990,6 +1190,104 @@ void ChatMessage::mousePressEvent(QMouseEvent* event)
 
 //--------------------------------------------------------------------------
 
+void ChatMessage::enterEvent(QEnterEvent* event)
+{
+    // restore the bubble before the mouse reaches its widgets
+    setPainted(false);
+    AbstractChatMessage::enterEvent(event);
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessage::leaveEvent(QEvent* event)
+{
+    AbstractChatMessage::leaveEvent(event);
+    schedulePainting();
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessage::showEvent(QShowEvent* event)
+{
+    AbstractChatMessage::showEvent(event);
+    schedulePainting();
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessage::updatePaintedWhenIdle()
+{
+    if (isPaintedWhenIdle())
+    {
+        schedulePainting();
+    }
+    else
+    {
+        if (pimpl->paintTimer!=nullptr)
+        {
+            pimpl->paintTimer->clear();
+        }
+        setPainted(false);
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessage::schedulePainting()
+{
+    if (!isPaintedWhenIdle() || pimpl->contentFrame==nullptr)
+    {
+        return;
+    }
+
+    if (pimpl->paintTimer==nullptr)
+    {
+        pimpl->paintTimer=new SingleShotTimer(this);
+    }
+    pimpl->paintTimer->shot(PaintIdleDelay,[this](){paintIfIdle();},true);
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessage::paintIfIdle()
+{
+    if (!isPaintedWhenIdle() || !isVisible() || content()==nullptr || isSelected())
+    {
+        return;
+    }
+
+    if (rect().contains(mapFromGlobal(QCursor::pos())))
+    {
+        // still hovered, try again when the mouse leaves
+        return;
+    }
+
+    auto focusWidget=QApplication::focusWidget();
+    if (focusWidget!=nullptr && content()->isAncestorOf(focusWidget))
+    {
+        return;
+    }
+
+    if (!selectedText().isEmpty())
+    {
+        return;
+    }
+
+    setPainted(true);
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessage::setPainted(bool enable)
+{
+    if (pimpl->contentFrame!=nullptr)
+    {
+        pimpl->contentFrame->setPainted(enable);
+    }
+}
+
+//--------------------------------------------------------------------------
+
 void ChatMessage::updateAvatarVisible()
 {
     pimpl->avatarFrame->avatar()->setVisible(isAvatarVisible());
@@ -1186,6 +1484,7 @@ void ChatMessageBottom::setTimeString(const QString& time, const QString& toolti
 {
     pimpl->time->setText(time);
     pimpl->time->setToolTip(tooltip);
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
 }
 
 //--------------------------------------------------------------------------
@@ -1195,6 +1494,7 @@ void ChatMessageBottom::setStatusIcon(std::shared_ptr<SvgIcon> icon, const QStri
     pimpl->status->setVisible(static_cast<bool>(icon));
     pimpl->status->image()->setSvgIcon(std::move(icon));
     pimpl->status->setToolTip(tooltip);
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
 }
 
 //--------------------------------------------------------------------------
@@ -1204,6 +1504,7 @@ void ChatMessageBottom::setEdited(const QString& text, const QString& tooltip)
     pimpl->edited->setText(text);
     pimpl->edited->setToolTip(tooltip);
     pimpl->edited->setVisible(!text.isEmpty());
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
 }
 
 //--------------------------------------------------------------------------
@@ -1213,6 +1514,7 @@ void ChatMessageBottom::setSeen(const QString& text, const QString& tooltip)
     pimpl->seen->setText(text);
     pimpl->seen->setToolTip(tooltip);
     pimpl->seen->setVisible(!text.isEmpty());
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
 }
 
 //--------------------------------------------------------------------------
@@ -36,6 +36,7 @@ You may select, at your option, one of the above-listed licenses.
 #include <uise/desktop/utils/destroywidget.hpp>
 #include <uise/desktop/utils/pixmapscale.hpp>
 #include <uise/desktop/utils/dragsource.hpp>
+#include <uise/desktop/chatmessage.hpp>
 #include <uise/desktop/chatmessageimageitem.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
@@ -508,6 +509,7 @@ void ChatMessageImageItem::updatePreview()
             pimpl->loadedPath=content.path;
             pimpl->loadedData=content.data;
             setPlaceholderMode(false);
+            ChatMessageContentWrapper::invalidateSnapshotOf(this);
             return;
         }
 
@@ -587,6 +589,7 @@ void ChatMessageImageItem::updatePreview()
         pimpl->preview->setPixmap(QPixmap());
         setPlaceholderMode(true);
     }
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
 }
 
 //--------------------------------------------------------------------------
@@ -23,7 +23,12 @@ You may select, at your option, one of the above-listed licenses.
 
 /****************************************************************************/
 
+#include <algorithm>
+#include <optional>
+
 #include <QCoreApplication>
+#include <QPointer>
+#include <QThread>
 #include <QTimer>
 #include <QWheelEvent>
 #include <QMouseEvent>
@@ -31,6 +36,7 @@ You may select, at your option, one of the above-listed licenses.
 
 #include <uise/desktop/utils/layout.hpp>
 #include <uise/desktop/style.hpp>
+#include <uise/desktop/chatmessage.hpp>
 #include <uise/desktop/chatmessagetext.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
@@ -189,6 +195,91 @@ void ChatMessageTextBrowser::showCopyMenu(const QPoint& pos)
     menu.exec(mapToGlobal(pos));
 }
 
+/******************************ChatTextLayoutPool*****************************/
+
+//--------------------------------------------------------------------------
+
+ChatTextLayoutPool& ChatTextLayoutPool::instance()
+{
+    static ChatTextLayoutPool inst;
+    return inst;
+}
+
+//--------------------------------------------------------------------------
+
+ChatTextLayoutPool::ChatTextLayoutPool()
+{
+    // leave a core for the GUI thread
+    m_pool.setMaxThreadCount(std::max(1,QThread::idealThreadCount()-1));
+}
+
+//--------------------------------------------------------------------------
+
+ChatTextLayoutPool::~ChatTextLayoutPool()
+{
+    m_pool.clear();
+    m_pool.waitForDone(-1);
+}
+
+//--------------------------------------------------------------------------
+
+void ChatTextLayoutPool::setMaxThreadCount(int count)
+{
+    m_pool.setMaxThreadCount(count);
+}
+
+//--------------------------------------------------------------------------
+
+int ChatTextLayoutPool::maxThreadCount() const
+{
+    return m_pool.maxThreadCount();
+}
+
+//--------------------------------------------------------------------------
+
+bool ChatTextLayoutPool::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+//--------------------------------------------------------------------------
+
+void ChatTextLayoutPool::prepare(Request request, Callback callback)
+{
+    auto guiThread=QCoreApplication::instance()->thread();
+    m_pool.start(
+        [request=std::move(request),callback=std::move(callback),guiThread]()
+        {
+            // QTextDocument not attached to a widget can be built and laid out in any thread
+            auto result=std::make_shared<Result>();
+            result->document=std::make_unique<QTextDocument>();
+            auto doc=result->document.get();
+            doc->setUndoRedoEnabled(false);
+            doc->setDefaultFont(request.font);
+            doc->setDocumentMargin(request.documentMargin);
+            if (request.markdown)
+            {
+                doc->setMarkdown(request.text);
+            }
+            else
+            {
+                doc->setPlainText(request.text);
+            }
+
+            // text width is not set, so this lays out the whole document without wrapping,
+            // only the natural width is reused, wrapping for the bubble width is done by the editor in the GUI thread
+            result->naturalWidth=doc->idealWidth();
+
+            doc->moveToThread(guiThread);
+            auto app=QCoreApplication::instance();
+            if (app!=nullptr)
+            {
+                QMetaObject::invokeMethod(app,[result,callback]() {callback(result);},Qt::QueuedConnection);
+            }
+        }
+    );
+}
+
 /********************************ChatMessageText****************************/
 
 //--------------------------------------------------------------------------
@@ -201,6 +292,16 @@ class ChatMessageText_p
 
         ChatMessageTextBrowser* text;
         int m_widthHint=0;
+
+        //! Incremented on every load so that stale prepared documents are dropped.
+        size_t generation=0;
+        bool pending=false;
+        QString pendingText;
+        QString pendingSelection;
+
+        //! Ideal width of the prepared document without wrapping, valid while the font is not changed.
+        std::optional<qreal> naturalWidth;
+        QFont naturalWidthFont;
 };
 
 //--------------------------------------------------------------------------
@@ -233,13 +334,98 @@ ChatMessageText::~ChatMessageText()
 
 void ChatMessageText::loadText(const QString& text, bool markdown)
 {
-    if (markdown)
+    auto generation=++pimpl->generation;
+    pimpl->naturalWidth.reset();
+    pimpl->pendingSelection.clear();
+
+    auto& pool=ChatTextLayoutPool::instance();
+    if (!pool.isEnabled())
+    {
+        pimpl->pending=false;
+        pimpl->pendingText.clear();
+        if (markdown)
+        {
+            pimpl->text->setMarkdown(text);
+        }
+        else
+        {
+            pimpl->text->setPlainText(text);
+        }
+        ChatMessageContentWrapper::invalidateSnapshotOf(this);
+        return;
+    }
+
+    // font from style sheet is resolved only when the widget is polished
+    pimpl->text->ensurePolished();
+    pimpl->text->clear();
+    pimpl->pending=true;
+    pimpl->pendingText=text;
+
+    ChatTextLayoutPool::Request request;
+    request.text=text;
+    request.markdown=markdown;
+    request.font=pimpl->text->font();
+    request.documentMargin=pimpl->text->document()->documentMargin();
+
+    QPointer<ChatMessageText> self{this};
+    pool.prepare(
+        std::move(request),
+        [self,generation](std::shared_ptr<ChatTextLayoutPool::Result> result)
+        {
+            if (self)
+            {
+                self->attachPreparedText(generation,*result);
+            }
+        }
+    );
+}
+
+//--------------------------------------------------------------------------
+
+void ChatMessageText::attachPreparedText(size_t generation, ChatTextLayoutPool::Result& result)
+{
+    if (generation!=pimpl->generation)
+    {
+        // text was reloaded or cleared meanwhile
+        return;
+    }
+
+    auto doc=result.document.release();
+    auto font=doc->defaultFont();
+    if (font!=pimpl->text->font())
     {
-        pimpl->text->setMarkdown(text);
+        // style changed while the document was being prepared
+        doc->setDefaultFont(pimpl->text->font());
     }
     else
     {
-        pimpl->text->setPlainText(text);
+        pimpl->naturalWidth=result.naturalWidth;
+        pimpl->naturalWidthFont=font;
+    }
+
+    // the editor deletes on replacement only its own initial document, previously attached documents
+    // are its children and must be deleted here
+    auto previous=pimpl->text->document();
+    doc->setParent(pimpl->text);
+    pimpl->text->setDocument(doc);
+    if (previous!=nullptr && previous!=doc && previous->parent()==pimpl->text)
+    {
+        previous->deleteLater();
+    }
+
+    pimpl->pending=false;
+    pimpl->pendingText.clear();
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
+    if (!pimpl->pendingSelection.isEmpty())
+    {
+        auto selection=pimpl->pendingSelection;
+        pimpl->pendingSelection.clear();
+        selectText(selection);
+    }
+
+    if (chatContent()!=nullptr)
+    {
+        chatContent()->renegotiateBubbleWidth();
     }
 }
 
@@ -247,7 +433,13 @@ void ChatMessageText::loadText(const QString& text, bool markdown)
 
 void ChatMessageText::clearText()
 {
-    pimpl->text->clear();    
+    ++pimpl->generation;
+    pimpl->pending=false;
+    pimpl->pendingText.clear();
+    pimpl->pendingSelection.clear();
+    pimpl->naturalWidth.reset();
+    pimpl->text->clear();
+    ChatMessageContentWrapper::invalidateSnapshotOf(this);
 }
 
 //--------------------------------------------------------------------------
@@ -297,6 +489,18 @@ void ChatMessageText::adjustWrapWidth(int& value, bool add)
 int ChatMessageText::bubbleWidthHint(int forMaxWidth)
 {
     auto wrapWidth=clampToMaxBubbleWidth(forMaxWidth);
+
+    // text that fits without wrapping has the same ideal width for any wider wrap width,
+    // the document is laid out for the final width in updateMaximumBubbleWidth() anyway
+    if (pimpl->naturalWidth && pimpl->naturalWidthFont==pimpl->text->font())
+    {
+        auto w=static_cast<int>(pimpl->naturalWidth.value());
+        if (w<=wrapWidth)
+        {
+            return w;
+        }
+    }
+
     auto t=const_cast<ChatMessageTextBrowser*>(pimpl->text);
     t->setLineWrapColumnOrWidth(wrapWidth);
     pimpl->text->updateSize();
@@ -329,6 +533,10 @@ QString ChatMessageText::selectedText() const
 
 bool ChatMessageText::hasSelectableText() const
 {
+    if (pimpl->pending)
+    {
+        return !pimpl->pendingText.trimmed().isEmpty();
+    }
     return !pimpl->text->toPlainText().trimmed().isEmpty();
 }
 
@@ -347,6 +555,12 @@ void ChatMessageText::selectText(const QString& text)
     {
         return;
     }
+    if (pimpl->pending)
+    {
+        // applied when the prepared document is attached
+        pimpl->pendingSelection=text;
+        return;
+    }
     auto cursor=pimpl->text->document()->find(text);
     if (cursor.isNull())
     {
@@ -43,20 +43,6 @@ UISE_DESKTOP_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------
 
-void DirectoryImagesSource::doLoadPixmap(const PixmapKey& key)
-{
-    auto path=key.toFilePath();
-    QPixmap px;
-    px.load(QString::fromStdString(path.string()));
-
-    for (auto& producer : producers(key))
-    {
-        producer->setPixmap(px);
-    }
-}
-
-//--------------------------------------------------------------------------
-
 DirectoryImagesViewer::DirectoryImagesViewer(QWidget *parent)
     : WidgetQFrame(parent),
       m_nativeFileDialog(true)
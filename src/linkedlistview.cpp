@@ -23,6 +23,7 @@ You may select, at your option, one of the above-listed licenses.
 
 /****************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -30,6 +31,7 @@ You may select, at your option, one of the above-listed licenses.
 
 #include <uise/desktop/linkedlistviewitem.hpp>
 #include <uise/desktop/linkedlistview.hpp>
+#include <uise/desktop/utils/directchildwidget.hpp>
 
 // linkedlistview.hpp is what #defines UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
 // (or doesn't), so this branch must come after including it above -- otherwise
@@ -39,6 +41,7 @@ You may select, at your option, one of the above-listed licenses.
 #include <uise/desktop/utils/layout.hpp>
 #else
 #include <QEvent>
+#include <QResizeEvent>
 #include <QCoreApplication>
 #include <QStyle>
 #include <uise/desktop/utils/orientationinvariant.hpp>
@@ -176,15 +179,20 @@ class LinkedListView_p
                 Qt::Orientation orientation
             ) : view(view),
                 orientation(orientation),
+                head(LinkedListViewItem::Null),
+                tail(LinkedListViewItem::Null),
 #ifdef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
                 layout(nullptr),
 #endif
                 blockUpdate(false),
-                singleWidgetHelper({nullptr})
+                singleWidgetHelper({nullptr}),
+                incrementalRelayout(false)
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
                 ,
                 alignment(Qt::Alignment()),
-                inRelayout(false)
+                inRelayout(false),
+                placedWidgetsValid(false),
+                sizeHintsValid(false)
 #endif
         {
         }
@@ -201,7 +209,31 @@ class LinkedListView_p
         }
 #endif
 
-        std::shared_ptr<LinkedListViewItem> itemForWidget(QWidget *widget)
+        using Index=LinkedListViewItem::Index;
+
+        /**
+         * @brief Find item of a widget in this view.
+         * @return Index of the item in the pool or Null if the widget is not a live member of this view.
+         *
+         * The widget property alone is not enough: the index there could have been written by
+         * another view, so it is cross-checked against the position index of this view.
+         */
+        Index itemIndex(QObject *widget) const
+        {
+            auto index=LinkedListViewItem::getFromWidgetProperty(widget);
+            if (index==LinkedListViewItem::Null || !pool.isIndexInRange(index))
+            {
+                return LinkedListViewItem::Null;
+            }
+            // static_cast only to compare addresses, qobject_cast fails for a widget being destroyed
+            if (!positions.contains(pool[index].posHandle(),static_cast<QWidget*>(widget)))
+            {
+                return LinkedListViewItem::Null;
+            }
+            return index;
+        }
+
+        Index itemForWidget(QWidget *widget)
         {
             if (widget->parent()!=nullptr && widget->parent()!=view)
             {
@@ -214,10 +246,17 @@ class LinkedListView_p
 
             QObject::disconnect(widget,SIGNAL(destroyed(QObject*)),view,SLOT(itemDestroyed(QObject*)));
             QObject::connect(widget,SIGNAL(destroyed(QObject*)),view,SLOT(itemDestroyed(QObject*)));
+#ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+            // watch for changes of widget's contents invalidating its cached extents
+            if (incrementalRelayout)
+            {
+                widget->installEventFilter(view);
+            }
+#endif
 
-            auto item=std::make_shared<LinkedListViewItem>(widget);
-            item->keepInWidgetProperty();
-            return item;
+            auto index=pool.allocate(widget);
+            LinkedListViewItem::keepInWidgetProperty(widget,index);
+            return index;
         }
 
         //! Unlinks \p item from the list. Unless \p destroyed, the widget is also detached
@@ -228,41 +267,48 @@ class LinkedListView_p
         //! there would be pure overhead: setParent(nullptr) followed by setParent(view) runs
         //! QWidgetPrivate::inheritStyle() twice, each time unpolishing and re-polishing the
         //! widget's whole descendant subtree against the app stylesheet.
-        void takeItem(const std::shared_ptr<LinkedListViewItem>& item, bool destroyed=false,
+        //!
+        //! \p widget is the widget of the item, it is passed explicitly because the item keeps
+        //! only a guarded pointer which is already null when the widget is being destroyed.
+        void takeItem(Index item, QObject* widget, bool destroyed=false,
                       bool keepWidgetAttached=false)
         {
-            if (item)
+            if (item!=LinkedListViewItem::Null)
             {
-                LinkedListViewItem::clearWidgetProperty(item->widget());
-                if (!destroyed && !keepWidgetAttached)
+                LinkedListViewItem::clearWidgetProperty(widget);
+                auto w=pool[item].widget();
+#ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+                if (!destroyed && w!=nullptr)
+                {
+                    w->removeEventFilter(view);
+                }
+#endif
+                if (!destroyed && !keepWidgetAttached && w!=nullptr)
                 {
-                    item->widget()->setVisible(false);
+                    w->setVisible(false);
 #if 0
     //! avoid reparenting because it causes cascade restyling
-                    item->widget()->setParent(nullptr);
+                    w->setParent(nullptr);
 #endif
                 }
                 if (!blockUpdate)
                 {
-                    if (head.lock().get()==item.get())
-                    {
-                        head=item->next();;
-                    }
-
-                    auto next=item->next();
-                    auto prev=item->prev();
-                    if (prev)
+                    if (head==item)
                     {
-                        prev->setNextAuto(next);
+                        head=pool[item].next();
                     }
-
-                    for (auto nextItem=item->next();nextItem;)
+                    if (tail==item)
                     {
-                        nextItem->decPos();
-                        nextItem=nextItem->next();
+                        tail=pool[item].prev();
                     }
 
-                    item->reset();
+                    pool.unlink(item);
+                    positions.erase(pool[item].posHandle());
+                    pool.release(item);
+#ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+                    placedWidgetsValid=false;
+                    sizeHintsValid=false;
+#endif
                 }
             }
         }
@@ -270,14 +316,14 @@ class LinkedListView_p
         void insertWidget(QWidget *newWidget, QWidget *existingWidget, bool after)
         {
             // check if inserting or reordering not needed
-            auto newItem=LinkedListViewItem::getFromWidgetProperty(newWidget);
-            if (newItem)
+            auto newItem=itemIndex(newWidget);
+            if (newItem!=LinkedListViewItem::Null)
             {
                 if (existingWidget==nullptr)
                 {
                     if (after)
                     {
-                        if (newItem->prev() == nullptr)
+                        if (pool[newItem].prev()==LinkedListViewItem::Null)
                         {
 #if 0
                             qDebug() << "LinkedListView_p::insertWidget stays first";
@@ -287,7 +333,7 @@ class LinkedListView_p
                     }
                     else
                     {
-                        if (newItem->next() == nullptr)
+                        if (pool[newItem].next()==LinkedListViewItem::Null)
                         {
 #if 0
                             qDebug() << "LinkedListView_p::insertWidget stays last";
@@ -298,12 +344,12 @@ class LinkedListView_p
                 }
                 else
                 {
-                    auto existingItem=LinkedListViewItem::getFromWidgetProperty(existingWidget);
-                    if (existingItem)
+                    auto existingItem=itemIndex(existingWidget);
+                    if (existingItem!=LinkedListViewItem::Null)
                     {
                         if (after)
                         {
-                            if (existingItem->next() == newItem)
+                            if (pool[existingItem].next()==newItem)
                             {
 #if 0
                                 qDebug() << "LinkedListView_p::insertWidget stays in the same position after";
@@ -313,7 +359,7 @@ class LinkedListView_p
                         }
                         else
                         {
-                            if (existingItem->prev() == newItem)
+                            if (pool[existingItem].prev()==newItem)
                             {
 #if 0
                                 qDebug() << "LinkedListView_p::insertWidget stays in the same position before";
@@ -344,29 +390,28 @@ class LinkedListView_p
             {
                 // check constraints for existing widget
                 Q_ASSERT(existingWidget->parent()==view);
-                Q_ASSERT(head.lock());
+                Q_ASSERT(head!=LinkedListViewItem::Null);
             }
             else
             {
                 // if existingWidget is not set then insert before head
-                auto headItem=head.lock();
-                if (headItem)
+                if (head!=LinkedListViewItem::Null)
                 {
-                    existingWidget=headItem->widget();
+                    existingWidget=pool[head].widget();
                     after=false;
                 }
             }
 
             // check item for existing widget
-            auto existingItem=LinkedListViewItem::getFromWidgetProperty(existingWidget);
-            if (existingWidget && !existingItem)
+            auto existingItem=itemIndex(existingWidget);
+            if (existingWidget && existingItem==LinkedListViewItem::Null)
             {
                 // The requested anchor widget is no longer part of this list -- its
                 // LinkedListViewItem property was already cleared by a concurrent
                 // takeItem() (e.g. FlyweightListView_p::insertContinuousItems() dedup-removing
                 // an existing item further along in the same batch, and that item happening to
                 // be the anchor captured earlier). Q_ASSERT alone is a no-op in release builds,
-                // so this used to fall through with pos==0/firstItemIsHead==true below,
+                // so this used to fall through as an insert at position 0,
                 // re-heading the list and orphaning every item already linked from the real
                 // head -- the widgets stayed alive but became unreachable from head, so
                 // widgetSeqPos()/traversal/sizeHint() would all silently see only the new
@@ -380,43 +425,59 @@ class LinkedListView_p
                                  "tail append" << std::endl;
                 }
                 existingWidget=nullptr;
-                for (auto tail=head.lock(); tail; tail=tail->next())
+                existingItem=tail;
+                if (existingItem!=LinkedListViewItem::Null)
                 {
-                    if (!tail->next())
-                    {
-                        existingItem=tail;
-                        existingWidget=tail->widget();
-                        break;
-                    }
+                    existingWidget=pool[existingItem].widget();
                 }
                 after=true;
             }
 
-            // calculate position of the first new item
-            size_t pos=0;
-            if (existingItem)
-            {
-                pos=after?(existingItem->pos()+1):existingItem->pos();
-            }
-            bool firstItemIsHead=pos==0;
-
             // construct item list from input widgets
-            std::shared_ptr<LinkedListViewItem> firstItem;
-            std::shared_ptr<LinkedListViewItem> lastItem;
+            auto firstItem=LinkedListViewItem::Null;
+            auto lastItem=LinkedListViewItem::Null;
             for (auto&& newWidget : newWidgets)
             {
+                // the anchor can not be moved relative to itself
+                Q_ASSERT(newWidget!=existingWidget);
+                if (newWidget==existingWidget)
+                {
+                    continue;
+                }
+
                 // Unlink any previous item for this widget, but keep the widget attached when it
                 // is already ours: it is re-attached to this same view a couple of lines below,
                 // so detaching it first would only buy two full restyles of its subtree instead
-                // of none (see takeItem()).
-                auto prevItem=LinkedListViewItem::getFromWidgetProperty(newWidget);
+                // of none (see takeItem()). An item owned by another view is left to
+                // itemForWidget().
+                auto prevItem=itemIndex(newWidget);
                 const bool alreadyOurs=newWidget->parentWidget()==view;
 #ifdef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
-                const bool reordered=alreadyOurs && static_cast<bool>(prevItem);
+                const bool reordered=alreadyOurs && prevItem!=LinkedListViewItem::Null;
 #endif
-                takeItem(prevItem,false,alreadyOurs);
+                if (prevItem!=LinkedListViewItem::Null)
+                {
+                    takeItem(prevItem,newWidget,false,alreadyOurs);
+                }
                 auto newItem=itemForWidget(newWidget);
-                newItem->setPrevAuto(lastItem);
+                pool.link(lastItem,newItem);
+
+                // register in position index right after the previous new item, or next to the anchor
+                LinkedListViewItem::PosIndex::Handle posHandle;
+                if (lastItem!=LinkedListViewItem::Null)
+                {
+                    posHandle=positions.insertAfter(pool[lastItem].posHandle(),newWidget);
+                }
+                else if (existingItem!=LinkedListViewItem::Null)
+                {
+                    posHandle=after?positions.insertAfter(pool[existingItem].posHandle(),newWidget)
+                                   :positions.insertBefore(pool[existingItem].posHandle(),newWidget);
+                }
+                else
+                {
+                    posHandle=positions.insertAfter(LinkedListViewItem::PosIndex::Null,newWidget);
+                }
+                pool[newItem].setPosHandle(posHandle);
 
 #ifdef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
                 if (reordered)
@@ -427,7 +488,7 @@ class LinkedListView_p
                     // stale entry itself.
                     layout->removeWidget(newWidget);
                 }
-                layout->insertWidget(pos,newWidget,0,alignment);
+                layout->insertWidget(static_cast<int>(positions.rank(posHandle)),newWidget,0,alignment);
                 newWidget->setVisible(true);
 #else
                 // QBoxLayout::insertWidget reparented the widget as a side effect;
@@ -440,43 +501,43 @@ class LinkedListView_p
                 }
                 newWidget->setVisible(true);
 #endif
-                newItem->setPos(pos++);
 
-                if (!firstItem)
+                if (firstItem==LinkedListViewItem::Null)
                 {
                     firstItem=newItem;
                 }
-                lastItem=std::move(newItem);
+                lastItem=newItem;
             }
-            if (firstItemIsHead)
+            if (firstItem==LinkedListViewItem::Null)
             {
-                head=firstItem;
+                return;
             }
 
             // insert constructed list into existing list
-            if (existingItem)
+            if (existingItem!=LinkedListViewItem::Null)
             {
                 if (after)
                 {
-                    lastItem->setNextAuto(existingItem->next());
-                    existingItem->setNextAuto(firstItem);
+                    pool.link(lastItem,pool[existingItem].next());
+                    pool.link(existingItem,firstItem);
                 }
                 else
                 {
-                    firstItem->setPrevAuto(existingItem->prev());
-                    lastItem->setNextAuto(existingItem);
+                    pool.link(pool[existingItem].prev(),firstItem);
+                    pool.link(lastItem,existingItem);
                 }
             }
-
-            // update positions of items after last inserted item
-            pos=lastItem->pos();
-            for (auto item=lastItem->next(); item;)
+            if (pool[firstItem].prev()==LinkedListViewItem::Null)
             {
-                item->setPos(++pos);
-                item=item->next();
+                head=firstItem;
+            }
+            if (pool[lastItem].next()==LinkedListViewItem::Null)
+            {
+                tail=lastItem;
             }
 
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+            sizeHintsValid=false;
             relayout();
             view->updateGeometry();
 #endif
@@ -513,14 +574,14 @@ class LinkedListView_p
 
             // pass 1: measure content main extent
             int contentMain=0;
-            for (auto item=head.lock(); item; item=item->next())
+            for (auto item=head; item!=LinkedListViewItem::Null; item=pool[item].next())
             {
-                auto w=item->widget();
+                auto w=pool[item].widget();
                 if (w==nullptr || isEmptyItem(w))
                 {
                     continue;
                 }
-                contentMain+=oprop(itemSizeHint(w),OProp::size);
+                contentMain+=oprop(sizeHintOf(pool[item]),OProp::size);
             }
 
             // main-axis packing origin: pack to the far edge only if alignment names
@@ -540,16 +601,17 @@ class LinkedListView_p
             }
 
             // pass 2: place
-            for (auto item=head.lock(); item; item=item->next())
+            placedWidgets.clear();
+            for (auto item=head; item!=LinkedListViewItem::Null; item=pool[item].next())
             {
-                auto w=item->widget();
+                auto w=pool[item].widget();
                 if (w==nullptr || isEmptyItem(w))
                 {
                     continue;
                 }
 
-                int mainSize=oprop(itemSizeHint(w),OProp::size);
-                int crossSize=qMin(crossSpace,itemMaxCross(w,crossHorizontal,crossAligned));
+                int mainSize=oprop(sizeHintOf(pool[item]),OProp::size);
+                int crossSize=qMin(crossSpace,maxCrossOf(pool[item],crossHorizontal,crossAligned));
 
                 int crossPos;
                 if (crossHorizontal)
@@ -589,14 +651,42 @@ class LinkedListView_p
                 setOProp(p,OProp::pos,crossPos,true);
                 setOProp(s,OProp::size,mainSize);
                 setOProp(s,OProp::size,crossSize,true);
-                w->setGeometry(QRect(p,s));
+                QRect geometry(p,s);
+                if (!incrementalRelayout || w->geometry()!=geometry)
+                {
+                    // in incremental mode only the shifted or re-measured widgets are touched
+                    w->setGeometry(geometry);
+                }
 
                 pos+=mainSize;
+                placedWidgets.push_back(PlacedWidget{pos,w});
             }
+            placedWidgetsValid=true;
 
             inRelayout=false;
         }
 
+        /**
+         * @brief Find widget placed at a position using prefix extents recorded by the last relayout().
+         * @return Found widget or nullptr if the position is out of the widgets along the main axis.
+         *
+         * Result must be verified against the actual geometry of the widget by the caller.
+         */
+        QWidget* placedWidgetAt(int mainPos) const
+        {
+            auto it=std::upper_bound(placedWidgets.begin(),placedWidgets.end(),mainPos,
+                [](int pos, const PlacedWidget& placed)
+                {
+                    return pos<placed.end;
+                }
+            );
+            if (it==placedWidgets.end())
+            {
+                return nullptr;
+            }
+            return it->widget;
+        }
+
         /**
          * @brief Post a coalesced relayout request.
          *
@@ -616,19 +706,37 @@ class LinkedListView_p
          * Mirrors QLayout::totalSizeHint()/QBoxLayout's minimum: main axis is the
          * sum of per-child extents, cross axis is the max over children, plus the
          * view's own contentsMargins on both axes.
+         *
+         * In incremental mode both hints are kept until an item is inserted, removed
+         * or re-measured, so repeated queries do not walk the list.
          */
         QSize calcSizeHint(bool minimum) const
+        {
+            if (!incrementalRelayout)
+            {
+                return sumSizeHints(minimum);
+            }
+            if (!sizeHintsValid)
+            {
+                cachedSizeHint=sumSizeHints(false);
+                cachedMinSizeHint=sumSizeHints(true);
+                sizeHintsValid=true;
+            }
+            return minimum?cachedMinSizeHint:cachedSizeHint;
+        }
+
+        QSize sumSizeHints(bool minimum) const
         {
             int main=0;
             int cross=0;
-            for (auto item=head.lock(); item; item=item->next())
+            for (auto item=head; item!=LinkedListViewItem::Null; item=pool[item].next())
             {
-                auto w=item->widget();
+                auto w=pool[item].widget();
                 if (w==nullptr || isEmptyItem(w))
                 {
                     continue;
                 }
-                auto s=minimum?itemMinSize(w):itemSizeHint(w);
+                auto s=minimum?minSizeOf(pool[item]):sizeHintOf(pool[item]);
                 main+=oprop(s,OProp::size);
                 cross=qMax(cross,oprop(s,OProp::size,true));
             }
@@ -639,6 +747,77 @@ class LinkedListView_p
             setOProp(r,OProp::size,cross+oprop(m,OProp::size,true),true);
             return r;
         }
+
+        /**
+         * @brief Get cached extents of an item, re-measuring its widget only if they are outdated.
+         */
+        const LinkedListViewItem::Extents& itemExtents(const LinkedListViewItem& item) const
+        {
+            auto& extents=item.extents();
+            if (!extents.valid)
+            {
+                auto w=item.widget();
+                extents.sizeHint=itemSizeHint(w);
+                extents.minSize=itemMinSize(w);
+                extents.maxCross=itemMaxCross(w,!isHorizontal(),false);
+                extents.valid=true;
+            }
+            return extents;
+        }
+
+        QSize sizeHintOf(const LinkedListViewItem& item) const
+        {
+            return incrementalRelayout?itemExtents(item).sizeHint:itemSizeHint(item.widget());
+        }
+
+        QSize minSizeOf(const LinkedListViewItem& item) const
+        {
+            return incrementalRelayout?itemExtents(item).minSize:itemMinSize(item.widget());
+        }
+
+        int maxCrossOf(const LinkedListViewItem& item, bool crossHorizontal, bool crossAligned) const
+        {
+            if (!incrementalRelayout)
+            {
+                return itemMaxCross(item.widget(),crossHorizontal,crossAligned);
+            }
+            return crossAligned?QWIDGETSIZE_MAX:itemExtents(item).maxCross;
+        }
+
+        void invalidateAllExtents()
+        {
+            for (auto item=head; item!=LinkedListViewItem::Null; item=pool[item].next())
+            {
+                pool[item].invalidateExtents();
+            }
+            sizeHintsValid=false;
+        }
+
+        void invalidateExtents(Index item)
+        {
+            pool[item].invalidateExtents();
+            sizeHintsValid=false;
+        }
+
+        void setItemsWatched(bool enable)
+        {
+            for (auto item=head; item!=LinkedListViewItem::Null; item=pool[item].next())
+            {
+                auto w=pool[item].widget();
+                if (w==nullptr)
+                {
+                    continue;
+                }
+                if (enable)
+                {
+                    w->installEventFilter(view);
+                }
+                else
+                {
+                    w->removeEventFilter(view);
+                }
+            }
+        }
 #endif
 
     public:
@@ -646,17 +825,34 @@ class LinkedListView_p
         LinkedListView* view;
         Qt::Orientation orientation;
 
-        std::weak_ptr<LinkedListViewItem> head;
+        LinkedListViewItemPool pool;
+        Index head;
+        Index tail;
+        LinkedListViewItem::PosIndex positions;
 #ifdef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
         QBoxLayout* layout;
 #endif
         bool blockUpdate;
 
         std::vector<QWidget*> singleWidgetHelper;
+        bool incrementalRelayout;
         Qt::Alignment alignment;
 
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
         bool inRelayout;
+
+        //! Far main-axis edge of every placed widget in linked order, i.e. prefix sums of their extents.
+        struct PlacedWidget
+        {
+            int end;
+            QWidget* widget;
+        };
+        std::vector<PlacedWidget> placedWidgets;
+        bool placedWidgetsValid;
+
+        mutable bool sizeHintsValid;
+        mutable QSize cachedSizeHint;
+        mutable QSize cachedMinSizeHint;
 #endif
 };
 
@@ -683,14 +879,29 @@ void LinkedListView::clear(const DropWidgetHandler &dropWidget)
 {
     blockSignals(true);
     pimpl->blockUpdate=true;
-    for (auto item=pimpl->head.lock(); item;)
+    for (auto item=pimpl->head; item!=LinkedListViewItem::Null;)
     {
-        item->clearWidgetProperty(item->widget());
-        auto next=item->next();
-        dropWidget(item->widget());
+        auto widget=pimpl->pool[item].widget();
+        auto next=pimpl->pool[item].next();
+        if (widget!=nullptr)
+        {
+            LinkedListViewItem::clearWidgetProperty(widget);
+#ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+            widget->removeEventFilter(this);
+#endif
+            dropWidget(widget);
+        }
         item=next;
     }
-    pimpl->head.reset();
+    pimpl->head=LinkedListViewItem::Null;
+    pimpl->tail=LinkedListViewItem::Null;
+    pimpl->pool.clear();
+    pimpl->positions.clear();
+#ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+    pimpl->placedWidgets.clear();
+    pimpl->placedWidgetsValid=false;
+    pimpl->sizeHintsValid=false;
+#endif
     blockSignals(false);
     pimpl->blockUpdate=false;
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
@@ -746,9 +957,15 @@ bool LinkedListView::event(QEvent *event)
 {
     switch (event->type())
     {
-        case (QEvent::LayoutRequest): [[fallthrough]];
+        case (QEvent::LayoutRequest):
+        {
+            pimpl->relayout();
+        }
+        break;
+
         case (QEvent::ContentsRectChange):
         {
+            pimpl->sizeHintsValid=false;
             pimpl->relayout();
         }
         break;
@@ -760,6 +977,61 @@ bool LinkedListView::event(QEvent *event)
     return QFrame::event(event);
 }
 
+//--------------------------------------------------------------------------
+bool LinkedListView::eventFilter(QObject *watched, QEvent *event)
+{
+    if (pimpl->incrementalRelayout)
+    {
+        switch (event->type())
+        {
+            case (QEvent::LayoutRequest): [[fallthrough]];
+            case (QEvent::ShowToParent): [[fallthrough]];
+            case (QEvent::Polish): [[fallthrough]];
+            case (QEvent::FontChange): [[fallthrough]];
+            case (QEvent::StyleChange):
+            {
+                // the view itself is notified later with its own LayoutRequest, then the widget is re-measured
+                auto item=pimpl->itemIndex(watched);
+                if (item!=LinkedListViewItem::Null)
+                {
+                    pimpl->invalidateExtents(item);
+                }
+            }
+            break;
+
+            case (QEvent::HideToParent):
+            {
+                // hidden widget does not contribute to the size hint of the list
+                if (pimpl->itemIndex(watched)!=LinkedListViewItem::Null)
+                {
+                    pimpl->sizeHintsValid=false;
+                }
+            }
+            break;
+
+            case (QEvent::Resize):
+            {
+                // size hint of a widget with height-for-width contents depends on its cross size
+                auto e=static_cast<QResizeEvent*>(event);
+                if (pimpl->oprop(e->size(),OProp::size,true)!=pimpl->oprop(e->oldSize(),OProp::size,true))
+                {
+                    auto item=pimpl->itemIndex(watched);
+                    if (item!=LinkedListViewItem::Null)
+                    {
+                        pimpl->invalidateExtents(item);
+                    }
+                }
+            }
+            break;
+
+            default:
+            break;
+        }
+    }
+
+    return QFrame::eventFilter(watched,event);
+}
+
 //--------------------------------------------------------------------------
 QSize LinkedListView::sizeHint() const
 {
@@ -812,8 +1084,8 @@ void LinkedListView::itemDestroyed(QObject *widget)
 //--------------------------------------------------------------------------
 void LinkedListView::takeWidget(QObject *widget, bool destroyed)
 {
-    auto item=LinkedListViewItem::getFromWidgetProperty(widget);
-    pimpl->takeItem(item,destroyed);
+    auto item=pimpl->itemIndex(widget);
+    pimpl->takeItem(item,widget,destroyed);
 #ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
     pimpl->scheduleRelayout();
 #endif
@@ -822,10 +1094,10 @@ void LinkedListView::takeWidget(QObject *widget, bool destroyed)
 //--------------------------------------------------------------------------
 size_t LinkedListView::widgetSeqPos(QObject *widget) const
 {
-    auto item=LinkedListViewItem::getFromWidgetProperty(widget);
-    if (item)
+    auto item=pimpl->itemIndex(widget);
+    if (item!=LinkedListViewItem::Null)
     {
-        return item->pos();
+        return pimpl->positions.rank(pimpl->pool[item].posHandle());
     }
     return 0;
 }
@@ -833,26 +1105,34 @@ size_t LinkedListView::widgetSeqPos(QObject *widget) const
 //--------------------------------------------------------------------------
 bool LinkedListView::containsWidget(QObject *widget) const
 {
-    return static_cast<bool>(LinkedListViewItem::getFromWidgetProperty(widget));
+    return pimpl->itemIndex(widget)!=LinkedListViewItem::Null;
 }
 
 //--------------------------------------------------------------------------
 QWidget* LinkedListView::widgetAtSeqPos(size_t pos) const
 {
-    auto item=pimpl->head.lock();
-    for (size_t i=0;i<pos;i++)
+    auto handle=pimpl->positions.at(pos);
+    if (handle==LinkedListViewItem::PosIndex::Null)
     {
-        if (!item)
-        {
-            return nullptr;
-        }
-        item=item->next();
+        return nullptr;
     }
-    if (!item)
+    return pimpl->positions.value(handle);
+}
+
+//--------------------------------------------------------------------------
+QWidget* LinkedListView::widgetAtPos(const QPoint& pos) const
+{
+#ifndef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+    if (pimpl->placedWidgetsValid)
     {
-        return nullptr;
+        auto widget=pimpl->placedWidgetAt(pimpl->oprop(pos,OProp::pos));
+        if (widget!=nullptr && !widget->isHidden() && widget->geometry().contains(pos))
+        {
+            return widget;
+        }
     }
-    return item->widget();
+#endif
+    return directChildWidgetAt(const_cast<LinkedListView*>(this),pos);
 }
 
 //--------------------------------------------------------------------------
@@ -875,6 +1155,52 @@ Qt::Alignment LinkedListView::alignment() const noexcept
     return pimpl->alignment;
 }
 
+//--------------------------------------------------------------------------
+void LinkedListView::setIncrementalRelayout(bool enable)
+{
+#ifdef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+    pimpl->incrementalRelayout=enable;
+#else
+    if (enable!=pimpl->incrementalRelayout)
+    {
+        // extents could be changed while they were not tracked
+        pimpl->invalidateAllExtents();
+        pimpl->incrementalRelayout=enable;
+
+        // widgets are watched only while their extents are cached
+        pimpl->setItemsWatched(enable);
+    }
+#endif
+}
+
+//--------------------------------------------------------------------------
+bool LinkedListView::isIncrementalRelayout() const noexcept
+{
+    return pimpl->incrementalRelayout;
+}
+
+//--------------------------------------------------------------------------
+void LinkedListView::invalidateWidget(QWidget *widget)
+{
+#ifdef UISE_DESKTOP_LINKEDLISTVIEW_LEGACY_LAYOUT
+    std::ignore=widget;
+#else
+    if (widget==nullptr)
+    {
+        pimpl->invalidateAllExtents();
+    }
+    else
+    {
+        auto item=pimpl->itemIndex(widget);
+        if (item!=LinkedListViewItem::Null)
+        {
+            pimpl->invalidateExtents(item);
+        }
+    }
+    pimpl->scheduleRelayout();
+#endif
+}
+
 //--------------------------------------------------------------------------
 
 UISE_DESKTOP_NAMESPACE_END
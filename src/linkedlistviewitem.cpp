@@ -30,23 +30,27 @@ You may select, at your option, one of the above-listed licenses.
 UISE_DESKTOP_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------
-void LinkedListViewItem::keepInWidgetProperty()
+void LinkedListViewItem::keepInWidgetProperty(QObject *widget, Index index)
 {
-    auto self=shared_from_this();
-    Q_ASSERT(self);
-    QVariant prop;
-    prop.setValue(self);
-    self->m_widget->setProperty(LinkedListViewItem::Property,prop);
+    Q_ASSERT(widget);
+    widget->setProperty(LinkedListViewItem::Property,QVariant::fromValue(index));
 }
 
 //--------------------------------------------------------------------------
-std::shared_ptr<LinkedListViewItem> LinkedListViewItem::getFromWidgetProperty(QObject *widget)
+LinkedListViewItem::Index LinkedListViewItem::getFromWidgetProperty(QObject *widget)
 {
     if (!widget)
     {
-        return std::shared_ptr<LinkedListViewItem>();
+        return Null;
     }
-    return widget->property(Property).value<LinkedListViewItemSharedPtr>();
+    auto prop=widget->property(Property);
+    bool ok=false;
+    auto index=prop.toUInt(&ok);
+    if (!prop.isValid() || !ok)
+    {
+        return Null;
+    }
+    return static_cast<Index>(index);
 }
 
 //--------------------------------------------------------------------------
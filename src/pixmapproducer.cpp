@@ -23,8 +23,14 @@ You may select, at your option, one of the above-listed licenses.
 
 /****************************************************************************/
 
+#include <QCoreApplication>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QWidget>
+
 #include <uise/desktop/stylecontext.hpp>
 #include <uise/desktop/utils/datetime.hpp>
+#include <uise/desktop/utils/pixmapscale.hpp>
 #include <uise/desktop/pixmapproducer.hpp>
 
 UISE_DESKTOP_NAMESPACE_BEGIN
@@ -44,21 +50,10 @@ QPixmap PixmapProducer::pixmap(IconVariant mode, QIcon::State state)
         }
     }
 
-    if (state==QIcon::State::On)
-    {
-        auto it=m_onPixmaps.find(mode);
-        if (it!=m_onPixmaps.end())
-        {
-            return it->second;
-        }
-    }
-    else
+    auto px=m_pixmaps.find(mode,stateIndex(state));
+    if (px!=nullptr)
     {
-        auto it=m_offPixmaps.find(mode);
-        if (it!=m_offPixmaps.end())
-        {
-            return it->second;
-        }
+        return *px;
     }
 
     return m_defaultPixmap;
@@ -98,14 +93,7 @@ void PixmapProducer::setPixmap(const QPixmap& pixmap, UISE_DESKTOP_NAMESPACE::Ic
     {
         px=px.scaled(size(),m_aspectRatioMode,Qt::SmoothTransformation);
     }
-    if (state==QIcon::State::On)
-    {
-        m_onPixmaps[mode]=std::move(px);
-    }
-    else
-    {
-        m_offPixmaps[mode]=std::move(px);
-    }
+    m_pixmaps.set(mode,stateIndex(state),std::move(px));
 
     emit pixmapUpdated();
 }
@@ -153,6 +141,35 @@ void PixmapProducer::clearAnimation()
     setAnimation(AnimationContent{});
 }
 
+//--------------------------------------------------------------------------
+
+size_t PixmapProducer::pixmapBytes() const noexcept
+{
+    size_t bytes=0;
+    m_pixmaps.forEach(
+        [&bytes](int, int, const QPixmap& px)
+        {
+            bytes+=static_cast<size_t>(px.width())*static_cast<size_t>(px.height())*static_cast<size_t>(px.depth())/8;
+        }
+    );
+    return bytes;
+}
+
+//--------------------------------------------------------------------------
+
+bool PixmapProducer::hasVisibleConsumer() const
+{
+    for (const auto* consumer : m_consumers)
+    {
+        auto widget=qobject_cast<QWidget*>(consumer->parent());
+        if (widget!=nullptr && widget->isVisible() && !widget->visibleRegion().isEmpty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /************************** PixmapConsumer *********************************/
 
 //--------------------------------------------------------------------------
@@ -339,7 +356,15 @@ std::shared_ptr<PixmapProducer> PixmapSource::acquireProducer(PixmapConsumer* co
         auto destroyingTimer=it->value()->destroyingTimer();
         destroyingTimer->clear();
 
+        m_cache.recordHit();
+        m_cache.insert(consumer->pixmapKey(),it->value()->pixmapBytes());
+
+        auto released=it->value()->consumerCount()==0;
         it->value()->registerConsumer(consumer);
+        if (released)
+        {
+            doReacquireProducer(consumer->pixmapKey());
+        }
 
         return it->sharedValue();
     }
@@ -349,6 +374,24 @@ std::shared_ptr<PixmapProducer> PixmapSource::acquireProducer(PixmapConsumer* co
     producer->registerConsumer(consumer);
     m_producers.insert(producer);
 
+    m_cache.recordMiss();
+    m_cache.insert(consumer->pixmapKey());
+    std::weak_ptr<PixmapSource> weakSelf=weak_from_this();
+    auto* p=producer.get();
+    QObject::connect(
+        p,
+        &PixmapProducer::pixmapUpdated,
+        p,
+        [weakSelf,p]()
+        {
+            auto self=weakSelf.lock();
+            if (self)
+            {
+                self->updateCachedBytes(p);
+            }
+        }
+    );
+
     doLoadProducer(consumer->pixmapKey());
     doLoadPixmap(consumer->pixmapKey());
 
@@ -374,11 +417,96 @@ void PixmapSource::releaseProducer(PixmapConsumer* consumer)
         return;
     }
 
+    doReleaseProducer(consumer->pixmapKey());
+
+    m_cache.setPinned(consumer->pixmapKey(),false);
+    m_cache.touch(consumer->pixmapKey());
+    if (m_cache.budget()!=0)
+    {
+        // released producer is kept until it is evicted from the cache
+        trimCache();
+        return;
+    }
+
     removeProducer(consumer->pixmapKey(),producer);
 }
 
 //--------------------------------------------------------------------------
 
+void PixmapSource::setCacheBudget(size_t bytes)
+{
+    m_cache.setBudget(bytes);
+    if (bytes!=0)
+    {
+        for (const auto& it : m_producers)
+        {
+            it->destroyingTimer()->clear();
+        }
+        trimCache();
+        return;
+    }
+
+    // fall back to destroying released producers after delay
+    std::vector<std::shared_ptr<PixmapProducer>> released;
+    for (const auto& it : m_producers)
+    {
+        if (it->consumerCount()==0)
+        {
+            released.push_back(it.sharedValue());
+        }
+    }
+    for (const auto& producer : released)
+    {
+        removeProducer(producer->pixmapKey(),producer.get());
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void PixmapSource::trimCache()
+{
+    auto& kIdx=keyIdx();
+    for (const auto& key : m_cache.evict())
+    {
+        doUnloadProducer(key);
+        kIdx.erase(key);
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void PixmapSource::updateCachedBytes(PixmapProducer* producer)
+{
+    m_cache.setBytes(producer->pixmapKey(),producer->pixmapBytes());
+    if (!m_cache.isOverBudget() || m_cacheTrimScheduled)
+    {
+        return;
+    }
+
+    // producer can not be destroyed while it is emitting the signal
+    auto app=QCoreApplication::instance();
+    if (app==nullptr)
+    {
+        return;
+    }
+    m_cacheTrimScheduled=true;
+    std::weak_ptr<PixmapSource> weakSelf=weak_from_this();
+    QMetaObject::invokeMethod(app,
+        [weakSelf]()
+        {
+            auto self=weakSelf.lock();
+            if (self)
+            {
+                self->m_cacheTrimScheduled=false;
+                self->trimCache();
+            }
+        },
+        Qt::QueuedConnection
+    );
+}
+
+//--------------------------------------------------------------------------
+
 void PixmapSource::removeProducer(PixmapKey key, PixmapProducer* producer)
 {
     auto self=shared_from_this();
@@ -386,6 +514,7 @@ void PixmapSource::removeProducer(PixmapKey key, PixmapProducer* producer)
     auto remove=[key=std::move(key),self]()
     {
         self->doUnloadProducer(key);
+        self->m_cache.erase(key);
         auto& kIdx=self->keyIdx();
         kIdx.erase(key);
     };
@@ -435,6 +564,8 @@ void PixmapSource::updatePixmap(const PixmapKey& key, const QPixmap& pixmap)
 
 void PixmapSource::updateScaledPixmaps(const WithPath& path, const QPixmap& originalPixmap)
 {
+    std::vector<PixmapProducer*> scaledProducers;
+
     auto& pIdx=pathIdx();
     auto [from,to]=pIdx.equal_range(path);
     for (auto it=from; it!=to; ++it)
@@ -442,8 +573,7 @@ void PixmapSource::updateScaledPixmaps(const WithPath& path, const QPixmap& orig
         auto* producer=it->value();
         if (!originalPixmap.isNull() && producer->size().isValid() && originalPixmap.size()!=producer->size())
         {
-            auto px=originalPixmap.scaled(producer->size(),m_aspectRatioMode,Qt::SmoothTransformation);
-            producer->setPixmap(px);
+            scaledProducers.push_back(producer);
         }
         else
         {
@@ -453,6 +583,66 @@ void PixmapSource::updateScaledPixmaps(const WithPath& path, const QPixmap& orig
             producer->setPixmap(originalPixmap);
         }
     }
+    if (scaledProducers.empty())
+    {
+        return;
+    }
+
+    // collect distinct final sizes, different keys can be scaled to the same size
+    auto original=originalPixmap.toImage();
+    std::vector<QSize> sizes;
+    std::vector<size_t> producerSizes;
+    QSize minSize;
+    for (auto* producer : scaledProducers)
+    {
+        auto size=original.size().scaled(producer->size(),m_aspectRatioMode);
+        auto it=std::find(sizes.begin(),sizes.end(),size);
+        producerSizes.push_back(static_cast<size_t>(std::distance(sizes.begin(),it)));
+        if (it==sizes.end())
+        {
+            sizes.push_back(size);
+            minSize=minSize.isValid()?minSize.boundedTo(size):size;
+        }
+    }
+
+    // halve the original down to the smallest size, then make a single smooth step from the nearest level
+    // for each size, using idle threads of the global pool
+    ImageMipChain chain{original,minSize};
+    std::vector<QImage> images(sizes.size());
+    QSemaphore done;
+    int started=0;
+    auto pool=QThreadPool::globalInstance();
+    for (size_t i=1;i<sizes.size();i++)
+    {
+        auto ok=pool->tryStart(
+            [&images,&done,i,level=chain.level(sizes[i]),size=sizes[i]]()
+            {
+                images[i]=ImageMipChain::scaledLevel(level,size);
+                done.release();
+            }
+        );
+        if (ok)
+        {
+            started++;
+        }
+        else
+        {
+            images[i]=ImageMipChain::scaledLevel(chain.level(sizes[i]),sizes[i]);
+        }
+    }
+    images[0]=ImageMipChain::scaledLevel(chain.level(sizes[0]),sizes[0]);
+    done.acquire(started);
+
+    std::vector<QPixmap> pixmaps;
+    pixmaps.reserve(images.size());
+    for (auto& image : images)
+    {
+        pixmaps.push_back(QPixmap::fromImage(std::move(image)));
+    }
+    for (size_t i=0;i<scaledProducers.size();i++)
+    {
+        scaledProducers[i]->setPixmap(pixmaps[producerSizes[i]]);
+    }
 }
 
 //--------------------------------------------------------------------------
@@ -523,4 +713,17 @@ std::vector<std::shared_ptr<PixmapProducer>> PixmapSource::producers(const WithP
 
 //--------------------------------------------------------------------------
 
+std::shared_ptr<PixmapProducer> PixmapSource::producer(const PixmapKey& key) const
+{
+    const auto& kIdx=m_producers.get<1>();
+    auto it=kIdx.find(key);
+    if (it==kIdx.end())
+    {
+        return std::shared_ptr<PixmapProducer>{};
+    }
+    return it->sharedValue();
+}
+
+//--------------------------------------------------------------------------
+
 UISE_DESKTOP_NAMESPACE_END
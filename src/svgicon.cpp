@@ -29,6 +29,7 @@ You may select, at your option, one of the above-listed licenses.
 #include <QPainter>
 #include <QGuiApplication>
 #include <QScreen>
+#include <QThreadPool>
 
 #include <QtSvg/QSvgRenderer>
 
@@ -38,10 +39,33 @@ UISE_DESKTOP_NAMESPACE_BEGIN
 
 //--------------------------------------------------------------------------
 
+SvgIcon::~SvgIcon()
+{
+    releaseAtlasSlots();
+}
+
+//--------------------------------------------------------------------------
+
 void SvgIcon::paint(QPainter *painter, const QRect &rect, IconVariant mode,  QIcon::State state, bool cache)
 {
     // qDebug() << "SvgIcon::paint mode=" << mode << " state=" << state << " name="<<name() << " size="<<rect.size();
 
+    // until warm up is done the icon is painted from content, not to stall on rendering of a cached variant
+    if (m_warmUpCount!=0)
+    {
+        cache=false;
+    }
+
+    if (cache && m_atlas)
+    {
+        // draw from atlas
+        auto slot=atlasSlot(rect.size(),mode,state);
+        if (slot!=nullptr && m_atlas->draw(painter,rect,*slot))
+        {
+            return;
+        }
+    }
+
     if (cache)
     {
         // try to find pixmap of requested size
@@ -94,20 +118,35 @@ QPixmap SvgIcon::pixmap(const QSize &size, IconVariant mode,  QIcon::State state
 
 QPixmap SvgIcon::makePixmap(const QSize &size, IconVariant mode,  QIcon::State state, bool cache, const QColor& background, QRect rect)
 {
-    // paint pixmap
     const qreal pixelRatio = qApp->primaryScreen()->devicePixelRatio();
-    QPixmap px{size};
-    px.fill(background);
-    QPainter painter;
-    painter.begin(&px);
-    painter.setRenderHints(QPainter::Antialiasing);
-    auto r=rect;
-    if (!r.isValid())
+    QPixmap px;
+
+    // copy from atlas to avoid rendering the same variant twice, uncached pixmaps do not take space in atlas
+    if (cache && m_atlas && !rect.isValid() && background==QColor(Qt::transparent))
+    {
+        auto slot=atlasSlot(size,mode,state);
+        if (slot!=nullptr)
+        {
+            px=m_atlas->pixmap(*slot);
+        }
+    }
+
+    // paint pixmap
+    if (px.isNull())
     {
-        r=px.rect();
+        px=QPixmap{size};
+        px.fill(background);
+        QPainter painter;
+        painter.begin(&px);
+        painter.setRenderHints(QPainter::Antialiasing);
+        auto r=rect;
+        if (!r.isValid())
+        {
+            r=px.rect();
+        }
+        paint(&painter, r, mode, state, false);
+        painter.end();
     }
-    paint(&painter, r, mode, state, false);
-    painter.end();
     px.setDevicePixelRatio(pixelRatio);
 
     // qDebug() << "SvgIcon::makePixmap 1";
@@ -117,17 +156,8 @@ QPixmap SvgIcon::makePixmap(const QSize &size, IconVariant mode,  QIcon::State s
     {
         // qDebug() << "SvgIcon::makePixmap 2";
 
-        auto set=pixmapSet(mode);
-        if (set==nullptr)
-        {
-            // qDebug() << "makePixmap set not found mode="<<mode<< " name="<<m_name;
-            // qDebug() << "makePixmap set added mode=" << mode << " name="<<m_name;
-
-            auto it=m_pixmapSets.emplace(mode,IconPixmapSet{});
-            set=&it.first->second;
-        }
-        // qDebug() << "makePixmap adding pixmap to set="<<set;
-        set->addPixmap(px,state);
+        // qDebug() << "makePixmap adding pixmap to set mode=" << mode << " name="<<m_name;
+        m_pixmapSets.value(mode).addPixmap(px,state);
     }
 
     // done
@@ -148,8 +178,28 @@ bool SvgIcon::loadFromData(
         return false;
     }
 
+    // sizes are rendered in background if possible
+    bool background=m_warmUpPool && !weak_from_this().expired() && QCoreApplication::instance()!=nullptr;
+    std::vector<WarmUpItem> warmUpItems;
+    auto warm=[this,background,&warmUpItems](const QSize& size, IconVariant mode, QIcon::State state)
+    {
+        if (background)
+        {
+            auto itemContent=state==QIcon::On ? onContent(mode) : offContent(mode);
+            warmUpItems.push_back(WarmUpItem{mode,state,size,std::move(itemContent),QImage{}});
+        }
+        else if (m_atlas)
+        {
+            atlasSlot(size,mode,state);
+        }
+        else
+        {
+            makePixmap(size,mode,state);
+        }
+    };
+
     // prepare content
-    auto exec=[this,&sizes,&content](const std::map<IconVariant,ColorMap>& colorMaps)
+    auto exec=[this,&sizes,&content,&warm](const std::map<IconVariant,ColorMap>& colorMaps)
     {
         for (const auto& colorMap : colorMaps)
         {
@@ -176,16 +226,16 @@ bool SvgIcon::loadFromData(
 
             }
 
-            // fill cache of pixmaps for all sizes
+            // fill cache of pixmaps for all sizes, with atlas the pixmaps are rendered to the atlas
             for (const auto& size: sizes)
             {
                 if (!colorMap.second.on.empty())
                 {
-                    makePixmap(size,colorMap.first,QIcon::On);
+                    warm(size,colorMap.first,QIcon::On);
                 }
                 if (!colorMap.second.off.empty())
                 {
-                    makePixmap(size,colorMap.first,QIcon::Off);
+                    warm(size,colorMap.first,QIcon::Off);
                 }
             }
         }
@@ -202,6 +252,10 @@ bool SvgIcon::loadFromData(
     {
         exec(colorMaps);
     }
+    if (!warmUpItems.empty())
+    {
+        warmUp(std::move(warmUpItems));
+    }
 
     // done
     return true;
@@ -246,7 +300,9 @@ void SvgIcon::reload(
         const std::map<IconVariant,ColorMap>& colorMaps
     )
 {
+    cancelWarmUp();
     m_pixmapSets.clear();
+    releaseAtlasSlots();
 
     for (const auto& modeColorMap : colorMaps)
     {
@@ -276,4 +332,160 @@ void SvgIcon::reload(
 
 //--------------------------------------------------------------------------
 
+const SvgIconAtlas::Slot* SvgIcon::atlasSlot(const QSize& size, IconVariant mode, QIcon::State state,
+                                             const SvgIconAtlas::RenderFn& render)
+{
+    if (!m_atlas || size.isEmpty())
+    {
+        return nullptr;
+    }
+
+    auto& slots=m_atlasSlots.value(mode,static_cast<int>(state));
+    auto it=std::find_if(slots.begin(),slots.end(),
+        [&size](const std::pair<QSize,SvgIconAtlas::Slot>& entry)
+        {
+            return entry.first==size;
+        }
+    );
+    if (it!=slots.end() && m_atlas->isValid(it->second))
+    {
+        return &it->second;
+    }
+
+    // render to atlas, slots made before the atlas was cleared are rendered again
+    SvgIconAtlas::Slot slot;
+    if (render)
+    {
+        slot=m_atlas->insert(size,render);
+    }
+    else
+    {
+        slot=m_atlas->insert(size,
+            [this,mode,state](QPainter* painter, const QRect& rect)
+            {
+                paint(painter,rect,mode,state,false);
+            }
+        );
+    }
+    if (!m_atlas->isValid(slot))
+    {
+        return nullptr;
+    }
+    if (it!=slots.end())
+    {
+        it->second=slot;
+        return &it->second;
+    }
+    slots.emplace_back(size,slot);
+    return &slots.back().second;
+}
+
+//--------------------------------------------------------------------------
+
+void SvgIcon::releaseAtlasSlots()
+{
+    if (m_atlas)
+    {
+        m_atlasSlots.forEach(
+            [this](int, int, const std::vector<std::pair<QSize,SvgIconAtlas::Slot>>& slots)
+            {
+                for (const auto& slot : slots)
+                {
+                    m_atlas->release(slot.second);
+                }
+            }
+        );
+    }
+    m_atlasSlots.clear();
+}
+
+//--------------------------------------------------------------------------
+
+void SvgIcon::warmUp(std::vector<WarmUpItem> items)
+{
+    m_warmUpCount++;
+
+    std::weak_ptr<SvgIcon> weakSelf=weak_from_this();
+    m_warmUpPool->start(
+        [weakSelf,generation=m_warmUpGeneration,items=std::move(items)]() mutable
+        {
+            // rendering of SVG to QImage is safe in worker threads, pixmaps are made in GUI thread
+            QByteArray rendererContent;
+            std::unique_ptr<QSvgRenderer> renderer;
+            for (auto& item : items)
+            {
+                if (!renderer || item.content!=rendererContent)
+                {
+                    rendererContent=item.content;
+                    renderer=std::make_unique<QSvgRenderer>(rendererContent);
+                }
+
+                item.image=QImage{item.size,QImage::Format_ARGB32_Premultiplied};
+                item.image.fill(Qt::transparent);
+                QPainter painter;
+                painter.begin(&item.image);
+                painter.setRenderHints(QPainter::Antialiasing);
+                renderer->render(&painter,QRectF{item.image.rect()});
+                painter.end();
+            }
+
+            auto app=QCoreApplication::instance();
+            if (app!=nullptr)
+            {
+                QMetaObject::invokeMethod(app,
+                    [weakSelf,generation,items=std::move(items)]()
+                    {
+                        auto self=weakSelf.lock();
+                        if (self)
+                        {
+                            self->onWarmUpReady(generation,items);
+                        }
+                    },
+                    Qt::QueuedConnection
+                );
+            }
+        }
+    );
+}
+
+//--------------------------------------------------------------------------
+
+void SvgIcon::onWarmUpReady(quint64 generation, const std::vector<WarmUpItem>& items)
+{
+    // icon was reloaded after warm up started
+    if (generation!=m_warmUpGeneration)
+    {
+        return;
+    }
+    m_warmUpCount--;
+
+    const qreal pixelRatio = qApp->primaryScreen()->devicePixelRatio();
+    for (const auto& item : items)
+    {
+        if (item.image.isNull())
+        {
+            continue;
+        }
+
+        // variants rendered on demand meanwhile are kept
+        if (m_atlas)
+        {
+            atlasSlot(item.size,item.mode,item.state,
+                [&item](QPainter* painter, const QRect& rect)
+                {
+                    painter->drawImage(rect,item.image);
+                }
+            );
+        }
+        else
+        {
+            auto px=QPixmap::fromImage(item.image);
+            px.setDevicePixelRatio(pixelRatio);
+            m_pixmapSets.value(item.mode).addPixmap(std::move(px),item.state);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+
 UISE_DESKTOP_NAMESPACE_END
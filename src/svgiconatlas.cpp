@@ -0,0 +1,125 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/svgiconatlas.cpp
+*
+*  Defines SvgIconAtlas class.
+*
+*/
+
+/****************************************************************************/
+
+#include <QPainter>
+
+#include <uise/desktop/svgiconatlas.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+//--------------------------------------------------------------------------
+
+SvgIconAtlas::SvgIconAtlas(int pageSize)
+    : m_packer(pageSize,pageSize,Padding)
+{
+}
+
+//--------------------------------------------------------------------------
+
+SvgIconAtlas::Slot SvgIconAtlas::insert(const QSize& size, const RenderFn& render)
+{
+    auto allocation=m_packer.allocate(size.width(),size.height());
+    if (!allocation.isValid())
+    {
+        return Slot{};
+    }
+
+    // page is created when the packer opens it or reuses a freed page
+    if (static_cast<int>(m_pages.size())<=allocation.page)
+    {
+        m_pages.resize(allocation.page+1);
+    }
+    if (m_pages[allocation.page].isNull())
+    {
+        QPixmap page{pageSize(),pageSize()};
+        page.fill(Qt::transparent);
+        m_pages[allocation.page]=std::move(page);
+    }
+
+    Slot slot{allocation.page,QRect{allocation.x,allocation.y,size.width(),size.height()},m_generation};
+
+    // page is painted in place, it is never shared, so painting does not detach it
+    QPainter painter;
+    painter.begin(&m_pages[slot.page]);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(slot.rect,Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setRenderHints(QPainter::Antialiasing);
+    painter.setClipRect(slot.rect);
+    render(&painter,slot.rect);
+    painter.end();
+
+    return slot;
+}
+
+//--------------------------------------------------------------------------
+
+bool SvgIconAtlas::draw(QPainter* painter, const QRect& target, const Slot& slot) const
+{
+    if (!isValid(slot))
+    {
+        return false;
+    }
+    painter->drawPixmap(target,m_pages[slot.page],slot.rect);
+    return true;
+}
+
+//--------------------------------------------------------------------------
+
+QPixmap SvgIconAtlas::pixmap(const Slot& slot) const
+{
+    if (!isValid(slot))
+    {
+        return QPixmap{};
+    }
+    return m_pages[slot.page].copy(slot.rect);
+}
+
+//--------------------------------------------------------------------------
+
+void SvgIconAtlas::release(const Slot& slot)
+{
+    if (!isValid(slot))
+    {
+        return;
+    }
+    if (m_packer.release(ShelfPackerAllocation{slot.page,slot.rect.x(),slot.rect.y()}))
+    {
+        m_pages[slot.page]=QPixmap{};
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void SvgIconAtlas::clear()
+{
+    m_packer.clear();
+    m_pages.clear();
+    m_generation++;
+}
+
+//--------------------------------------------------------------------------
+
+UISE_DESKTOP_NAMESPACE_END
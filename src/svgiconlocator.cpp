@@ -171,6 +171,8 @@ std::shared_ptr<SvgIcon> SvgIconLocator::iconPriv(const QString& name, bool auto
     // make icon
     auto icon=std::make_shared<SvgIcon>();
     icon->setName(name);
+    icon->setAtlas(m_iconAtlas);
+    icon->setWarmUpPool(m_warmUpPool);
     auto ok=icon->addFile(path,*maps,m_defaultSizes);
     if (!ok)
     {
@@ -259,6 +261,8 @@ std::shared_ptr<SvgIcon> SvgIconLocator::iconForContext(const QString& name, con
     // make icon
     auto icon=std::make_shared<SvgIcon>();
     icon->setName(name);
+    icon->setAtlas(m_iconAtlas);
+    icon->setWarmUpPool(m_warmUpPool);
     auto ok=icon->addFile(path,*maps,m_defaultSizes);
     if (!ok)
     {
@@ -304,6 +308,8 @@ void SvgIconLocator::loadIcons(const std::vector<IconConfig>& iconConfigs, const
             insert=true;
             icon=std::make_shared<SvgIcon>();
             icon->setName(iconConfig.name);
+            icon->setAtlas(m_iconAtlas);
+            icon->setWarmUpPool(m_warmUpPool);
         }
 
         // prepare sizes
@@ -446,8 +452,12 @@ void SvgIconLocator::reloadIconThemes(const std::vector<SvgIconTheme>& themes)
     auto globalIcons=m_icons;
     auto contextIcons=m_contextIconCache;
 
-    // load icon themes
+    // load icon themes, variants of previous themes are dropped from atlas
     clearBeforeReload();
+    if (m_iconAtlas)
+    {
+        m_iconAtlas->clear();
+    }
     for (const auto& theme: themes)
     {
         loadIconTheme(theme);
@@ -514,6 +524,8 @@ std::shared_ptr<SvgIcon> SvgIconLocator::recreateContextIcon(size_t hash, const
     // make icon
     auto icon=std::make_shared<SvgIcon>();
     icon->setName(prevIcon.name);
+    icon->setAtlas(m_iconAtlas);
+    icon->setWarmUpPool(m_warmUpPool);
     auto ok=icon->addFile(path,*maps,m_defaultSizes);
     if (!ok)
     {
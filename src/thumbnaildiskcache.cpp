@@ -0,0 +1,278 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/desktop/thumbnaildiskcache.cpp
+*
+*  Defines on-disk cache of thumbnails.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <uise/desktop/thumbnaildiskcache.hpp>
+
+UISE_DESKTOP_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr static const char Magic[4]={'U','T','H','C'};
+constexpr static const char* Suffix=".thumb";
+
+//! Header of cache file, followed by raw pixels. Size of the header keeps pixels aligned.
+struct Header
+{
+    char magic[4];
+    quint32 version;
+    quint64 fingerprint;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+};
+static_assert(sizeof(Header)==32,"Unexpected size of thumbnail header");
+
+}
+
+//--------------------------------------------------------------------------
+
+ThumbnailDiskCache::ThumbnailDiskCache(QString directory, qint64 maxBytes)
+    : m_directory(std::move(directory)),
+      m_maxBytes(maxBytes)
+{
+}
+
+//--------------------------------------------------------------------------
+
+QString ThumbnailDiskCache::fileName(const PixmapKey& key) const
+{
+    QCryptographicHash hash{QCryptographicHash::Sha1};
+    hash.addData(QByteArray::fromStdString(key.toString()));
+    hash.addData(QString("@%1x%2").arg(key.size().width()).arg(key.size().height()).toUtf8());
+    return QDir{m_directory}.filePath(QString::fromLatin1(hash.result().toHex())+Suffix);
+}
+
+//--------------------------------------------------------------------------
+
+quint64 ThumbnailDiskCache::fileFingerprint(const QString& fileName)
+{
+    QFileInfo info{fileName};
+    if (!info.exists())
+    {
+        return 0;
+    }
+    auto size=static_cast<quint64>(info.size());
+    auto modified=static_cast<quint64>(info.lastModified().toMSecsSinceEpoch());
+    return (size*0x9E3779B97F4A7C15ull)^modified;
+}
+
+//--------------------------------------------------------------------------
+
+QImage ThumbnailDiskCache::load(const PixmapKey& key, quint64 fingerprint) const
+{
+    QFile file{fileName(key)};
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return QImage{};
+    }
+
+    auto size=file.size();
+    if (size<static_cast<qint64>(sizeof(Header)))
+    {
+        return QImage{};
+    }
+    auto data=file.map(0,size);
+    if (data==nullptr)
+    {
+        return QImage{};
+    }
+
+    Header header;
+    std::memcpy(&header,data,sizeof(Header));
+    auto format=static_cast<QImage::Format>(header.format);
+
+    // header comes from the disk, compute in 64 bits so that a corrupted one can not overflow the checks
+    auto width=static_cast<qint64>(header.width);
+    auto height=static_cast<qint64>(header.height);
+    auto bytesPerLine=static_cast<qint64>(header.bytesPerLine);
+    bool valid=std::memcmp(header.magic,Magic,sizeof(Magic))==0
+                && header.version==FormatVersion
+                && header.fingerprint==fingerprint
+                && width>0 && height>0
+                && bytesPerLine>=width*4
+                && (format==QImage::Format_ARGB32_Premultiplied || format==QImage::Format_RGB32)
+                && bytesPerLine*height==size-static_cast<qint64>(sizeof(Header));
+
+    QImage image;
+    if (valid)
+    {
+        // copy pixels so that the file is not kept open while the image is alive
+        QImage mapped{data+sizeof(Header),header.width,header.height,header.bytesPerLine,format};
+        image=mapped.copy();
+    }
+    file.unmap(data);
+    return image;
+}
+
+//--------------------------------------------------------------------------
+
+bool ThumbnailDiskCache::store(const PixmapKey& key, quint64 fingerprint, const QImage& image) const
+{
+    if (image.isNull() || !QDir{}.mkpath(m_directory))
+    {
+        return false;
+    }
+
+    auto img=image;
+    if (img.format()!=QImage::Format_RGB32 && img.format()!=QImage::Format_ARGB32_Premultiplied)
+    {
+        img=img.convertToFormat(img.hasAlphaChannel()?QImage::Format_ARGB32_Premultiplied:QImage::Format_RGB32);
+    }
+
+    Header header;
+    std::memcpy(header.magic,Magic,sizeof(Magic));
+    header.version=FormatVersion;
+    header.fingerprint=fingerprint;
+    header.width=img.width();
+    header.height=img.height();
+    header.bytesPerLine=static_cast<qint32>(img.bytesPerLine());
+    header.format=static_cast<qint32>(img.format());
+
+    // write to a temporary file and rename it, so a reader never sees a partially written entry
+    auto name=fileName(key);
+    QFileInfo previous{name};
+    auto previousSize=previous.exists()?previous.size():0;
+    QSaveFile file{name};
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header),sizeof(Header));
+    file.write(reinterpret_cast<const char*>(img.constBits()),img.sizeInBytes());
+    if (!file.commit())
+    {
+        return false;
+    }
+
+    accountWritten(static_cast<qint64>(sizeof(Header))+static_cast<qint64>(img.sizeInBytes())-previousSize);
+    return true;
+}
+
+//--------------------------------------------------------------------------
+
+void ThumbnailDiskCache::accountWritten(qint64 delta) const
+{
+    if (m_maxBytes<=0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_totalBytes<0)
+    {
+        // size of the files left by the previous runs is unknown until the first write,
+        // the written file is counted by the scan
+        m_totalBytes=doTrim(-1);
+    }
+    else
+    {
+        m_totalBytes+=delta;
+    }
+
+    if (m_totalBytes>m_maxBytes)
+    {
+        // trim with a margin, so that the directory is not scanned on every following write
+        m_totalBytes=doTrim(m_maxBytes/4*3);
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void ThumbnailDiskCache::remove(const PixmapKey& key) const
+{
+    auto name=fileName(key);
+    QFileInfo info{name};
+    auto size=info.exists()?info.size():0;
+    if (QFile::remove(name))
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_totalBytes>=0)
+        {
+            m_totalBytes=std::max(qint64(0),m_totalBytes-size);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+
+void ThumbnailDiskCache::clear() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    QDir dir{m_directory};
+    for (const auto& name : dir.entryList({QString("*")+Suffix},QDir::Files))
+    {
+        dir.remove(name);
+    }
+    m_totalBytes=-1;
+}
+
+//--------------------------------------------------------------------------
+
+void ThumbnailDiskCache::trim(qint64 maxBytes) const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_totalBytes=doTrim(maxBytes);
+}
+
+//--------------------------------------------------------------------------
+
+qint64 ThumbnailDiskCache::doTrim(qint64 maxBytes) const
+{
+    QDir dir{m_directory};
+    auto files=dir.entryInfoList({QString("*")+Suffix},QDir::Files,QDir::Time);
+
+    // files are sorted from the newest to the oldest, negative limit only counts the size
+    qint64 total=0;
+    qint64 kept=0;
+    for (const auto& file : files)
+    {
+        total+=file.size();
+        if (maxBytes>=0 && total>maxBytes)
+        {
+            if (QFile::remove(file.absoluteFilePath()))
+            {
+                continue;
+            }
+        }
+        kept+=file.size();
+    }
+    return kept;
+}
+
+//--------------------------------------------------------------------------
+
+UISE_DESKTOP_NAMESPACE_END
@@ -0,0 +1,162 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/chatmessage/testchatmessagesnapshot.cpp
+*
+*  Test painting of idle ChatMessage bubbles from snapshots.
+*
+*/
+
+/****************************************************************************/
+
+#include <QDateTime>
+#include <QLabel>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/test/uise-testutils.hpp>
+
+#include <uise/desktop/chatmessage.hpp>
+#include <uise/desktop/chatmessagetext.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+using ChatMessageContainer=TestWidgetContainer<ChatMessage>;
+using ChatMessageContainerPtr=std::shared_ptr<ChatMessageContainer>;
+
+namespace {
+
+ChatMessage* makeMessage()
+{
+    auto msg=new ChatMessage();
+    msg->construct();
+    msg->setDirection(AbstractChatMessage::Direction::Received);
+    msg->setDateTime(QDateTime::currentDateTime());
+
+    auto content=new ChatMessageContent(msg);
+    content->setChatMessage(msg);
+
+    auto body=new ChatMessageText();
+    body->loadText(QString("Hello world"),false);
+
+    auto bottom=new ChatMessageBottom(content);
+    bottom->setTimeString(QString("12:00"));
+
+    content->setWidgets(body,nullptr,bottom);
+    msg->setContent(content);
+    content->updateBubbleWidth(400);
+
+    return msg;
+}
+
+ChatMessageContentWrapper* wrapper(ChatMessage* msg)
+{
+    return msg->findChild<ChatMessageContentWrapper*>();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestChatMessageSnapshot)
+
+BOOST_AUTO_TEST_CASE(TestContentChanges)
+{
+    auto init=[](ChatMessageContainerPtr container){
+        ChatMessageContainer::PlayStepPeriod=200;
+        ChatTextLayoutPool::instance().setEnabled(false);
+        ChatMessageContainer::beginTestCase(container,makeMessage(),"Test ChatMessage snapshot");
+    };
+
+    auto paintThenSetTime=[](ChatMessageContainerPtr container){
+        auto w=wrapper(container->testWidget);
+        UISE_TEST_REQUIRE(w!=nullptr);
+
+        w->setPainted(true);
+        UISE_TEST_CHECK(w->isPainted());
+
+        // status line changed while the bubble is hidden behind the snapshot
+        container->testWidget->content()->bottom()->setTimeString(QString("12:01"));
+        UISE_TEST_CHECK(!w->isPainted());
+    };
+
+    auto paintThenSetStatus=[](ChatMessageContainerPtr container){
+        auto w=wrapper(container->testWidget);
+        w->setPainted(true);
+        UISE_TEST_CHECK(w->isPainted());
+
+        container->testWidget->content()->bottom()->setSeen(QString("seen"));
+        UISE_TEST_CHECK(!w->isPainted());
+    };
+
+    auto paintThenSwapText=[](ChatMessageContainerPtr container){
+        auto w=wrapper(container->testWidget);
+        w->setPainted(true);
+        UISE_TEST_CHECK(w->isPainted());
+
+        auto text=qobject_cast<ChatMessageText*>(container->testWidget->content()->body());
+        UISE_TEST_REQUIRE(text!=nullptr);
+        text->loadText(QString("Another text"),false);
+        UISE_TEST_CHECK(!w->isPainted());
+    };
+
+    auto paintThenDisable=[](ChatMessageContainerPtr container){
+        auto w=wrapper(container->testWidget);
+        w->setPainted(true);
+        UISE_TEST_CHECK(w->isPainted());
+
+        // state of a section changed without explicit invalidation
+        auto bottom=container->testWidget->content()->bottom();
+        bottom->setEnabled(false);
+        UISE_TEST_CHECK(!w->isPainted());
+        bottom->setEnabled(true);
+    };
+
+    auto paintThenAddWidget=[](ChatMessageContainerPtr container){
+        auto w=wrapper(container->testWidget);
+        w->setPainted(true);
+        UISE_TEST_CHECK(w->isPainted());
+
+        new QLabel(QString("Edited"),container->testWidget->content()->bottom());
+        UISE_TEST_CHECK(!w->isPainted());
+    };
+
+    auto paintThenKeep=[](ChatMessageContainerPtr container){
+        auto w=wrapper(container->testWidget);
+        w->setPainted(true);
+        UISE_TEST_CHECK(w->isPainted());
+    };
+
+    auto checkKept=[](ChatMessageContainerPtr container){
+        // nothing changed, snapshot is kept
+        auto w=wrapper(container->testWidget);
+        UISE_TEST_CHECK(w->isPainted());
+        w->setPainted(false);
+    };
+
+    std::vector<std::function<void (ChatMessageContainerPtr container)>> steps={
+        init,
+        paintThenSetTime,
+        paintThenSetStatus,
+        paintThenSwapText,
+        paintThenDisable,
+        paintThenAddWidget,
+        paintThenKeep,
+        checkKept
+    };
+    ChatMessageContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
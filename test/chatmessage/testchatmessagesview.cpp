@@ -0,0 +1,273 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/chatmessage/testchatmessagesview.cpp
+*
+*  Test updating messages of ChatMessagesView.
+*
+*/
+
+/****************************************************************************/
+
+#include <QDateTime>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/test/uise-testutils.hpp>
+
+#include <uise/desktop/widget.hpp>
+#include <uise/desktop/chatmessage.hpp>
+#include <uise/desktop/chatmessagetext.hpp>
+#include <uise/desktop/chatmessagesview.hpp>
+#include <uise/desktop/ipp/chatmessagesview.ipp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+namespace {
+
+struct TestMessageData
+{
+    int id=0;
+    int sortValue=0;
+    QDateTime dateTime;
+    bool unread=false;
+};
+
+class TestMessage : public WidgetController
+{
+    public:
+
+        using Id=int;
+        using SortValue=int;
+
+        explicit TestMessage(QObject* parent=nullptr) : WidgetController(parent)
+        {}
+
+        virtual AbstractChatMessage* ui()
+        {
+            return nullptr;
+        }
+
+        void updateData(const TestMessageData& data)
+        {
+            m_data=data;
+        }
+
+        const TestMessageData& data() const
+        {
+            return m_data;
+        }
+
+        Id id() const
+        {
+            return m_data.id;
+        }
+
+        SortValue sortValue() const
+        {
+            return m_data.sortValue;
+        }
+
+        QDateTime dateTime() const
+        {
+            return m_data.dateTime;
+        }
+
+        bool isUnread() const
+        {
+            return m_data.unread;
+        }
+
+        bool sameSender(const TestMessage*) const
+        {
+            return true;
+        }
+
+        bool operator<(const TestMessage& other) const
+        {
+            return sortValue()<other.sortValue();
+        }
+
+    private:
+
+        TestMessageData m_data;
+};
+
+struct TestMessageTraits
+{
+    using Data=TestMessageData;
+    using Id=TestMessage::Id;
+    using SortValue=TestMessage::SortValue;
+
+    static Id id(const Data& data)
+    {
+        return data.id;
+    }
+
+    static SortValue sortValue(const Data& data)
+    {
+        return data.sortValue;
+    }
+};
+
+using TestMessagesView=ChatMessagesView<TestMessage,TestMessageTraits>;
+using ChatMessagesViewContainer=TestWidgetContainer<TestMessagesView>;
+using ChatMessagesViewContainerPtr=std::shared_ptr<ChatMessagesViewContainer>;
+
+TestMessagesView::Message* buildMessage(const TestMessageData& data, QWidget* parent)
+{
+    auto message=new TestMessagesView::Message(parent);
+    message->updateData(data);
+    message->initWidget(parent);
+
+    auto msg=qobject_cast<ChatMessage*>(message->ui());
+    msg->setDirection(AbstractChatMessage::Direction::Received);
+    msg->setDateTime(data.dateTime);
+
+    auto content=new ChatMessageContent(msg);
+    content->setChatMessage(msg);
+
+    auto body=new ChatMessageText();
+    body->loadText(QString("Message %1").arg(data.id),false);
+
+    auto bottom=new ChatMessageBottom(content);
+    bottom->setTimeString(data.dateTime.toString("hh:mm"));
+
+    content->setWidgets(body,nullptr,bottom);
+    msg->setContent(content);
+
+    return message;
+}
+
+/**
+ * Messages 1..10 with sort values 10..100.
+ * Messages 1 and 2 are dated a day before the others, messages 7..10 are unread.
+ */
+TestMessageData messageData(int id)
+{
+    auto day=QDate::currentDate().addDays(-10);
+    if (id>2)
+    {
+        day=day.addDays(1);
+    }
+
+    TestMessageData data;
+    data.id=id;
+    data.sortValue=id*10;
+    data.dateTime=QDateTime{day,QTime{12,id}};
+    data.unread=id>=7;
+    return data;
+}
+
+constexpr static const int MessageCount=10;
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestChatMessagesView)
+
+BOOST_AUTO_TEST_CASE(TestUpdateOutOfLoadedRange)
+{
+    auto init=[](ChatMessagesViewContainerPtr container){
+        ChatMessagesViewContainer::PlayStepPeriod=200;
+        ChatTextLayoutPool::instance().setEnabled(false);
+
+        auto view=new TestMessagesView();
+        view->setMessageBuilder(buildMessage);
+        ChatMessagesViewContainer::beginTestCase(container,view,"Test updating ChatMessagesView");
+    };
+
+    auto load=[](ChatMessagesViewContainerPtr container){
+        auto view=container->testWidget;
+
+        std::vector<TestMessageData> items;
+        for (int i=1;i<=MessageCount;i++)
+        {
+            items.push_back(messageData(i));
+        }
+        view->loadMessages(items);
+
+        for (int i=1;i<=MessageCount;i++)
+        {
+            UISE_TEST_REQUIRE(view->message(i)!=nullptr);
+        }
+        UISE_TEST_CHECK(view->message(1)->isDateSeparatorVisible());
+        UISE_TEST_CHECK(view->message(3)->isDateSeparatorVisible());
+        UISE_TEST_CHECK(!view->message(4)->isDateSeparatorVisible());
+        UISE_TEST_CHECK(view->message(7)->isUnreadSeparatorVisible());
+    };
+
+    auto moveBeforeFirst=[](ChatMessagesViewContainerPtr container){
+        auto view=container->testWidget;
+
+        // the list sticks to the end, message sorted before the first loaded one is unloaded,
+        // the message is unread but it must not take the unread separator
+        auto data=messageData(3);
+        data.sortValue=1;
+        data.unread=true;
+        view->updateMessage(data);
+
+        UISE_TEST_CHECK(view->message(3)==nullptr);
+        UISE_TEST_CHECK(view->listView()->item(3)==nullptr);
+    };
+
+    auto checkSeparators=[](ChatMessagesViewContainerPtr container){
+        auto view=container->testWidget;
+
+        // former neighbours of the unloaded message
+        UISE_TEST_REQUIRE(view->message(2)!=nullptr);
+        UISE_TEST_REQUIRE(view->message(4)!=nullptr);
+        UISE_TEST_CHECK(!view->message(2)->isDateSeparatorVisible());
+        UISE_TEST_CHECK(view->message(4)->isDateSeparatorVisible());
+        UISE_TEST_CHECK(view->message(1)->isDateSeparatorVisible());
+
+        for (int i=1;i<=MessageCount;i++)
+        {
+            auto msg=view->message(i);
+            if (msg!=nullptr)
+            {
+                UISE_TEST_CHECK_EQUAL(msg->isUnreadSeparatorVisible(),i==7);
+            }
+        }
+    };
+
+    auto moveInside=[](ChatMessagesViewContainerPtr container){
+        auto view=container->testWidget;
+
+        // message stays loaded when moved within the loaded range, it becomes the first unread one
+        auto data=messageData(5);
+        data.sortValue=65;
+        data.unread=true;
+        view->updateMessage(data);
+
+        UISE_TEST_REQUIRE(view->message(5)!=nullptr);
+        UISE_TEST_CHECK(view->message(5)->isUnreadSeparatorVisible());
+        UISE_TEST_CHECK(!view->message(7)->isUnreadSeparatorVisible());
+        UISE_TEST_CHECK(!view->message(5)->isDateSeparatorVisible());
+        UISE_TEST_CHECK(!view->message(6)->isDateSeparatorVisible());
+    };
+
+    std::vector<std::function<void (ChatMessagesViewContainerPtr container)>> steps={
+        init,
+        load,
+        moveBeforeFirst,
+        checkSeparators,
+        moveInside
+    };
+    ChatMessagesViewContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
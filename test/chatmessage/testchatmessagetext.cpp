@@ -0,0 +1,96 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/chatmessage/testchatmessagetext.cpp
+*
+*  Test ChatMessageText.
+*
+*/
+
+/****************************************************************************/
+
+#include <QTextDocument>
+#include <QScopeGuard>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/test/uise-testutils.hpp>
+
+#include <uise/desktop/chatmessagetext.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+using ChatMessageTextContainer=TestWidgetContainer<ChatMessageText>;
+using ChatMessageTextContainerPtr=std::shared_ptr<ChatMessageTextContainer>;
+
+namespace {
+
+int documentCount(ChatMessageText* widget)
+{
+    auto browser=widget->findChild<ChatMessageTextBrowser*>();
+    if (browser==nullptr)
+    {
+        return -1;
+    }
+    return static_cast<int>(browser->findChildren<QTextDocument*>(QString{},Qt::FindDirectChildrenOnly).size());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestChatMessageText)
+
+BOOST_AUTO_TEST_CASE(TestPreparedDocuments)
+{
+    // the pool is process-wide, restore it for other test cases even if this one fails or times out
+    auto restorePool=qScopeGuard([](){
+        ChatTextLayoutPool::instance().setEnabled(false);
+    });
+
+    auto init=[](ChatMessageTextContainerPtr container){
+        ChatMessageTextContainer::PlayStepPeriod=200;
+        ChatTextLayoutPool::instance().setEnabled(true);
+        auto text=new ChatMessageText();
+        ChatMessageTextContainer::beginTestCase(container,text,"Test ChatMessageText prepared documents");
+    };
+
+    int loadIndex=0;
+    auto load=[&loadIndex](ChatMessageTextContainerPtr container){
+        auto text=container->testWidget;
+        text->loadText(QString("Message **%1**").arg(loadIndex++));
+    };
+
+    auto check=[](ChatMessageTextContainerPtr container){
+        auto text=container->testWidget;
+
+        // previous documents are released when the next one is attached
+        UISE_TEST_CHECK_EQUAL(documentCount(text),1);
+        UISE_TEST_CHECK(text->findChild<ChatMessageTextBrowser*>()->toPlainText()==QString("Message 4"));
+    };
+
+    std::vector<std::function<void (ChatMessageTextContainerPtr container)>> steps={
+        init,
+        load,
+        load,
+        load,
+        load,
+        load,
+        check
+    };
+    ChatMessageTextContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
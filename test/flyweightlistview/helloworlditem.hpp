@@ -81,6 +81,11 @@ class HelloWorldItem : public QFrame
             return m_id;
         }
 
+        void setId(size_t value)
+        {
+            m_id=value;
+        }
+
         void setSeqNum(size_t value)
         {
             m_seqNum=value;
@@ -0,0 +1,202 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/flyweightlistview/testfwlvbulkinsert.cpp
+*
+*  Test and benchmark of bulk insertion of items into FlyweightListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+
+#include <uise/desktop/utils/destroywidget.hpp>
+#include <uise/desktop/linkedlistview.hpp>
+
+#include "fwlvtestwidget.hpp"
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestFlyWeightListView)
+
+namespace {
+
+constexpr static const size_t BulkItemCount=1000;
+
+using HashedIdFlwListType=FlyweightListView<HelloWorldItemWrapper,ComparerWithOrder,HashedIdIndex<>>;
+
+std::vector<HelloWorldItemWrapper> makeItems(size_t from, size_t count, size_t step)
+{
+    std::vector<HelloWorldItemWrapper> items;
+    items.reserve(count);
+    for (size_t i=0;i<count;i++)
+    {
+        auto seqNum=from+i*step;
+        items.emplace_back(HelloWorldItemWrapper(new HelloWorldItem(seqNum,seqNum)));
+    }
+    return items;
+}
+
+//! Items are sorted both in the view and in the linked list of widgets, and each widget is found at its position.
+template <typename ListT>
+void checkOrder(ListT* view, size_t expectedCount)
+{
+    UISE_TEST_REQUIRE_EQUAL(view->itemCount(),expectedCount);
+
+    auto llist=qobject_cast<LinkedListView*>(view->itemsParentWidget());
+    UISE_TEST_REQUIRE(llist!=nullptr);
+
+    size_t pos=0;
+    size_t prevSeqNum=0;
+    bool ok=true;
+    view->eachItem(
+        [&](const HelloWorldItemWrapper* item)
+        {
+            if ((pos!=0 && item->sortValue()<=prevSeqNum)
+                || llist->widgetAtSeqPos(pos)!=item->widget()
+                || llist->widgetAtPos(item->widget()->geometry().center())!=item->widget()
+               )
+            {
+                ok=false;
+                return false;
+            }
+            prevSeqNum=item->sortValue();
+            ++pos;
+            return true;
+        }
+    );
+    UISE_TEST_CHECK(ok);
+    UISE_TEST_CHECK_EQUAL(pos,expectedCount);
+    UISE_TEST_CHECK(llist->widgetAtSeqPos(expectedCount)==nullptr);
+}
+
+template <typename FnT>
+double measureUsPerItem(FnT&& fn, size_t count)
+{
+    auto start=std::chrono::steady_clock::now();
+    fn();
+    auto end=std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::micro>(end-start).count()/count;
+}
+
+template <typename ListT>
+void checkBulkInsert()
+{
+    auto view=new ListT();
+    view->resize(600,800);
+    view->setFlyweightEnabled(false);
+
+    // load sorted items
+    auto loaded=makeItems(0,BulkItemCount,2);
+    auto loadCost=measureUsPerItem([&](){view->loadItems(loaded);},BulkItemCount);
+    checkOrder(view,BulkItemCount);
+
+    // insert shuffled items interleaving with loaded ones
+    auto interleaved=makeItems(1,BulkItemCount,2);
+    std::shuffle(interleaved.begin(),interleaved.end(),std::mt19937(12345));
+    auto bulkCost=measureUsPerItem([&](){view->insertItems(interleaved);},BulkItemCount);
+    checkOrder(view,2*BulkItemCount);
+
+    // the same with single item insertions
+    auto singles=makeItems(2*BulkItemCount,BulkItemCount,1);
+    std::shuffle(singles.begin(),singles.end(),std::mt19937(54321));
+    auto singleCost=measureUsPerItem(
+        [&]()
+        {
+            view->beginUpdate();
+            for (const auto& item: singles)
+            {
+                view->insertItem(item,false);
+            }
+            view->endUpdate();
+        },
+        BulkItemCount
+    );
+    checkOrder(view,3*BulkItemCount);
+
+    // append page of sorted items
+    auto page=makeItems(10*BulkItemCount,BulkItemCount,1);
+    auto appendCost=measureUsPerItem([&](){view->insertContinuousItems(page);},BulkItemCount);
+    checkOrder(view,4*BulkItemCount);
+
+    // replacing items with the same IDs keeps one item per ID
+    auto replaced=makeItems(0,10,2);
+    view->insertItems(replaced);
+    checkOrder(view,4*BulkItemCount);
+
+    // items are found by IDs
+    bool found=true;
+    for (size_t i=0;i<2*BulkItemCount;i++)
+    {
+        auto item=view->item(i);
+        if (item==nullptr || item->id()!=i)
+        {
+            found=false;
+            break;
+        }
+    }
+    UISE_TEST_CHECK(found);
+    UISE_TEST_CHECK(view->item(4*BulkItemCount)==nullptr);
+
+    // removed items are not found
+    view->removeItems({1});
+    UISE_TEST_CHECK(view->item(1)==nullptr);
+    UISE_TEST_CHECK_EQUAL(view->itemCount(),4*BulkItemCount-1);
+
+    BOOST_TEST_MESSAGE("FlyweightListView bulk insert of " << BulkItemCount << " items, us per item:"
+                       << " loadItems " << loadCost
+                       << ", insertItems interleaved " << bulkCost
+                       << ", insertItem one by one " << singleCost
+                       << ", insertContinuousItems appended " << appendCost
+                       );
+
+    QTimer::singleShot(
+        0,
+        view,
+        [view]
+        {
+            destroyWidget(view);
+            TestThread::instance()->continueTest();
+        }
+    );
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TestBulkInsert)
+{
+    TestThread::instance()->postGuiThread(checkBulkInsert<FlwListType>);
+    auto ret=TestThread::instance()->execTest(60000);
+    UISE_TEST_CHECK(ret);
+}
+
+BOOST_AUTO_TEST_CASE(TestBulkInsertHashedId)
+{
+    TestThread::instance()->postGuiThread(checkBulkInsert<HashedIdFlwListType>);
+    auto ret=TestThread::instance()->execTest(60000);
+    UISE_TEST_CHECK(ret);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/flyweightlistview/testfwlvrecycling.cpp
+*
+*  Test recycling widgets of FlyweightListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <QCoreApplication>
+
+#include <uise/test/uise-testthread.hpp>
+
+#include "fwlvtestwidget.hpp"
+#include "fwlvtestcontext.hpp"
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestFlyWeightListView)
+
+namespace {
+
+constexpr static const size_t RecyclingLimit=10;
+
+bool ReuseWidgets=true;
+size_t ReusedWidgetCount=0;
+
+HelloWorldItem* makeItem(FwlvTestContext* ctx, size_t seqNum)
+{
+    auto id=ctx->testWidget->pimpl->items[seqNum];
+    auto widget=ReuseWidgets?ctx->view->takeRecycledWidget<HelloWorldItem>():nullptr;
+    if (widget==nullptr)
+    {
+        return new HelloWorldItem(seqNum,id);
+    }
+
+    ++ReusedWidgetCount;
+    UISE_TEST_CHECK(widget->isHidden());
+    UISE_TEST_CHECK(widget->parentWidget()==ctx->view->itemsParentWidget());
+    widget->setId(id);
+    widget->setSeqNum(seqNum);
+    return widget;
+}
+
+void requestItems(FwlvTestContext* ctx, const HelloWorldItemWrapper* item, size_t itemCount, Direction direction)
+{
+    const auto& items=ctx->testWidget->pimpl->items;
+
+    size_t from=0;
+    size_t to=itemCount;
+    if (item!=nullptr)
+    {
+        auto idx=item->sortValue();
+        if (direction==Direction::END)
+        {
+            from=idx+1;
+            to=std::min(idx+1+itemCount,items.size());
+        }
+        else
+        {
+            from=idx>itemCount?idx-itemCount:0;
+            to=idx;
+        }
+    }
+
+    std::vector<HelloWorldItemWrapper> newItems;
+    for (size_t i=from;i<to;i++)
+    {
+        newItems.emplace_back(HelloWorldItemWrapper(makeItem(ctx,i)));
+    }
+    ctx->view->insertContinuousItems(newItems);
+}
+
+std::vector<HelloWorldItem*> pooledWidgets(FwlvTestContext* ctx)
+{
+    // dropped widgets are hidden too until they are deleted
+    QCoreApplication::sendPostedEvents(nullptr,QEvent::DeferredDelete);
+
+    std::vector<HelloWorldItem*> widgets;
+    for (auto widget : ctx->view->itemsParentWidget()->findChildren<HelloWorldItem*>())
+    {
+        if (widget->isHidden())
+        {
+            widgets.push_back(widget);
+        }
+    }
+    return widgets;
+}
+
+void scrollRepeatedly(FwlvTestContext* ctx, int times, std::function<void ()> done)
+{
+    if (times==0)
+    {
+        done();
+        return;
+    }
+
+    // scroll by the whole loaded range so that the items left behind are trimmed
+    ctx->view->scroll(ctx->itemSize().height()*static_cast<int>(ctx->view->itemCount()));
+    QTimer::singleShot(FwlvTestContext::PlayStepPeriod,ctx->mainWindow,
+    [ctx,times,done]()
+    {
+        scrollRepeatedly(ctx,times-1,done);
+    });
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TestWidgetRecycling)
+{
+    auto handler=[](FwlvTestContext* ctx)
+    {
+        ReuseWidgets=true;
+        ReusedWidgetCount=0;
+
+        ctx->view->setWidgetRecyclingLimit(RecyclingLimit);
+        ctx->view->setRequestItemsCb(
+            [ctx](const HelloWorldItemWrapper* item, size_t itemCount, Direction direction)
+            {
+                requestItems(ctx,item,itemCount,direction);
+            }
+        );
+        ctx->testWidget->loadItems();
+
+        QTimer::singleShot(FwlvTestContext::PlayStepPeriod,ctx->mainWindow,
+        [ctx]()
+        {
+            UISE_TEST_CHECK_EQUAL(ctx->view->recycledWidgetCount(),0);
+
+            scrollRepeatedly(ctx,4,
+            [ctx]()
+            {
+                // widgets of trimmed items were picked up by new items
+                UISE_TEST_CHECK(ReusedWidgetCount>0);
+                UISE_TEST_CHECK(ctx->view->recycledWidgetCount()<=RecyclingLimit);
+
+                // stop reusing so that the pool fills up to the limit
+                ReuseWidgets=false;
+                scrollRepeatedly(ctx,4,
+                [ctx]()
+                {
+                    auto count=ctx->view->recycledWidgetCount();
+                    UISE_TEST_CHECK(count>0);
+                    UISE_TEST_CHECK(count<=RecyclingLimit);
+
+                    auto pooled=pooledWidgets(ctx);
+                    UISE_TEST_REQUIRE_EQUAL(pooled.size(),count);
+
+                    // widget destroyed while kept in the pool is neither counted nor dropped again
+                    delete pooled.front();
+                    UISE_TEST_CHECK_EQUAL(ctx->view->recycledWidgetCount(),count-1);
+
+                    ctx->view->setWidgetRecyclingLimit(1);
+                    UISE_TEST_CHECK(ctx->view->recycledWidgetCount()<=1);
+                    UISE_TEST_CHECK(pooledWidgets(ctx).size()<=1);
+
+                    ctx->view->setWidgetRecyclingLimit(0);
+                    UISE_TEST_CHECK_EQUAL(ctx->view->recycledWidgetCount(),0);
+
+                    ctx->endTestCase();
+                });
+            });
+        });
+    };
+
+    FwlvTestContext::execSingleMode(handler,Qt::Vertical,Direction::HOME,true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -91,6 +91,30 @@ void checkSettersGetters(FlwListType* view)
     UISE_TEST_CHECK_EQUAL(view->isWheelHorizontaScrollEnabled(),true);
     view->setWheelHorizontalScrollEnabled(false);
     UISE_TEST_CHECK_EQUAL(view->isWheelHorizontaScrollEnabled(),false);
+
+    UISE_TEST_CHECK_EQUAL(view->isSmoothScrollingEnabled(),false);
+    view->setSmoothScrollingEnabled(true);
+    UISE_TEST_CHECK_EQUAL(view->isSmoothScrollingEnabled(),true);
+
+    UISE_TEST_CHECK_EQUAL(view->isAdaptivePrefetchEnabled(),false);
+    view->setAdaptivePrefetchEnabled(true);
+    UISE_TEST_CHECK_EQUAL(view->isAdaptivePrefetchEnabled(),true);
+    view->prefetchPolicy().setMaxScreens(5.0);
+    UISE_TEST_CHECK_EQUAL(view->prefetchPolicy().maxScreens(),5.0);
+
+    UISE_TEST_CHECK_EQUAL(view->widgetRecyclingLimit(),0);
+    view->setWidgetRecyclingLimit(10);
+    UISE_TEST_CHECK_EQUAL(view->widgetRecyclingLimit(),10);
+    UISE_TEST_CHECK_EQUAL(view->recycledWidgetCount(),0);
+    UISE_TEST_CHECK(view->takeRecycledWidget()==nullptr);
+
+    UISE_TEST_CHECK_EQUAL(view->estimatedItemCount(),0);
+    UISE_TEST_CHECK_EQUAL(view->estimatedItemExtent(),ScrollPositionEstimator::DefaultItemExtent);
+    view->setItemIndexCb([](const HelloWorldItemWrapper*){return size_t(0);});
+    view->setEstimatedItemCount(100);
+    UISE_TEST_CHECK_EQUAL(view->estimatedItemCount(),100);
+    view->setEstimatedItemCount(0);
+    UISE_TEST_CHECK_EQUAL(view->estimatedItemCount(),0);
 }
 }
 
@@ -0,0 +1,211 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/linkedlistview/testlinkedlistview.cpp
+*
+*  Test LinkedListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <numeric>
+
+#include <QFrame>
+#include <QVBoxLayout>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/test/uise-testutils.hpp>
+
+#include <uise/desktop/linkedlistview.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+using LinkedListViewContainer=TestWidgetContainer<LinkedListView>;
+using LinkedListViewContainerPtr=std::shared_ptr<LinkedListViewContainer>;
+
+namespace {
+
+//! Item whose height is set by a fixed height child managed by a layout.
+class Item : public QFrame
+{
+    public:
+
+        explicit Item(int height)
+        {
+            auto l=new QVBoxLayout(this);
+            l->setContentsMargins(0,0,0,0);
+            l->setSpacing(0);
+            m_content=new QWidget(this);
+            l->addWidget(m_content);
+            setItemHeight(height);
+        }
+
+        void setItemHeight(int height)
+        {
+            m_content->setFixedHeight(height);
+        }
+
+    private:
+
+        QWidget* m_content;
+};
+
+int verticalMargins(const LinkedListView* view)
+{
+    auto m=view->contentsMargins();
+    return m.top()+m.bottom();
+}
+
+void checkOrder(const LinkedListView* view, const std::vector<Item*>& expected)
+{
+    for (size_t i=0;i<expected.size();i++)
+    {
+        UISE_TEST_CHECK(view->widgetAtSeqPos(i)==expected[i]);
+        UISE_TEST_CHECK_EQUAL(view->widgetSeqPos(expected[i]),i);
+        UISE_TEST_CHECK(view->containsWidget(expected[i]));
+    }
+    UISE_TEST_CHECK(view->widgetAtSeqPos(expected.size())==nullptr);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestLinkedListView)
+
+BOOST_AUTO_TEST_CASE(TestIncrementalResize)
+{
+    std::vector<Item*> items;
+    std::vector<int> heights{20,30,40,50,60};
+
+    auto init=[&](LinkedListViewContainerPtr container){
+        LinkedListViewContainer::PlayStepPeriod=200;
+        auto view=new LinkedListView();
+        view->setIncrementalRelayout(true);
+        LinkedListViewContainer::beginTestCase(container,view,"Test LinkedListView incremental resize");
+
+        std::vector<QWidget*> widgets;
+        for (auto height : heights)
+        {
+            items.push_back(new Item(height));
+            widgets.push_back(items.back());
+        }
+        view->insertWidgetsAfter(widgets,nullptr);
+    };
+
+    auto checkHint=[&](LinkedListViewContainerPtr container){
+        auto view=container->testWidget;
+        int total=0;
+        for (size_t i=0;i<items.size();i++)
+        {
+            UISE_TEST_CHECK_EQUAL(items[i]->geometry().top(),view->contentsRect().top()+total);
+            UISE_TEST_CHECK_EQUAL(items[i]->height(),heights[i]);
+            total+=heights[i];
+        }
+        UISE_TEST_CHECK_EQUAL(view->sizeHint().height(),total+verticalMargins(view));
+    };
+
+    auto resize=[&](LinkedListViewContainerPtr){
+        // only the item itself is notified, the view must pick up the change from its event filter
+        heights[2]=100;
+        items[2]->setItemHeight(heights[2]);
+    };
+
+    std::vector<std::function<void (LinkedListViewContainerPtr container)>> steps={
+        init,
+        checkHint,
+        resize,
+        checkHint
+    };
+    LinkedListViewContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_CASE(TestNodePool)
+{
+    std::vector<Item*> items;
+    std::vector<Item*> expected;
+    std::vector<int> heights{10,20,30,40,50};
+
+    auto init=[&](LinkedListViewContainerPtr container){
+        LinkedListViewContainer::PlayStepPeriod=200;
+        auto view=new LinkedListView();
+        LinkedListViewContainer::beginTestCase(container,view,"Test LinkedListView node pool");
+
+        for (auto height : heights)
+        {
+            items.push_back(new Item(height));
+        }
+
+        view->insertWidgetsAfter({items[0],items[1],items[2]},nullptr);
+        view->insertWidgetAfter(items[3],items[2]);
+        view->insertWidgetBefore(items[4],items[0]);
+        expected={items[4],items[0],items[1],items[2],items[3]};
+        checkOrder(view,expected);
+
+        // taken widgets release their nodes
+        view->takeWidget(items[1]);
+        view->takeWidget(items[4]);
+        UISE_TEST_CHECK(!view->containsWidget(items[1]));
+        UISE_TEST_CHECK(!view->containsWidget(items[4]));
+        UISE_TEST_CHECK(items[1]->isHidden());
+        expected={items[0],items[2],items[3]};
+        checkOrder(view,expected);
+
+        // re-inserted widgets reuse released nodes
+        view->insertWidgetAfter(items[1],items[3]);
+        view->insertWidgetBefore(items[4],items[2]);
+        expected={items[0],items[4],items[2],items[3],items[1]};
+        checkOrder(view,expected);
+
+        // move the first widget to the end, alternately taking it out and reordering it in place
+        for (size_t i=0;i<20;i++)
+        {
+            auto first=expected.front();
+            if (i%2==0)
+            {
+                view->takeWidget(first);
+            }
+            view->insertWidgetAfter(first,expected.back());
+            std::rotate(expected.begin(),expected.begin()+1,expected.end());
+            checkOrder(view,expected);
+        }
+    };
+
+    auto checkLayout=[&](LinkedListViewContainerPtr container){
+        auto view=container->testWidget;
+        checkOrder(view,expected);
+
+        int total=0;
+        for (auto item : expected)
+        {
+            UISE_TEST_CHECK(item->isVisible());
+            UISE_TEST_CHECK_EQUAL(item->geometry().top(),view->contentsRect().top()+total);
+            total+=item->height();
+        }
+        UISE_TEST_CHECK_EQUAL(total,std::accumulate(heights.begin(),heights.end(),0));
+        UISE_TEST_CHECK_EQUAL(view->sizeHint().height(),total+verticalMargins(view));
+    };
+
+    std::vector<std::function<void (LinkedListViewContainerPtr container)>> steps={
+        init,
+        checkLayout
+    };
+    LinkedListViewContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
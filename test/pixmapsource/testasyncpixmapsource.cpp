@@ -0,0 +1,263 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/pixmapsource/testasyncpixmapsource.cpp
+*
+*  Test AsyncPixmapSource.
+*
+*/
+
+/****************************************************************************/
+
+#include <QCoreApplication>
+#include <QFrame>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/test/uise-testutils.hpp>
+
+#include <uise/desktop/asyncpixmapsource.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+using PixmapSourceContainer=TestWidgetContainer<QFrame>;
+using PixmapSourceContainerPtr=std::shared_ptr<PixmapSourceContainer>;
+
+namespace {
+
+class TestSource : public AsyncPixmapSource
+{
+    public:
+
+        explicit TestSource(QString dir) : m_dir(std::move(dir))
+        {}
+
+        //! Number of started decodings, the file name is resolved once per decoding.
+        mutable int decodeCount=0;
+
+        //! Number of evaluated priorities.
+        mutable int priorityCount=0;
+
+    protected:
+
+        QString imageFileName(const PixmapKey& key) const override
+        {
+            decodeCount++;
+            return QString("%1/%2.png").arg(m_dir,QString::fromStdString(key.toFilePath().string()));
+        }
+
+        int loadPriority(const PixmapKey& key) const override
+        {
+            priorityCount++;
+            return AsyncPixmapSource::loadPriority(key);
+        }
+
+    private:
+
+        QString m_dir;
+};
+
+void writeImage(const QTemporaryDir& dir, const QString& name, const QSize& size)
+{
+    QImage image(size,QImage::Format_RGB32);
+    image.fill(Qt::darkCyan);
+    image.save(dir.filePath(name+".png"));
+}
+
+QSize pixmapSize(const std::unique_ptr<PixmapConsumer>& consumer)
+{
+    auto producer=consumer->pixmapProducer();
+    if (producer==nullptr)
+    {
+        return QSize{};
+    }
+    return producer->pixmap().size();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestAsyncPixmapSource)
+
+BOOST_AUTO_TEST_CASE(TestDecodeSize)
+{
+    QTemporaryDir dir;
+    std::shared_ptr<TestSource> source;
+    std::unique_ptr<PixmapConsumer> consumer;
+    int updatedCount=0;
+
+    const QSize imageSize{1000,400};
+    const QSize requestedSize{64,32};
+    const auto expectedSize=imageSize.scaled(requestedSize,Qt::KeepAspectRatio);
+
+    auto init=[&](PixmapSourceContainerPtr container){
+        PixmapSourceContainer::PlayStepPeriod=300;
+        auto frame=new QFrame();
+        PixmapSourceContainer::beginTestCase(container,frame,"Test AsyncPixmapSource decoding at requested size");
+
+        writeImage(dir,"photo",imageSize);
+        auto fileName=dir.filePath("photo.png");
+
+        // decoder scales down keeping aspect ratio and never scales up
+        UISE_TEST_CHECK(AsyncPixmapSource::readImage(fileName,requestedSize).size()==expectedSize);
+        UISE_TEST_CHECK(AsyncPixmapSource::readImage(fileName,QSize{2000,2000}).size()==imageSize);
+        UISE_TEST_CHECK(AsyncPixmapSource::readImage(fileName,QSize{}).size()==imageSize);
+
+        source=std::make_shared<TestSource>(dir.path());
+        consumer=std::make_unique<PixmapConsumer>(std::string{"photo"},requestedSize,frame);
+        QObject::connect(consumer.get(),&PixmapConsumer::pixmapUpdated,frame,
+            [&updatedCount]()
+            {
+                updatedCount++;
+            }
+        );
+        consumer->setPixmapSource(source);
+        UISE_TEST_CHECK_EQUAL(source->pendingCount(),static_cast<size_t>(1));
+    };
+
+    auto wait=[](PixmapSourceContainerPtr){
+    };
+
+    auto check=[&](PixmapSourceContainerPtr){
+        UISE_TEST_CHECK_EQUAL(source->pendingCount(),static_cast<size_t>(0));
+        UISE_TEST_CHECK_EQUAL(source->decodeCount,1);
+
+        // decoded image is delivered to the consumer
+        UISE_TEST_CHECK(updatedCount>0);
+        UISE_TEST_CHECK(pixmapSize(consumer)==expectedSize);
+
+        consumer.reset();
+    };
+
+    std::vector<std::function<void (PixmapSourceContainerPtr container)>> steps={
+        init,
+        wait,
+        check
+    };
+    PixmapSourceContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_CASE(TestPriorityRanking)
+{
+    const int count=16;
+    QTemporaryDir dir;
+    std::shared_ptr<TestSource> source;
+    std::vector<std::unique_ptr<PixmapConsumer>> consumers;
+
+    auto init=[&](PixmapSourceContainerPtr container){
+        PixmapSourceContainer::PlayStepPeriod=300;
+        auto frame=new QFrame();
+        PixmapSourceContainer::beginTestCase(container,frame,"Test AsyncPixmapSource priority ranking");
+
+        source=std::make_shared<TestSource>(dir.path());
+        source->setMaxThreadCount(1);
+        source->setPriorityRefreshInterval(60000);
+
+        // all requests are made within one iteration of the event loop
+        for (int i=0;i<count;i++)
+        {
+            auto name=QString("image%1").arg(i);
+            writeImage(dir,name,QSize{64,64});
+            consumers.emplace_back(std::make_unique<PixmapConsumer>(name.toStdString(),QSize{32,32},frame));
+            consumers.back()->setPixmapSource(source);
+        }
+        UISE_TEST_CHECK_EQUAL(source->pendingCount(),static_cast<size_t>(count));
+    };
+
+    auto wait=[](PixmapSourceContainerPtr){
+    };
+
+    auto check=[&](PixmapSourceContainerPtr){
+        UISE_TEST_CHECK_EQUAL(source->pendingCount(),static_cast<size_t>(0));
+        UISE_TEST_CHECK_EQUAL(source->decodeCount,count);
+
+        // the queue is ranked once, not every time a decoding finishes
+        UISE_TEST_CHECK_EQUAL(source->priorityCount,count);
+
+        for (const auto& consumer : consumers)
+        {
+            UISE_TEST_CHECK(!pixmapSize(consumer).isEmpty());
+        }
+
+        consumers.clear();
+    };
+
+    std::vector<std::function<void (PixmapSourceContainerPtr container)>> steps={
+        init,
+        wait,
+        wait,
+        wait,
+        check
+    };
+    PixmapSourceContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_CASE(TestMergeRunning)
+{
+    QTemporaryDir dir;
+    std::shared_ptr<TestSource> source;
+    std::unique_ptr<PixmapConsumer> small;
+    std::unique_ptr<PixmapConsumer> large;
+
+    auto init=[&](PixmapSourceContainerPtr container){
+        PixmapSourceContainer::PlayStepPeriod=300;
+        auto frame=new QFrame();
+        PixmapSourceContainer::beginTestCase(container,frame,"Test AsyncPixmapSource merging running requests");
+
+        // large enough to be still decoding when the small key is requested again
+        writeImage(dir,"photo",QSize{1600,1600});
+        source=std::make_shared<TestSource>(dir.path());
+
+        small=std::make_unique<PixmapConsumer>(std::string{"photo"},QSize{32,32},frame);
+        large=std::make_unique<PixmapConsumer>(std::string{"photo"},QSize{64,64},frame);
+        small->setPixmapSource(source);
+        large->setPixmapSource(source);
+
+        // run the queued dispatch only, both sizes are decoded by one job
+        QCoreApplication::sendPostedEvents(qApp,QEvent::MetaCall);
+        UISE_TEST_CHECK_EQUAL(source->decodeCount,1);
+
+        // release and request the small key again while the job is running
+        small->resetPixmapProducer();
+        small->acquireProducer();
+        UISE_TEST_CHECK_EQUAL(source->pendingCount(),static_cast<size_t>(2));
+    };
+
+    auto wait=[](PixmapSourceContainerPtr){
+    };
+
+    auto check=[&](PixmapSourceContainerPtr){
+        UISE_TEST_CHECK_EQUAL(source->pendingCount(),static_cast<size_t>(0));
+        UISE_TEST_CHECK_EQUAL(source->decodeCount,1);
+        UISE_TEST_CHECK(pixmapSize(small)==QSize(32,32));
+        UISE_TEST_CHECK(pixmapSize(large)==QSize(64,64));
+
+        small.reset();
+        large.reset();
+    };
+
+    std::vector<std::function<void (PixmapSourceContainerPtr container)>> steps={
+        init,
+        wait,
+        wait,
+        check
+    };
+    PixmapSourceContainer::runTestCase(steps);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
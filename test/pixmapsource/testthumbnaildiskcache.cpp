@@ -0,0 +1,165 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/pixmapsource/testthumbnaildiskcache.cpp
+*
+*  Test ThumbnailDiskCache.
+*
+*/
+
+/****************************************************************************/
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <uise/test/uise-testthread.hpp>
+
+#include <uise/desktop/thumbnaildiskcache.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+namespace {
+
+constexpr static const qint64 HeaderSize=32;
+constexpr static const qint64 WidthOffset=16;
+constexpr static const qint64 BytesPerLineOffset=24;
+
+QImage makeImage(int width, int height)
+{
+    QImage image(width,height,QImage::Format_ARGB32_Premultiplied);
+    for (int y=0;y<height;y++)
+    {
+        for (int x=0;x<width;x++)
+        {
+            image.setPixel(x,y,qRgba(x*20,y*30,(x+y)*10,255));
+        }
+    }
+    return image;
+}
+
+void patchFile(const QString& fileName, qint64 offset, qint32 value)
+{
+    QFile file{fileName};
+    UISE_TEST_REQUIRE(file.open(QIODevice::ReadWrite));
+    file.seek(offset);
+    file.write(reinterpret_cast<const char*>(&value),sizeof(value));
+}
+
+qint64 directorySize(const QString& directory)
+{
+    qint64 total=0;
+    for (const auto& info : QDir{directory}.entryInfoList(QDir::Files))
+    {
+        total+=info.size();
+    }
+    return total;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestThumbnailDiskCache)
+
+BOOST_AUTO_TEST_CASE(TestRoundTrip)
+{
+    QTemporaryDir dir;
+    ThumbnailDiskCache cache{dir.filePath("thumbs")};
+    PixmapKey key{std::string{"photo"},QSize{10,7}};
+    auto image=makeImage(10,7);
+
+    UISE_TEST_CHECK(cache.load(key,1).isNull());
+    UISE_TEST_REQUIRE(cache.store(key,1,image));
+
+    auto loaded=cache.load(key,1);
+    UISE_TEST_REQUIRE(!loaded.isNull());
+    UISE_TEST_CHECK(loaded.size()==image.size());
+    UISE_TEST_CHECK(loaded.convertToFormat(image.format())==image);
+
+    // stale fingerprint and another size are misses
+    UISE_TEST_CHECK(cache.load(key,2).isNull());
+    UISE_TEST_CHECK(cache.load(PixmapKey{std::string{"photo"},QSize{20,14}},1).isNull());
+
+    cache.remove(key);
+    UISE_TEST_CHECK(cache.load(key,1).isNull());
+}
+
+BOOST_AUTO_TEST_CASE(TestCorruptHeader)
+{
+    QTemporaryDir dir;
+    ThumbnailDiskCache cache{dir.filePath("thumbs")};
+    PixmapKey key{std::string{"photo"},QSize{10,7}};
+    auto image=makeImage(10,7);
+    auto fileName=cache.fileName(key);
+
+    // width*4 overflows 32 bits and would pass the check of bytes per line
+    UISE_TEST_REQUIRE(cache.store(key,1,image));
+    patchFile(fileName,WidthOffset,0x40000001);
+    UISE_TEST_CHECK(cache.load(key,1).isNull());
+
+    // pixels do not match the size of the file
+    UISE_TEST_REQUIRE(cache.store(key,1,image));
+    patchFile(fileName,BytesPerLineOffset,image.bytesPerLine()*2);
+    UISE_TEST_CHECK(cache.load(key,1).isNull());
+
+    // truncated file
+    UISE_TEST_REQUIRE(cache.store(key,1,image));
+    UISE_TEST_REQUIRE(QFile::resize(fileName,HeaderSize+image.bytesPerLine()));
+    UISE_TEST_CHECK(cache.load(key,1).isNull());
+
+    // bad magic
+    UISE_TEST_REQUIRE(cache.store(key,1,image));
+    patchFile(fileName,0,0);
+    UISE_TEST_CHECK(cache.load(key,1).isNull());
+
+    // restored entry is valid again
+    UISE_TEST_REQUIRE(cache.store(key,1,image));
+    UISE_TEST_CHECK(!cache.load(key,1).isNull());
+}
+
+BOOST_AUTO_TEST_CASE(TestTrim)
+{
+    QTemporaryDir dir;
+    auto directory=dir.filePath("thumbs");
+    auto image=makeImage(16,16);
+    auto entrySize=HeaderSize+image.sizeInBytes();
+    auto maxBytes=entrySize*4;
+
+    // entries of the previous run are counted on the first write
+    {
+        ThumbnailDiskCache cache{directory,0};
+        for (int i=0;i<10;i++)
+        {
+            UISE_TEST_REQUIRE(cache.store(PixmapKey{std::to_string(i),QSize{16,16}},1,image));
+        }
+        UISE_TEST_CHECK_EQUAL(directorySize(directory),entrySize*10);
+    }
+
+    ThumbnailDiskCache cache{directory,maxBytes};
+    UISE_TEST_CHECK_EQUAL(cache.maxBytes(),maxBytes);
+    for (int i=10;i<30;i++)
+    {
+        UISE_TEST_REQUIRE(cache.store(PixmapKey{std::to_string(i),QSize{16,16}},1,image));
+        UISE_TEST_CHECK(directorySize(directory)<=maxBytes);
+    }
+
+    cache.trim(0);
+    UISE_TEST_CHECK_EQUAL(directorySize(directory),0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
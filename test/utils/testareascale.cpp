@@ -0,0 +1,249 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testareascale.cpp
+*
+*  Test of area-averaging downscaler.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <QImage>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/areascale.hpp>
+#include <uise/desktop/utils/pixmapscale.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+namespace {
+
+std::uint32_t pixel(int c0, int c1, int c2, int c3)
+{
+    return static_cast<std::uint32_t>(c0)
+            | (static_cast<std::uint32_t>(c1)<<8)
+            | (static_cast<std::uint32_t>(c2)<<16)
+            | (static_cast<std::uint32_t>(c3)<<24);
+}
+
+int channel(std::uint32_t px, int c)
+{
+    return static_cast<int>((px>>(c*8))&0xff);
+}
+
+void scale(const std::vector<std::uint32_t>& src, int srcWidth, int srcHeight, const AreaScaleRect& rect,
+           std::vector<std::uint32_t>& dst, int dstWidth, int dstHeight, std::uint32_t orMask=0)
+{
+    dst.assign(static_cast<size_t>(dstWidth)*dstHeight,0);
+    areaScale32(reinterpret_cast<const std::uint8_t*>(src.data()),srcWidth*4,srcWidth,srcHeight,
+                rect,
+                reinterpret_cast<std::uint8_t*>(dst.data()),dstWidth*4,dstWidth,dstHeight,
+                orMask);
+}
+
+QImage gradientImage(int width, int height)
+{
+    QImage image{width,height,QImage::Format_RGB32};
+    for (int y=0;y<height;y++)
+    {
+        auto line=reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x=0;x<width;x++)
+        {
+            line[x]=qRgb(x*255/width,y*255/height,(x+y)*255/(width+height));
+        }
+    }
+    return image;
+}
+
+int maxDifference(const QImage& left, const QImage& right)
+{
+    int diff=0;
+    for (int y=0;y<left.height();y++)
+    {
+        auto l=reinterpret_cast<const QRgb*>(left.constScanLine(y));
+        auto r=reinterpret_cast<const QRgb*>(right.constScanLine(y));
+        for (int x=0;x<left.width();x++)
+        {
+            diff=std::max(diff,std::abs(qRed(l[x])-qRed(r[x])));
+            diff=std::max(diff,std::abs(qGreen(l[x])-qGreen(r[x])));
+            diff=std::max(diff,std::abs(qBlue(l[x])-qBlue(r[x])));
+        }
+    }
+    return diff;
+}
+
+template <typename FnT>
+double measureMs(FnT&& fn, int repeat)
+{
+    auto start=std::chrono::steady_clock::now();
+    for (int i=0;i<repeat;i++)
+    {
+        fn();
+    }
+    auto end=std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::milli>(end-start).count()/repeat;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestAreaScale)
+
+BOOST_AUTO_TEST_CASE(TestBoxAverage)
+{
+    std::vector<std::uint32_t> src{
+        pixel(0,10,20,255),   pixel(100,30,40,255),  pixel(8,8,8,8),     pixel(8,8,8,8),
+        pixel(200,50,60,255), pixel(100,70,80,255),  pixel(16,16,16,16), pixel(16,16,16,16)
+    };
+    std::vector<std::uint32_t> dst;
+    scale(src,4,2,AreaScaleRect{0,0,4,2},dst,2,1);
+
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],0),100);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],1),40);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],2),50);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],3),255);
+    UISE_TEST_CHECK(dst[1]==pixel(12,12,12,12));
+
+    // same size is an exact copy
+    scale(src,4,2,AreaScaleRect{0,0,4,2},dst,4,2);
+    UISE_TEST_CHECK(dst==src);
+}
+
+BOOST_AUTO_TEST_CASE(TestFractionalCoverage)
+{
+    // each destination pixel covers one and a half source pixels
+    std::vector<std::uint32_t> src{pixel(0,0,0,0),pixel(90,90,90,90),pixel(180,180,180,180)};
+    std::vector<std::uint32_t> dst;
+    scale(src,3,1,AreaScaleRect{0,0,3,1},dst,2,1);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],0),30);
+    UISE_TEST_CHECK_EQUAL(channel(dst[1],0),150);
+
+    // crop starting in the middle of a pixel
+    scale(src,3,1,AreaScaleRect{0.5,0,2,1},dst,1,1);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],3),90);
+    scale(src,3,1,AreaScaleRect{1,0,2,1},dst,1,1);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],3),135);
+
+    // rectangle outside of the source is clamped
+    scale(src,3,1,AreaScaleRect{2,0,4,1},dst,1,1);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],1),180);
+
+    // opaque mask
+    scale(src,3,1,AreaScaleRect{0,0,3,1},dst,1,1,0xff000000u);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],0),90);
+    UISE_TEST_CHECK_EQUAL(channel(dst[0],3),255);
+}
+
+BOOST_AUTO_TEST_CASE(TestLargeUniform)
+{
+    // rows of odd lengths go through both vector and tail loops
+    const int width=1037;
+    const int height=517;
+    std::vector<std::uint32_t> src(static_cast<size_t>(width)*height,pixel(37,250,0,255));
+    std::vector<std::uint32_t> dst;
+    scale(src,width,height,AreaScaleRect{0,0,width,height},dst,333,97);
+    for (auto px : dst)
+    {
+        UISE_TEST_REQUIRE(px==pixel(37,250,0,255));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestCropAndPad)
+{
+    QImage src{40,20,QImage::Format_RGB32};
+    src.fill(QColor(Qt::blue));
+    src.setPixelColor(0,0,QColor(Qt::red));
+
+    // letterboxed content in the middle of the canvas
+    auto canvas=areaScaledOnCanvas(src,QRectF(src.rect()),QSize(20,20),QRect(0,5,20,10));
+    UISE_TEST_REQUIRE(canvas.size()==QSize(20,20));
+    UISE_TEST_CHECK(canvas.format()==QImage::Format_ARGB32_Premultiplied);
+    UISE_TEST_CHECK_EQUAL(canvas.pixel(10,2),0u);
+    UISE_TEST_CHECK_EQUAL(canvas.pixel(10,17),0u);
+    UISE_TEST_CHECK(canvas.pixelColor(10,10)==QColor(Qt::blue));
+    UISE_TEST_CHECK(canvas.pixelColor(19,14)==QColor(Qt::blue));
+
+    // pillarboxed content
+    canvas=areaScaledOnCanvas(src,QRectF(src.rect()),QSize(30,10),QRect(5,0,20,10));
+    UISE_TEST_CHECK_EQUAL(canvas.pixel(2,5),0u);
+    UISE_TEST_CHECK_EQUAL(canvas.pixel(27,5),0u);
+    UISE_TEST_CHECK(canvas.pixelColor(15,5)==QColor(Qt::blue));
+
+    // cropped part does not bleed into the result
+    auto cropped=areaScaledImage(src,QSize(10,10),QRectF(10,0,20,20));
+    UISE_TEST_REQUIRE(cropped.size()==QSize(10,10));
+    UISE_TEST_CHECK(cropped.format()==QImage::Format_RGB32);
+    UISE_TEST_CHECK(cropped.pixelColor(0,0)==QColor(Qt::blue));
+
+    // target outside of the canvas
+    UISE_TEST_CHECK(areaScaledOnCanvas(src,QRectF(src.rect()),QSize(10,10),QRect(5,5,10,10)).isNull());
+}
+
+// benchmark is disabled by default, run it explicitly with --run_test=TestAreaScale/TestBenchmarkVsQtSmooth
+BOOST_AUTO_TEST_CASE(TestBenchmarkVsQtSmooth,*boost::unit_test::disabled())
+{
+    struct Case
+    {
+        QSize source;
+        QSize target;
+    };
+    // camera photo to a chat bubble and a reply chip, screenshot to a preview, avatar to a list icon
+    std::vector<Case> cases{
+        {QSize(4032,3024),QSize(1080,810)},
+        {QSize(4032,3024),QSize(96,72)},
+        {QSize(1920,1080),QSize(480,270)},
+        {QSize(512,512),QSize(80,80)}
+    };
+
+    for (const auto& c : cases)
+    {
+        auto src=gradientImage(c.source.width(),c.source.height());
+        int repeat=c.source.width()*c.source.height()>4000000 ? 3 : 10;
+
+        QImage area;
+        auto areaMs=measureMs([&]()
+        {
+            area=areaScaledImage(src,c.target);
+        },repeat);
+        QImage smooth;
+        auto smoothMs=measureMs([&]()
+        {
+            smooth=src.scaled(c.target,Qt::IgnoreAspectRatio,Qt::SmoothTransformation);
+        },repeat);
+
+        UISE_TEST_REQUIRE(area.size()==c.target);
+        UISE_TEST_REQUIRE(smooth.size()==c.target);
+        UISE_TEST_CHECK(maxDifference(area,smooth)<=8);
+
+        BOOST_TEST_MESSAGE("Area scale (" << areaScaleInstructionSet() << ") vs Qt smooth scale "
+                           << c.source.width() << "x" << c.source.height() << " -> "
+                           << c.target.width() << "x" << c.target.height() << ", ms: "
+                           << areaMs << " / " << smoothMs
+                           );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
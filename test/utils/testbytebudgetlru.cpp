@@ -0,0 +1,115 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testbytebudgetlru.cpp
+*
+*  Test of ByteBudgetLru used for limiting memory of cached pixmaps.
+*
+*/
+
+/****************************************************************************/
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/bytebudgetlru.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestByteBudgetLru)
+
+BOOST_AUTO_TEST_CASE(TestAccounting)
+{
+    ByteBudgetLru<std::string> lru;
+    lru.insert("a",100);
+    lru.insert("b",200);
+    UISE_TEST_CHECK_EQUAL(lru.size(),2);
+    UISE_TEST_CHECK_EQUAL(lru.totalBytes(),300);
+
+    lru.setBytes("a",150);
+    UISE_TEST_CHECK_EQUAL(lru.totalBytes(),350);
+
+    // inserting existing entry updates it
+    lru.insert("b",50);
+    UISE_TEST_CHECK_EQUAL(lru.size(),2);
+    UISE_TEST_CHECK_EQUAL(lru.totalBytes(),200);
+
+    lru.erase("a");
+    UISE_TEST_CHECK(!lru.contains("a"));
+    UISE_TEST_CHECK_EQUAL(lru.totalBytes(),50);
+
+    // no budget, nothing is evicted
+    lru.setPinned("b",false);
+    lru.insert("c",1000000,false);
+    UISE_TEST_CHECK(!lru.isOverBudget());
+    UISE_TEST_CHECK(lru.evict().empty());
+
+    lru.recordHit();
+    lru.recordMiss();
+    lru.recordMiss();
+    UISE_TEST_CHECK_EQUAL(lru.stats().hits,1);
+    UISE_TEST_CHECK_EQUAL(lru.stats().misses,2);
+
+    lru.clear();
+    UISE_TEST_CHECK_EQUAL(lru.size(),0);
+    UISE_TEST_CHECK_EQUAL(lru.totalBytes(),0);
+}
+
+BOOST_AUTO_TEST_CASE(TestEviction)
+{
+    ByteBudgetLru<int> lru;
+    lru.setBudget(250);
+
+    for (int i=0;i<5;i++)
+    {
+        lru.insert(i,100,false);
+    }
+    // 2 is in use
+    lru.setPinned(2,true);
+    // 0 was used recently
+    lru.touch(0);
+    UISE_TEST_CHECK(lru.isOverBudget());
+
+    auto evicted=lru.evict();
+    UISE_TEST_REQUIRE(evicted.size()==3);
+    UISE_TEST_CHECK_EQUAL(evicted[0],1);
+    UISE_TEST_CHECK_EQUAL(evicted[1],3);
+    UISE_TEST_CHECK_EQUAL(evicted[2],4);
+    UISE_TEST_CHECK(lru.contains(0));
+    UISE_TEST_CHECK(lru.contains(2));
+    UISE_TEST_CHECK_EQUAL(lru.totalBytes(),200);
+    UISE_TEST_CHECK_EQUAL(lru.stats().evictions,3);
+
+    // pinned entries stay even if they exceed the budget
+    lru.setBytes(2,1000);
+    evicted=lru.evict();
+    UISE_TEST_REQUIRE(evicted.size()==1);
+    UISE_TEST_CHECK_EQUAL(evicted[0],0);
+    UISE_TEST_CHECK(lru.isOverBudget());
+    UISE_TEST_CHECK(lru.evict().empty());
+
+    lru.setPinned(2,false);
+    evicted=lru.evict();
+    UISE_TEST_REQUIRE(evicted.size()==1);
+    UISE_TEST_CHECK_EQUAL(lru.size(),0);
+    UISE_TEST_CHECK_EQUAL(lru.stats().evictions,5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
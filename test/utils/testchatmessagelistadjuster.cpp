@@ -0,0 +1,306 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testchatmessagelistadjuster.cpp
+*
+*  Test of incremental evaluation of separators and batches in ChatMessageListAdjuster.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/chatmessagelistadjuster.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestChatMessageListAdjuster)
+
+namespace {
+
+constexpr static const int Today=1000;
+
+struct TestMessage
+{
+    int seq=0;
+    int day=0;
+    int sender=0;
+    bool unread=false;
+
+    bool dateSeparator=false;
+    bool unreadSeparator=false;
+    bool firstInBatch=false;
+    bool lastInBatch=false;
+
+    bool sameFlags(const TestMessage& other) const
+    {
+        return dateSeparator==other.dateSeparator
+               && unreadSeparator==other.unreadSeparator
+               && firstInBatch==other.firstInBatch
+               && lastInBatch==other.lastInBatch;
+    }
+};
+
+struct TestMessageList
+{
+    using Message=TestMessage;
+
+    std::vector<std::unique_ptr<TestMessage>> messages;
+
+    size_t indexOf(const Message* msg) const
+    {
+        auto it=std::find_if(messages.begin(),messages.end(),[msg](const auto& m){return m.get()==msg;});
+        return static_cast<size_t>(std::distance(messages.begin(),it));
+    }
+
+    Message* prev(Message* msg) const
+    {
+        auto idx=indexOf(msg);
+        return idx==0?nullptr:messages[idx-1].get();
+    }
+
+    Message* next(Message* msg) const
+    {
+        auto idx=indexOf(msg);
+        return idx+1>=messages.size()?nullptr:messages[idx+1].get();
+    }
+
+    Message* last() const
+    {
+        return messages.empty()?nullptr:messages.back().get();
+    }
+
+    bool isBefore(const Message* l, const Message* r) const
+    {
+        return l->seq<r->seq;
+    }
+
+    void updateDateSeparator(Message* msg, Message* prev)
+    {
+        msg->dateSeparator=prev==nullptr?msg->day!=Today:prev->day!=msg->day;
+    }
+
+    bool isUnread(Message* msg) const
+    {
+        return msg->unread;
+    }
+
+    bool isUnreadSeparatorVisible(Message* msg) const
+    {
+        return msg->unreadSeparator;
+    }
+
+    void setUnreadSeparatorVisible(Message* msg, bool enable)
+    {
+        msg->unreadSeparator=enable;
+    }
+
+    bool isTopSeparatorVisible(Message* msg) const
+    {
+        return msg->dateSeparator || msg->unreadSeparator;
+    }
+
+    bool sameSender(Message* prev, Message* next) const
+    {
+        return prev->sender==next->sender;
+    }
+
+    void setFirstInBatch(Message* msg, bool enable)
+    {
+        msg->firstInBatch=enable;
+    }
+
+    void setLastInBatch(Message* msg, bool enable)
+    {
+        msg->lastInBatch=enable;
+    }
+
+    std::vector<Message*> all() const
+    {
+        std::vector<Message*> result;
+        for (const auto& msg : messages)
+        {
+            result.push_back(msg.get());
+        }
+        return result;
+    }
+
+    Message* insert(const TestMessage& msg)
+    {
+        auto it=std::upper_bound(messages.begin(),messages.end(),msg.seq,[](int seq, const auto& m){return seq<m->seq;});
+        return messages.insert(it,std::make_unique<TestMessage>(msg))->get();
+    }
+};
+
+using Adjuster=ChatMessageListAdjuster<TestMessageList>;
+
+//! Compare flags of the incrementally evaluated list with the flags evaluated by full pass over a copy of the list.
+bool sameAsFullPass(const TestMessageList& list, TestMessage* unreadHolder)
+{
+    TestMessageList ref;
+    for (const auto& msg : list.messages)
+    {
+        ref.messages.push_back(std::make_unique<TestMessage>(*msg));
+    }
+    auto refHolder=Adjuster::adjust(ref,ref.all());
+
+    if ((refHolder==nullptr)!=(unreadHolder==nullptr))
+    {
+        return false;
+    }
+    if (refHolder!=nullptr && refHolder->seq!=unreadHolder->seq)
+    {
+        return false;
+    }
+    for (size_t i=0;i<list.messages.size();i++)
+    {
+        if (!list.messages[i]->sameFlags(*ref.messages[i]))
+        {
+            BOOST_TEST_MESSAGE("Mismatch at message " << i << " seq " << list.messages[i]->seq);
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TestFullPass)
+{
+    TestMessageList list;
+    list.insert({1,Today-1,1,false});
+    list.insert({2,Today-1,1,false});
+    list.insert({3,Today,2,true});
+    list.insert({4,Today,2,true});
+    list.insert({5,Today,1,true});
+
+    auto holder=Adjuster::adjust(list,list.all());
+    UISE_TEST_REQUIRE(holder!=nullptr);
+    UISE_TEST_CHECK_EQUAL(holder->seq,3);
+
+    const auto& m=list.messages;
+    UISE_TEST_CHECK(m[0]->dateSeparator);
+    UISE_TEST_CHECK(!m[1]->dateSeparator);
+    UISE_TEST_CHECK(m[2]->dateSeparator);
+    UISE_TEST_CHECK(!m[3]->dateSeparator);
+
+    UISE_TEST_CHECK(m[0]->firstInBatch);
+    UISE_TEST_CHECK(!m[0]->lastInBatch);
+    UISE_TEST_CHECK(!m[1]->firstInBatch);
+    UISE_TEST_CHECK(m[1]->lastInBatch);
+    UISE_TEST_CHECK(m[2]->firstInBatch);
+    UISE_TEST_CHECK(!m[2]->lastInBatch);
+    UISE_TEST_CHECK(m[3]->lastInBatch);
+    UISE_TEST_CHECK(m[4]->firstInBatch);
+    UISE_TEST_CHECK(m[4]->lastInBatch);
+
+    // the only unread message is the last one
+    TestMessageList list2;
+    list2.insert({1,Today,1,false});
+    list2.insert({2,Today,1,true});
+    UISE_TEST_CHECK(Adjuster::adjust(list2,list2.all())==nullptr);
+
+    // a message appended after it moves the unread separator there
+    auto appended=list2.insert({3,Today,1,false});
+    holder=Adjuster::adjustAround(list2,{appended},nullptr);
+    UISE_TEST_REQUIRE(holder!=nullptr);
+    UISE_TEST_CHECK_EQUAL(holder->seq,2);
+    UISE_TEST_CHECK(sameAsFullPass(list2,holder));
+}
+
+BOOST_AUTO_TEST_CASE(TestIncrementalAgainstFullPass)
+{
+    std::mt19937 rng(2026);
+    auto randomMessage=[&rng](int seq)
+    {
+        TestMessage msg;
+        msg.seq=seq;
+        msg.day=Today-static_cast<int>(rng()%3);
+        msg.sender=static_cast<int>(rng()%3);
+        msg.unread=(rng()%3)==0;
+        return msg;
+    };
+
+    for (size_t round=0;round<20;round++)
+    {
+        TestMessageList list;
+        for (size_t i=0;i<20;i++)
+        {
+            list.insert(randomMessage(static_cast<int>(rng()%100000)));
+        }
+        auto holder=Adjuster::adjust(list,list.all());
+        UISE_TEST_REQUIRE(sameAsFullPass(list,holder));
+
+        bool ok=true;
+        for (size_t step=0;step<200 && ok;step++)
+        {
+            std::vector<TestMessage*> touched;
+            auto op=rng()%4;
+            if (list.messages.size()<3 || op<2)
+            {
+                // insert a batch of messages either anywhere or after the last message
+                auto count=1+rng()%4;
+                for (size_t i=0;i<count;i++)
+                {
+                    int seq=(op==0 && !list.messages.empty())
+                            ?list.messages.back()->seq+1+static_cast<int>(rng()%5)
+                            :static_cast<int>(rng()%100000);
+                    touched.push_back(list.insert(randomMessage(seq)));
+                }
+            }
+            else
+            {
+                // remove a message and touch its neighbours
+                auto idx=rng()%list.messages.size();
+                auto removed=list.messages[idx].get();
+                auto prev=list.prev(removed);
+                auto next=list.next(removed);
+                bool wasHolder=removed==holder;
+                list.messages.erase(list.messages.begin()+idx);
+                if (wasHolder)
+                {
+                    // same as ChatMessagesView, fall back to the full pass when the holder is gone
+                    holder=Adjuster::adjust(list,list.all());
+                    ok=sameAsFullPass(list,holder);
+                    continue;
+                }
+                if (prev!=nullptr)
+                {
+                    touched.push_back(prev);
+                }
+                if (next!=nullptr)
+                {
+                    touched.push_back(next);
+                }
+            }
+
+            holder=Adjuster::adjustAround(list,touched,holder);
+            ok=sameAsFullPass(list,holder);
+        }
+        UISE_TEST_CHECK(ok);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testiconmodetable.cpp
+*
+*  Test of IconModeTable.
+*
+*/
+
+/****************************************************************************/
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/iconmodetable.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestIconModeTable)
+
+BOOST_AUTO_TEST_CASE(TestFixedAndOverflow)
+{
+    IconModeTable<std::string> table;
+    UISE_TEST_CHECK(table.empty());
+    UISE_TEST_CHECK(table.find(0)==nullptr);
+    UISE_TEST_CHECK(table.find(0x100,1)==nullptr);
+
+    // fixed slots
+    table.set(0,0,"normal-off");
+    table.set(0,1,"normal-on");
+    table.set(5,1,"checked-hovered-on");
+    UISE_TEST_CHECK_EQUAL(table.size(),3);
+    UISE_TEST_REQUIRE(table.find(0,0)!=nullptr);
+    UISE_TEST_CHECK_EQUAL(*table.find(0,0),"normal-off");
+    UISE_TEST_CHECK_EQUAL(*table.find(0,1),"normal-on");
+    UISE_TEST_CHECK_EQUAL(*table.find(5,1),"checked-hovered-on");
+    UISE_TEST_CHECK(table.find(5,0)==nullptr);
+
+    // user modes and negative modes go to overflow
+    table.set(0x100,0,"user-off");
+    table.set(0x101,1,"user1-on");
+    table.set(-1,0,"negative");
+    UISE_TEST_CHECK_EQUAL(table.size(),6);
+    UISE_TEST_CHECK_EQUAL(*table.find(0x100,0),"user-off");
+    UISE_TEST_CHECK(table.find(0x100,1)==nullptr);
+    UISE_TEST_CHECK_EQUAL(*table.find(0x101,1),"user1-on");
+    UISE_TEST_CHECK_EQUAL(*table.find(-1,0),"negative");
+
+    // replace
+    table.set(0x100,0,"user-off-2");
+    table.value(0,0)="normal-off-2";
+    UISE_TEST_CHECK_EQUAL(table.size(),6);
+    UISE_TEST_CHECK_EQUAL(*table.find(0x100,0),"user-off-2");
+    UISE_TEST_CHECK_EQUAL(*table.find(0,0),"normal-off-2");
+
+    // default value is inserted
+    UISE_TEST_CHECK(table.value(3,0).empty());
+    UISE_TEST_CHECK(table.find(3,0)!=nullptr);
+    UISE_TEST_CHECK_EQUAL(table.size(),7);
+
+    std::map<std::pair<int,int>,std::string> all;
+    table.forEach(
+        [&all](int mode, int state, const std::string& value)
+        {
+            all.emplace(std::make_pair(mode,state),value);
+        }
+    );
+    UISE_TEST_CHECK_EQUAL(all.size(),7);
+    UISE_TEST_CHECK_EQUAL(all[std::make_pair(5,1)],"checked-hovered-on");
+    UISE_TEST_CHECK_EQUAL(all[std::make_pair(0x101,1)],"user1-on");
+
+    // erase
+    UISE_TEST_CHECK(table.erase(0,1));
+    UISE_TEST_CHECK(!table.erase(0,1));
+    UISE_TEST_CHECK(table.erase(0x101,1));
+    UISE_TEST_CHECK(!table.erase(0x101,1));
+    UISE_TEST_CHECK(table.find(0,1)==nullptr);
+    UISE_TEST_CHECK(table.find(0x101,1)==nullptr);
+    UISE_TEST_CHECK_EQUAL(table.size(),5);
+
+    // slot is reset on erase
+    UISE_TEST_CHECK(table.value(0,1).empty());
+
+    table.clear();
+    UISE_TEST_CHECK(table.empty());
+    UISE_TEST_CHECK(table.find(5,1)==nullptr);
+    UISE_TEST_CHECK(table.find(0x100,0)==nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestSingleState)
+{
+    IconModeTable<int,1> table;
+    table.set(1,0,10);
+    table.set(0x200,0,20);
+    UISE_TEST_CHECK_EQUAL(*table.find(1),10);
+    UISE_TEST_CHECK_EQUAL(*table.find(0x200),20);
+    UISE_TEST_CHECK(table.find(2)==nullptr);
+    UISE_TEST_CHECK_EQUAL(table.size(),2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testimagemipchain.cpp
+*
+*  Test of ImageMipChain used for downscaling images to multiple sizes.
+*
+*/
+
+/****************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <QImage>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/pixmapscale.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestImageMipChain)
+
+BOOST_AUTO_TEST_CASE(TestLevels)
+{
+    QImage image{1000,600,QImage::Format_RGB32};
+    image.fill(Qt::red);
+
+    ImageMipChain chain{image,QSize{100,100}};
+
+    // 1000x600, 500x300, 250x150, 125x75 is below the smallest size
+    UISE_TEST_CHECK_EQUAL(chain.levelCount(),3);
+    UISE_TEST_CHECK(chain.original().size()==QSize(1000,600));
+
+    UISE_TEST_CHECK(chain.level(QSize(600,300)).size()==QSize(1000,600));
+    UISE_TEST_CHECK(chain.level(QSize(500,300)).size()==QSize(500,300));
+    UISE_TEST_CHECK(chain.level(QSize(200,120)).size()==QSize(250,150));
+    UISE_TEST_CHECK(chain.level(QSize(10,10)).size()==QSize(250,150));
+
+    auto scaled=chain.scaled(QSize(200,200));
+    UISE_TEST_CHECK(scaled.size()==QSize(200,120));
+    UISE_TEST_CHECK(scaled.pixelColor(100,60)==QColor(Qt::red));
+
+    scaled=chain.scaled(QSize(200,200),Qt::KeepAspectRatioByExpanding);
+    UISE_TEST_CHECK(scaled.size()==QSize(333,200));
+
+    // exact level is returned without scaling
+    scaled=chain.scaled(QSize(500,500));
+    UISE_TEST_CHECK(scaled.size()==QSize(500,300));
+
+    // no minimal size, only the original
+    ImageMipChain single{image,QSize{}};
+    UISE_TEST_CHECK_EQUAL(single.levelCount(),1);
+    UISE_TEST_CHECK(single.scaled(QSize(100,100)).size()==QSize(100,60));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testkineticscroller.cpp
+*
+*  Test of KineticScroller used for smooth scrolling of FlyweightListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/kineticscroller.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestKineticScroller)
+
+namespace {
+
+int runFrames(KineticScroller& scroller, size_t maxFrames, size_t* frames=nullptr)
+{
+    int total=0;
+    size_t count=0;
+    while (scroller.isActive() && count<maxFrames)
+    {
+        total+=scroller.advance(KineticScroller::DefaultFrameInterval);
+        count++;
+    }
+    if (frames!=nullptr)
+    {
+        *frames=count;
+    }
+    return total;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TestSmoothDistance)
+{
+    KineticScroller scroller;
+    UISE_TEST_CHECK(!scroller.isActive());
+    UISE_TEST_CHECK_EQUAL(scroller.advance(KineticScroller::DefaultFrameInterval),0);
+
+    // distance is covered in several frames, the first frame moves the most
+    scroller.scrollBy(100);
+    UISE_TEST_CHECK(scroller.isActive());
+    auto first=scroller.advance(KineticScroller::DefaultFrameInterval);
+    UISE_TEST_CHECK_GT(first,0);
+    UISE_TEST_CHECK(first<100);
+    size_t frames=0;
+    auto rest=runFrames(scroller,1000,&frames);
+    UISE_TEST_CHECK_EQUAL(first+rest,100);
+    UISE_TEST_CHECK(frames<100);
+    UISE_TEST_CHECK(!scroller.isActive());
+
+    // distances in the same direction are accumulated
+    scroller.scrollBy(30);
+    scroller.scrollBy(30);
+    UISE_TEST_CHECK_EQUAL(runFrames(scroller,1000),60);
+
+    // reverse direction drops the rest of the previous distance
+    scroller.scrollBy(100);
+    first=scroller.advance(KineticScroller::DefaultFrameInterval);
+    scroller.scrollBy(-50);
+    UISE_TEST_CHECK_EQUAL(runFrames(scroller,1000),-50);
+
+    // fractions are carried over
+    for (size_t i=0;i<4;i++)
+    {
+        scroller.scrollBy(0.25);
+    }
+    UISE_TEST_CHECK_EQUAL(runFrames(scroller,1000),1);
+}
+
+BOOST_AUTO_TEST_CASE(TestPreciseDeltas)
+{
+    KineticScroller scroller;
+
+    // deltas received between frames are applied in a single frame
+    scroller.moveBy(3,0);
+    scroller.moveBy(4,1);
+    scroller.moveBy(5,2);
+    UISE_TEST_CHECK_EQUAL(scroller.advance(KineticScroller::DefaultFrameInterval),12);
+    UISE_TEST_CHECK(!scroller.isActive());
+
+    // slow gesture does not continue after release
+    double ts=1000;
+    for (size_t i=0;i<10;i++)
+    {
+        scroller.moveBy(1,ts);
+        ts+=16;
+    }
+    UISE_TEST_CHECK_EQUAL(scroller.advance(KineticScroller::DefaultFrameInterval),10);
+    UISE_TEST_CHECK(!scroller.release(ts));
+    UISE_TEST_CHECK_EQUAL(scroller.velocity(),0.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestFling)
+{
+    KineticScroller scroller;
+
+    double ts=1000;
+    for (size_t i=0;i<10;i++)
+    {
+        scroller.moveBy(-32,ts);
+        ts+=16;
+    }
+    UISE_TEST_CHECK_EQUAL(scroller.advance(KineticScroller::DefaultFrameInterval),-320);
+
+    // fast gesture continues with decaying velocity
+    UISE_TEST_CHECK(scroller.release(ts));
+    UISE_TEST_CHECK(scroller.velocity()<-1.9);
+    auto prev=scroller.advance(KineticScroller::DefaultFrameInterval);
+    UISE_TEST_CHECK(prev<0);
+    for (size_t i=0;i<10;i++)
+    {
+        auto step=scroller.advance(KineticScroller::DefaultFrameInterval);
+        UISE_TEST_CHECK(step>=prev);
+        UISE_TEST_CHECK(step<=0);
+        prev=step;
+    }
+    size_t frames=0;
+    auto rest=runFrames(scroller,10000,&frames);
+    UISE_TEST_CHECK(rest<0);
+    UISE_TEST_CHECK(frames<1000);
+    UISE_TEST_CHECK(!scroller.isActive());
+
+    // release long after the last delta does not fling
+    for (size_t i=0;i<10;i++)
+    {
+        scroller.moveBy(32,ts);
+        ts+=16;
+    }
+    scroller.advance(KineticScroller::DefaultFrameInterval);
+    UISE_TEST_CHECK(!scroller.release(ts+KineticScroller::VelocitySampleTimeout*2));
+
+    // new input and stop interrupt fling
+    for (size_t i=0;i<10;i++)
+    {
+        scroller.moveBy(32,ts);
+        ts+=16;
+    }
+    scroller.advance(KineticScroller::DefaultFrameInterval);
+    UISE_TEST_CHECK(scroller.release(ts));
+    scroller.scrollBy(-10);
+    UISE_TEST_CHECK_EQUAL(scroller.velocity(),0.0);
+    UISE_TEST_CHECK_EQUAL(runFrames(scroller,1000),-10);
+
+    for (size_t i=0;i<10;i++)
+    {
+        scroller.moveBy(32,ts);
+        ts+=16;
+    }
+    scroller.advance(KineticScroller::DefaultFrameInterval);
+    UISE_TEST_CHECK(scroller.release(ts));
+    scroller.stop();
+    UISE_TEST_CHECK(!scroller.isActive());
+    UISE_TEST_CHECK_EQUAL(scroller.advance(KineticScroller::DefaultFrameInterval),0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
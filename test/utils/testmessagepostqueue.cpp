@@ -0,0 +1,131 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testmessagepostqueue.cpp
+*
+*  Test of MessagePostQueue used for streaming changes of chat messages.
+*
+*/
+
+/****************************************************************************/
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/messagepostqueue.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestMessagePostQueue)
+
+BOOST_AUTO_TEST_CASE(TestCoalescing)
+{
+    MessagePostQueue<int,std::string> queue;
+    UISE_TEST_CHECK(queue.empty());
+
+    queue.postData(1,"a");
+    queue.postData(2,"b");
+    queue.postData(1,"a1");
+    queue.postReorder(2);
+    queue.postData(3,"c");
+    queue.postRemove(3);
+    queue.postRemove(4);
+    queue.postReorder(4);
+    UISE_TEST_CHECK_EQUAL(queue.size(),4);
+
+    auto ops=queue.take();
+    UISE_TEST_CHECK(queue.empty());
+    UISE_TEST_REQUIRE(ops.size()==4);
+
+    // operations are in the order of the first post
+    UISE_TEST_CHECK_EQUAL(ops[0].id,1);
+    UISE_TEST_CHECK_EQUAL(ops[0].data.value(),"a1");
+    UISE_TEST_CHECK(!ops[0].remove);
+    UISE_TEST_CHECK(!ops[0].reorder);
+
+    UISE_TEST_CHECK_EQUAL(ops[1].id,2);
+    UISE_TEST_CHECK_EQUAL(ops[1].data.value(),"b");
+    UISE_TEST_CHECK(ops[1].reorder);
+
+    UISE_TEST_CHECK_EQUAL(ops[2].id,3);
+    UISE_TEST_CHECK(!ops[2].data);
+    UISE_TEST_CHECK(ops[2].remove);
+
+    // reordering of removed message is ignored
+    UISE_TEST_CHECK_EQUAL(ops[3].id,4);
+    UISE_TEST_CHECK(ops[3].remove);
+    UISE_TEST_CHECK(!ops[3].reorder);
+
+    // data posted after removal brings the message back
+    queue.postRemove(5);
+    queue.postData(5,"e");
+    ops=queue.take();
+    UISE_TEST_REQUIRE(ops.size()==1);
+    UISE_TEST_CHECK(!ops[0].remove);
+    UISE_TEST_CHECK_EQUAL(ops[0].data.value(),"e");
+
+    const auto& stats=queue.stats();
+    UISE_TEST_CHECK_EQUAL(stats.posted,10);
+    UISE_TEST_CHECK_EQUAL(stats.coalesced,5);
+    UISE_TEST_CHECK_EQUAL(stats.committed,5);
+    UISE_TEST_CHECK_EQUAL(stats.commits,2);
+    UISE_TEST_CHECK_EQUAL(stats.maxPending,4);
+}
+
+BOOST_AUTO_TEST_CASE(TestLimitedTake)
+{
+    MessagePostQueue<int,int> queue;
+    for (int i=0;i<500;i++)
+    {
+        queue.postData(i%100,i);
+    }
+    UISE_TEST_CHECK_EQUAL(queue.size(),100);
+
+    auto ops=queue.take(60);
+    UISE_TEST_REQUIRE(ops.size()==60);
+    UISE_TEST_CHECK_EQUAL(ops.front().id,0);
+    UISE_TEST_CHECK_EQUAL(ops.front().data.value(),400);
+    UISE_TEST_CHECK_EQUAL(queue.size(),40);
+    UISE_TEST_CHECK_EQUAL(queue.stats().deferredCommits,1);
+
+    // taken message is queued again as a new operation
+    queue.postData(0,1000);
+    UISE_TEST_CHECK_EQUAL(queue.size(),41);
+
+    ops=queue.take(60);
+    UISE_TEST_REQUIRE(ops.size()==41);
+    UISE_TEST_CHECK_EQUAL(ops.front().id,60);
+    UISE_TEST_CHECK_EQUAL(ops.back().id,0);
+    UISE_TEST_CHECK(queue.take().empty());
+
+    queue.commitDone(5);
+    queue.commitDone(3);
+    const auto& stats=queue.stats();
+    UISE_TEST_CHECK_EQUAL(stats.commits,2);
+    UISE_TEST_CHECK_EQUAL(stats.deferredCommits,1);
+    UISE_TEST_CHECK_EQUAL(stats.committed,101);
+    UISE_TEST_CHECK_EQUAL(stats.lastCommitDuration,3);
+    UISE_TEST_CHECK_EQUAL(stats.maxCommitDuration,5);
+
+    queue.resetStats();
+    UISE_TEST_CHECK_EQUAL(queue.stats().posted,0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testmessageselection.cpp
+*
+*  Test of MessageSelection used for selected messages of ChatMessagesView.
+*
+*/
+
+/****************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/messageselection.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestMessageSelection)
+
+namespace {
+
+struct TestData
+{
+    std::string text;
+};
+
+struct TestMessage
+{
+    TestData msgData;
+    mutable size_t dataCalls=0;
+
+    const TestData& data() const
+    {
+        dataCalls++;
+        return msgData;
+    }
+};
+
+using Selection=MessageSelection<int,int,TestMessage,TestData>;
+
+std::vector<std::string> texts(const Selection& selection)
+{
+    std::vector<std::string> result;
+    selection.each(
+        [&result](const TestData& data)
+        {
+            result.push_back(data.text);
+            return true;
+        }
+    );
+    return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TestSelectDeselect)
+{
+    TestMessage m1{{"one"}};
+    TestMessage m2{{"two"}};
+    TestMessage m3{{"three"}};
+
+    Selection selection;
+    UISE_TEST_CHECK(selection.empty());
+
+    UISE_TEST_CHECK(selection.select(3,30,&m3));
+    UISE_TEST_CHECK(selection.select(1,10,&m1));
+    UISE_TEST_CHECK(selection.select(2,20,&m2));
+    UISE_TEST_CHECK(!selection.select(2,20,&m2));
+    UISE_TEST_CHECK_EQUAL(selection.size(),3);
+    UISE_TEST_CHECK(selection.contains(1));
+
+    // data is not touched until iterated
+    UISE_TEST_CHECK_EQUAL(m1.dataCalls,0);
+    UISE_TEST_CHECK(texts(selection)==(std::vector<std::string>{"one","two","three"}));
+
+    // iteration can be stopped
+    size_t count=0;
+    UISE_TEST_CHECK(!selection.each([&count](const TestData&){count++; return false;}));
+    UISE_TEST_CHECK_EQUAL(count,1);
+
+    UISE_TEST_CHECK(selection.deselect(2));
+    UISE_TEST_CHECK(!selection.deselect(2));
+    UISE_TEST_CHECK(!selection.contains(2));
+    UISE_TEST_CHECK(texts(selection)==(std::vector<std::string>{"one","three"}));
+
+    // reorder
+    selection.updateSortValue(1,40);
+    UISE_TEST_CHECK(texts(selection)==(std::vector<std::string>{"three","one"}));
+
+    selection.clear();
+    UISE_TEST_CHECK(selection.empty());
+    UISE_TEST_CHECK(texts(selection).empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestUnloadReload)
+{
+    TestMessage m1{{"one"}};
+    TestMessage m2{{"two"}};
+
+    Selection selection;
+    selection.select(1,10,&m1);
+    selection.select(2,20,&m2);
+
+    // not selected message is not copied
+    UISE_TEST_CHECK(!selection.unload(3));
+
+    // unloaded message keeps its data
+    UISE_TEST_CHECK(selection.unload(1));
+    UISE_TEST_CHECK_EQUAL(m1.dataCalls,1);
+    m1.msgData.text="changed";
+    UISE_TEST_CHECK(texts(selection)==(std::vector<std::string>{"one","two"}));
+
+    // unloading twice does not copy again
+    UISE_TEST_CHECK(selection.unload(1));
+    UISE_TEST_CHECK_EQUAL(m1.dataCalls,1);
+
+    // reloaded message is referred again
+    TestMessage m1Reloaded{{"reloaded"}};
+    UISE_TEST_CHECK(!selection.reload(3,30,&m1Reloaded));
+    UISE_TEST_CHECK(selection.reload(1,30,&m1Reloaded));
+    UISE_TEST_CHECK(texts(selection)==(std::vector<std::string>{"two","reloaded"}));
+    UISE_TEST_CHECK_EQUAL(selection.size(),2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
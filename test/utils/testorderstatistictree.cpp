@@ -0,0 +1,285 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testorderstatistictree.cpp
+*
+*  Test of OrderStatisticTree used as position index of LinkedListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/orderstatistictree.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+namespace {
+
+using Tree=OrderStatisticTree<int>;
+
+//! Every value is found at the same position as in the reference vector, in both directions.
+void checkAgainstReference(const Tree& tree, const std::vector<int>& reference, const std::vector<Tree::Handle>& handles)
+{
+    UISE_TEST_REQUIRE_EQUAL(tree.size(),reference.size());
+    for (size_t i=0;i<reference.size();i++)
+    {
+        auto h=tree.at(i);
+        UISE_TEST_REQUIRE(h!=Tree::Null);
+        UISE_TEST_CHECK_EQUAL(tree.value(h),reference[i]);
+        UISE_TEST_CHECK_EQUAL(tree.rank(handles[reference[i]]),i);
+    }
+    UISE_TEST_CHECK(tree.at(reference.size())==Tree::Null);
+}
+
+/**
+ * Former LinkedListViewItem scheme: every element stores its own position and inserting or
+ * removing an element renumbers all elements that follow it.
+ */
+struct LinearPosList
+{
+    struct Node
+    {
+        size_t pos;
+    };
+
+    std::list<Node> nodes;
+
+    std::list<Node>::iterator insertBefore(std::list<Node>::iterator it)
+    {
+        size_t pos=(it==nodes.end())?nodes.size():it->pos;
+        auto newIt=nodes.insert(it,Node{pos});
+        for (auto next=std::next(newIt);next!=nodes.end();++next)
+        {
+            next->pos++;
+        }
+        return newIt;
+    }
+
+    void erase(std::list<Node>::iterator it)
+    {
+        for (auto next=std::next(it);next!=nodes.end();++next)
+        {
+            next->pos--;
+        }
+        nodes.erase(it);
+    }
+};
+
+template <typename FnT>
+double measureMs(FnT&& fn)
+{
+    auto start=std::chrono::steady_clock::now();
+    fn();
+    auto end=std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::milli>(end-start).count();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestOrderStatisticTree)
+
+BOOST_AUTO_TEST_CASE(TestInsertErase)
+{
+    Tree tree;
+    UISE_TEST_CHECK(tree.empty());
+    UISE_TEST_CHECK(tree.at(0)==Tree::Null);
+
+    std::vector<int> reference;
+    std::vector<Tree::Handle> handles;
+
+    // append
+    for (int i=0;i<10;i++)
+    {
+        handles.push_back(tree.insertBefore(Tree::Null,i));
+        reference.push_back(i);
+    }
+    checkAgainstReference(tree,reference,handles);
+
+    // prepend
+    for (int i=10;i<20;i++)
+    {
+        handles.push_back(tree.insertAfter(Tree::Null,i));
+        reference.insert(reference.begin(),i);
+    }
+    checkAgainstReference(tree,reference,handles);
+
+    // insert in the middle relative to existing nodes
+    handles.push_back(tree.insertAfter(handles[5],20));
+    reference.insert(std::find(reference.begin(),reference.end(),5)+1,20);
+    handles.push_back(tree.insertBefore(handles[15],21));
+    reference.insert(std::find(reference.begin(),reference.end(),15),21);
+    checkAgainstReference(tree,reference,handles);
+
+    // erase
+    tree.erase(handles[0]);
+    reference.erase(std::find(reference.begin(),reference.end(),0));
+    tree.erase(handles[19]);
+    reference.erase(std::find(reference.begin(),reference.end(),19));
+    tree.erase(handles[20]);
+    reference.erase(std::find(reference.begin(),reference.end(),20));
+    checkAgainstReference(tree,reference,handles);
+    UISE_TEST_CHECK(!tree.contains(handles[0],0));
+    UISE_TEST_CHECK(tree.contains(handles[1],1));
+    UISE_TEST_CHECK(!tree.contains(handles[1],2));
+
+    tree.clear();
+    UISE_TEST_CHECK(tree.empty());
+    UISE_TEST_CHECK_EQUAL(tree.size(),0);
+}
+
+BOOST_AUTO_TEST_CASE(TestRandomOperations)
+{
+    Tree tree;
+    std::vector<int> reference;
+    std::vector<Tree::Handle> handles;
+    std::vector<int> live;
+
+    std::mt19937 rng(12345);
+    for (int step=0;step<5000;step++)
+    {
+        if (reference.empty() || rng()%3!=0)
+        {
+            int value=static_cast<int>(handles.size());
+            if (reference.empty())
+            {
+                handles.push_back(tree.insertAfter(Tree::Null,value));
+                reference.push_back(value);
+            }
+            else
+            {
+                size_t pos=rng()%reference.size();
+                auto existing=tree.at(pos);
+                UISE_TEST_REQUIRE_EQUAL(tree.value(existing),reference[pos]);
+                if (rng()%2==0)
+                {
+                    handles.push_back(tree.insertAfter(existing,value));
+                    reference.insert(reference.begin()+pos+1,value);
+                }
+                else
+                {
+                    handles.push_back(tree.insertBefore(existing,value));
+                    reference.insert(reference.begin()+pos,value);
+                }
+            }
+            live.push_back(value);
+        }
+        else
+        {
+            auto liveIdx=rng()%live.size();
+            auto value=live[liveIdx];
+            auto pos=tree.rank(handles[value]);
+            UISE_TEST_REQUIRE_EQUAL(reference[pos],value);
+            tree.erase(handles[value]);
+            reference.erase(reference.begin()+pos);
+            live.erase(live.begin()+liveIdx);
+        }
+    }
+
+    checkAgainstReference(tree,reference,handles);
+}
+
+BOOST_AUTO_TEST_CASE(TestBenchmarkVsLinearWalk)
+{
+    const int count=10000;
+
+    // prepend, as when loading history in front of already loaded messages
+    Tree tree;
+    std::vector<Tree::Handle> treeHandles;
+    auto treePrepend=measureMs([&]()
+    {
+        for (int i=0;i<count;i++)
+        {
+            treeHandles.push_back(tree.insertAfter(Tree::Null,i));
+        }
+    });
+    LinearPosList linear;
+    std::vector<std::list<LinearPosList::Node>::iterator> linearIts;
+    auto linearPrepend=measureMs([&]()
+    {
+        for (int i=0;i<count;i++)
+        {
+            linearIts.push_back(linear.insertBefore(linear.nodes.begin()));
+        }
+    });
+    UISE_TEST_CHECK_EQUAL(tree.rank(treeHandles.front()),linearIts.front()->pos);
+    UISE_TEST_CHECK_EQUAL(tree.rank(treeHandles.back()),linearIts.back()->pos);
+
+    // append
+    auto treeAppend=measureMs([&]()
+    {
+        for (int i=0;i<count;i++)
+        {
+            treeHandles.push_back(tree.insertBefore(Tree::Null,count+i));
+        }
+    });
+    auto linearAppend=measureMs([&]()
+    {
+        for (int i=0;i<count;i++)
+        {
+            linearIts.push_back(linear.insertBefore(linear.nodes.end()));
+        }
+    });
+    UISE_TEST_CHECK_EQUAL(tree.rank(treeHandles.back()),linearIts.back()->pos);
+
+    // remove from the front, as when the flyweight window slides forward
+    auto treeRemove=measureMs([&]()
+    {
+        for (int i=count-1;i>=0;i--)
+        {
+            tree.erase(treeHandles[i]);
+        }
+    });
+    auto linearRemove=measureMs([&]()
+    {
+        for (int i=count-1;i>=0;i--)
+        {
+            linear.erase(linearIts[i]);
+        }
+    });
+    UISE_TEST_CHECK_EQUAL(tree.size(),linear.nodes.size());
+    UISE_TEST_CHECK_EQUAL(tree.rank(treeHandles.back()),linearIts.back()->pos);
+
+    // positions lookup of every element
+    size_t treeSum=0;
+    auto treeLookup=measureMs([&]()
+    {
+        for (size_t i=0;i<tree.size();i++)
+        {
+            treeSum+=tree.rank(tree.at(i));
+        }
+    });
+    UISE_TEST_CHECK_EQUAL(treeSum,static_cast<size_t>(count)*(count-1)/2);
+
+    BOOST_TEST_MESSAGE("OrderStatisticTree vs linear renumbering, " << count << " elements, ms:"
+                       << " prepend " << treePrepend << " / " << linearPrepend
+                       << ", append " << treeAppend << " / " << linearAppend
+                       << ", remove " << treeRemove << " / " << linearRemove
+                       << ", rank+at lookup " << treeLookup
+                       );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
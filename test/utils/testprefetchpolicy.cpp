@@ -0,0 +1,174 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testprefetchpolicy.cpp
+*
+*  Test of PrefetchPolicy used for adaptive prefetching in FlyweightListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/prefetchpolicy.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestPrefetchPolicy)
+
+BOOST_AUTO_TEST_CASE(TestIdle)
+{
+    PrefetchPolicy policy;
+    UISE_TEST_CHECK_EQUAL(policy.velocity(0),0.0);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),PrefetchPolicy::DefaultLatency);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::HOME,0),PrefetchPolicy::DefaultBaseScreens);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::END,0),PrefetchPolicy::DefaultBaseScreens);
+
+    policy.setBaseScreens(3.0);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::HOME,0),3.0);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::END,0),3.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestLatency)
+{
+    PrefetchPolicy policy;
+
+    // finish without start is ignored
+    policy.requestFinished(Direction::END,100);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),PrefetchPolicy::DefaultLatency);
+
+    policy.requestStarted(Direction::END,1000);
+    // repeated requests before response keep the time of the first one
+    policy.requestStarted(Direction::END,1100);
+    policy.requestFinished(Direction::END,1400);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),400.0);
+
+    // directions are accounted separately
+    policy.requestStarted(Direction::HOME,2000);
+    policy.requestFinished(Direction::END,2100);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),400.0);
+    policy.requestFinished(Direction::HOME,2400);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),400.0);
+
+    // running average
+    policy.requestStarted(Direction::HOME,3000);
+    policy.requestFinished(Direction::HOME,3100);
+    UISE_TEST_CHECK(std::abs(policy.latency()-310.0)<0.001);
+}
+
+BOOST_AUTO_TEST_CASE(TestScrolling)
+{
+    PrefetchPolicy policy;
+    policy.requestStarted(Direction::END,0);
+    policy.requestFinished(Direction::END,200);
+
+    // scroll towards end by a screen per 100 ms
+    double ts=1000;
+    for (size_t i=0;i<10;i++)
+    {
+        policy.scrolled(0.16,ts);
+        ts+=16;
+    }
+    ts-=16;
+    UISE_TEST_CHECK(std::abs(policy.velocity(ts)-0.01)<0.001);
+
+    auto ahead=policy.screens(Direction::END,ts);
+    auto behind=policy.screens(Direction::HOME,ts);
+    UISE_TEST_CHECK(ahead>PrefetchPolicy::DefaultBaseScreens);
+    UISE_TEST_CHECK(ahead<=PrefetchPolicy::DefaultMaxScreens);
+    UISE_TEST_CHECK(behind<PrefetchPolicy::DefaultBaseScreens);
+    UISE_TEST_CHECK(behind>=PrefetchPolicy::DefaultMinTrailingScreens);
+
+    // fast fling is limited
+    for (size_t i=0;i<10;i++)
+    {
+        policy.scrolled(-5.0,ts);
+        ts+=16;
+    }
+    ts-=16;
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::HOME,ts),PrefetchPolicy::DefaultMaxScreens);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::END,ts),PrefetchPolicy::DefaultMinTrailingScreens);
+
+    // list becomes idle
+    ts+=PrefetchPolicy::IdleTimeout+1;
+    UISE_TEST_CHECK_EQUAL(policy.velocity(ts),0.0);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::HOME,ts),PrefetchPolicy::DefaultBaseScreens);
+    UISE_TEST_CHECK_EQUAL(policy.screens(Direction::END,ts),PrefetchPolicy::DefaultBaseScreens);
+
+    // reset forgets velocity but keeps latency
+    policy.scrolled(1.0,ts);
+    UISE_TEST_CHECK(policy.velocity(ts)>0.0);
+    policy.reset();
+    UISE_TEST_CHECK_EQUAL(policy.velocity(ts),0.0);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),200.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestLostRequests)
+{
+    PrefetchPolicy policy;
+    policy.requestStarted(Direction::END,0);
+    policy.requestFinished(Direction::END,100);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),100.0);
+
+    auto scroll=[&policy](double ts)
+    {
+        for (size_t i=0;i<10;i++)
+        {
+            policy.scrolled(0.16,ts);
+            ts+=16;
+        }
+        return ts-16;
+    };
+    auto ts=scroll(1000);
+    auto window=policy.screens(Direction::END,ts);
+    UISE_TEST_CHECK(window<PrefetchPolicy::DefaultMaxScreens);
+
+    // request that returned nothing is cancelled and does not stretch the next sample
+    policy.requestStarted(Direction::END,2000);
+    policy.requestCancelled(Direction::END);
+    policy.requestStarted(Direction::END,3000);
+    policy.requestFinished(Direction::END,3100);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),100.0);
+    ts=scroll(4000);
+    UISE_TEST_CHECK(std::abs(policy.screens(Direction::END,ts)-window)<0.001);
+
+    // request never answered is dropped after timeout
+    policy.requestStarted(Direction::END,5000);
+    policy.requestStarted(Direction::END,5000+PrefetchPolicy::RequestTimeout+1000);
+    policy.requestFinished(Direction::END,5000+PrefetchPolicy::RequestTimeout+1100);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),100.0);
+
+    // late response to a lost request is not accounted
+    policy.requestStarted(Direction::HOME,20000);
+    policy.requestFinished(Direction::HOME,20000+PrefetchPolicy::RequestTimeout+1);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),100.0);
+    ts=scroll(30000);
+    UISE_TEST_CHECK(std::abs(policy.screens(Direction::END,ts)-window)<0.001);
+
+    // reset drops pending requests
+    policy.requestStarted(Direction::END,40000);
+    policy.reset();
+    policy.requestFinished(Direction::END,40500);
+    UISE_TEST_CHECK_EQUAL(policy.latency(),100.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testscrollpositionestimator.cpp
+*
+*  Test of ScrollPositionEstimator used by virtual scrollbar of FlyweightListView.
+*
+*/
+
+/****************************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/scrollpositionestimator.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestScrollPositionEstimator)
+
+BOOST_AUTO_TEST_CASE(TestDefaults)
+{
+    ScrollPositionEstimator estimator;
+    UISE_TEST_CHECK(!estimator.isEnabled());
+    UISE_TEST_CHECK_EQUAL(estimator.totalExtent(),0);
+    UISE_TEST_CHECK_EQUAL(estimator.itemIndex(1000),0);
+
+    estimator.setTotalCount(100);
+    UISE_TEST_CHECK(estimator.isEnabled());
+    UISE_TEST_CHECK_EQUAL(estimator.averageItemExtent(),ScrollPositionEstimator::DefaultItemExtent);
+    UISE_TEST_CHECK_EQUAL(estimator.totalExtent(),5000);
+
+    estimator.setDefaultItemExtent(20);
+    UISE_TEST_CHECK_EQUAL(estimator.totalExtent(),2000);
+    UISE_TEST_CHECK_EQUAL(estimator.position(10),200);
+    UISE_TEST_CHECK_EQUAL(estimator.position(10,5),205);
+    UISE_TEST_CHECK_EQUAL(estimator.itemIndex(205),10);
+    UISE_TEST_CHECK_EQUAL(estimator.itemIndex(-5),0);
+    UISE_TEST_CHECK_EQUAL(estimator.itemIndex(100000),99);
+
+    estimator.setDefaultItemExtent(0);
+    UISE_TEST_CHECK_EQUAL(estimator.averageItemExtent(),1.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestRunningAverage)
+{
+    ScrollPositionEstimator estimator;
+    estimator.setTotalCount(1000);
+
+    UISE_TEST_CHECK(!estimator.measureWindow(0,100));
+    UISE_TEST_CHECK(!estimator.measureWindow(10,0));
+
+    UISE_TEST_CHECK(estimator.measureWindow(10,300));
+    UISE_TEST_CHECK_EQUAL(estimator.averageItemExtent(),30.0);
+    UISE_TEST_CHECK_EQUAL(estimator.totalExtent(),30000);
+
+    // the same window is not accounted twice
+    UISE_TEST_CHECK(!estimator.measureWindow(10,300));
+    UISE_TEST_CHECK_EQUAL(estimator.averageItemExtent(),30.0);
+
+    // weighted by number of items
+    UISE_TEST_CHECK(estimator.measureWindow(30,1800));
+    UISE_TEST_CHECK_EQUAL(estimator.averageItemExtent(),52.5);
+
+    // capped weight lets the average follow recent samples
+    estimator.setMaxSampleWeight(10);
+    estimator.reset();
+    UISE_TEST_CHECK_EQUAL(estimator.averageItemExtent(),ScrollPositionEstimator::DefaultItemExtent);
+    for (size_t i=0;i<50;i++)
+    {
+        estimator.measureWindow(10+i%2,100.0*(10+i%2));
+    }
+    UISE_TEST_CHECK(std::abs(estimator.averageItemExtent()-100.0)<0.001);
+    for (size_t i=0;i<50;i++)
+    {
+        estimator.measureWindow(10+i%2,20.0*(10+i%2));
+    }
+    UISE_TEST_CHECK(std::abs(estimator.averageItemExtent()-20.0)<0.001);
+}
+
+BOOST_AUTO_TEST_CASE(TestRoundTrip)
+{
+    ScrollPositionEstimator estimator;
+    estimator.setTotalCount(10000);
+    estimator.measureWindow(40,40*37);
+
+    for (size_t index=0;index<10000;index+=7)
+    {
+        UISE_TEST_CHECK_EQUAL(estimator.itemIndex(estimator.position(index)),index);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestOverflow)
+{
+    ScrollPositionEstimator estimator;
+    estimator.setTotalCount(std::numeric_limits<size_t>::max()/2);
+    UISE_TEST_CHECK_EQUAL(estimator.totalExtent(),std::numeric_limits<int>::max());
+    UISE_TEST_CHECK_EQUAL(estimator.position(estimator.totalCount()-1),std::numeric_limits<int>::max());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,197 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testshelfpacker.cpp
+*
+*  Test of ShelfPacker.
+*
+*/
+
+/****************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/shelfpacker.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+namespace {
+
+struct Placed
+{
+    ShelfPackerAllocation allocation;
+    int width;
+    int height;
+};
+
+bool overlap(const Placed& l, const Placed& r)
+{
+    if (l.allocation.page!=r.allocation.page)
+    {
+        return false;
+    }
+    return l.allocation.x<r.allocation.x+r.width && r.allocation.x<l.allocation.x+l.width
+        && l.allocation.y<r.allocation.y+r.height && r.allocation.y<l.allocation.y+l.height;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestShelfPacker)
+
+BOOST_AUTO_TEST_CASE(TestShelves)
+{
+    ShelfPacker packer{64,64};
+
+    // same heights share a shelf
+    auto a=packer.allocate(16,16);
+    auto b=packer.allocate(16,16);
+    UISE_TEST_REQUIRE(a.isValid());
+    UISE_TEST_REQUIRE(b.isValid());
+    UISE_TEST_CHECK_EQUAL(a.page,0);
+    UISE_TEST_CHECK_EQUAL(a.x,0);
+    UISE_TEST_CHECK_EQUAL(a.y,0);
+    UISE_TEST_CHECK_EQUAL(b.x,16);
+    UISE_TEST_CHECK_EQUAL(b.y,0);
+
+    // much lower rectangle opens a new shelf
+    auto c=packer.allocate(8,8);
+    UISE_TEST_CHECK_EQUAL(c.x,0);
+    UISE_TEST_CHECK_EQUAL(c.y,16);
+
+    // slightly lower rectangle goes to the existing shelf
+    auto d=packer.allocate(14,14);
+    UISE_TEST_CHECK_EQUAL(d.x,32);
+    UISE_TEST_CHECK_EQUAL(d.y,0);
+
+    // shelf is full, the next one is opened below
+    packer.allocate(16,16);
+    auto e=packer.allocate(16,16);
+    UISE_TEST_CHECK_EQUAL(e.x,0);
+    UISE_TEST_CHECK_EQUAL(e.y,24);
+
+    // too large
+    UISE_TEST_CHECK(!packer.allocate(65,10).isValid());
+    UISE_TEST_CHECK(!packer.allocate(10,65).isValid());
+    UISE_TEST_CHECK(!packer.allocate(0,10).isValid());
+
+    // new page when the page is full
+    auto f=packer.allocate(64,32);
+    UISE_TEST_CHECK_EQUAL(f.page,1);
+    UISE_TEST_CHECK_EQUAL(f.y,0);
+    UISE_TEST_CHECK_EQUAL(packer.pageCount(),2);
+    UISE_TEST_CHECK_EQUAL(packer.count(),7);
+
+    packer.clear();
+    UISE_TEST_CHECK_EQUAL(packer.pageCount(),0);
+    UISE_TEST_CHECK_EQUAL(packer.count(),0);
+    UISE_TEST_CHECK_EQUAL(packer.allocate(16,16).page,0);
+}
+
+BOOST_AUTO_TEST_CASE(TestPadding)
+{
+    ShelfPacker packer{32,32,1};
+    auto a=packer.allocate(15,15);
+    auto b=packer.allocate(15,15);
+    auto c=packer.allocate(15,15);
+    UISE_TEST_CHECK_EQUAL(b.x,16);
+    UISE_TEST_CHECK_EQUAL(c.x,0);
+    UISE_TEST_CHECK_EQUAL(c.y,16);
+    UISE_TEST_CHECK_EQUAL(a.page,c.page);
+
+    // padding is not required at the page border
+    ShelfPacker exact{32,32,1};
+    UISE_TEST_CHECK(exact.allocate(32,32).isValid());
+    UISE_TEST_CHECK_EQUAL(exact.pageCount(),1);
+}
+
+BOOST_AUTO_TEST_CASE(TestRelease)
+{
+    ShelfPacker packer{32,32};
+    auto a=packer.allocate(32,16);
+    auto b=packer.allocate(32,16);
+    auto c=packer.allocate(32,32);
+    UISE_TEST_CHECK_EQUAL(a.page,0);
+    UISE_TEST_CHECK_EQUAL(b.page,0);
+    UISE_TEST_CHECK_EQUAL(c.page,1);
+    UISE_TEST_CHECK_EQUAL(packer.count(0),2);
+    UISE_TEST_CHECK_EQUAL(packer.count(1),1);
+
+    // space of a single rectangle is not reused
+    UISE_TEST_CHECK(!packer.release(a));
+    UISE_TEST_CHECK_EQUAL(packer.count(),2);
+    UISE_TEST_CHECK_EQUAL(packer.count(0),1);
+    auto d=packer.allocate(32,16);
+    UISE_TEST_CHECK_EQUAL(d.page,2);
+
+    // page is reset when its last rectangle is released
+    UISE_TEST_CHECK(packer.release(d));
+    UISE_TEST_CHECK(packer.release(b));
+    UISE_TEST_CHECK_EQUAL(packer.count(0),0);
+    UISE_TEST_CHECK_EQUAL(packer.count(),1);
+
+    // released twice
+    UISE_TEST_CHECK(!packer.release(b));
+    UISE_TEST_CHECK_EQUAL(packer.count(),1);
+
+    // empty page is reused
+    auto e=packer.allocate(32,32);
+    UISE_TEST_CHECK_EQUAL(e.page,0);
+    UISE_TEST_CHECK_EQUAL(e.y,0);
+    UISE_TEST_CHECK_EQUAL(packer.pageCount(),3);
+    UISE_TEST_CHECK(packer.release(c));
+}
+
+BOOST_AUTO_TEST_CASE(TestRandomNoOverlap)
+{
+    const int pageSize=256;
+    ShelfPacker packer{pageSize,pageSize,1};
+    std::vector<Placed> placed;
+    std::mt19937 rng(4321);
+    const int sizes[]={12,16,18,20,24,32,48};
+    for (int i=0;i<1000;i++)
+    {
+        int w=sizes[rng()%7];
+        int h=sizes[rng()%7];
+        auto allocation=packer.allocate(w,h);
+        UISE_TEST_REQUIRE(allocation.isValid());
+        UISE_TEST_REQUIRE(allocation.x>=0 && allocation.x+w<=pageSize);
+        UISE_TEST_REQUIRE(allocation.y>=0 && allocation.y+h<=pageSize);
+        placed.push_back(Placed{allocation,w,h});
+    }
+    for (size_t i=0;i<placed.size();i++)
+    {
+        for (size_t j=i+1;j<placed.size();j++)
+        {
+            UISE_TEST_REQUIRE(!overlap(placed[i],placed[j]));
+        }
+    }
+
+    // pages are reasonably filled
+    long area=0;
+    for (const auto& p : placed)
+    {
+        area+=static_cast<long>(p.width)*p.height;
+    }
+    UISE_TEST_CHECK(area>static_cast<long>(packer.pageCount()-1)*pageSize*pageSize/2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
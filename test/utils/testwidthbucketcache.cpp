@@ -0,0 +1,93 @@
+/**
+@copyright Evgeny Sidorov 2026
+
+This software is dual-licensed. Choose the appropriate license for your project.
+
+1. The GNU GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-GPLv3.md](LICENSE-GPLv3.md) or copy at https://www.gnu.org/licenses/gpl-3.0.txt)
+
+2. The GNU LESSER GENERAL PUBLIC LICENSE, Version 3.0
+     (see accompanying file [LICENSE-LGPLv3.md](LICENSE-LGPLv3.md) or copy at https://www.gnu.org/licenses/lgpl-3.0.txt).
+
+You may select, at your option, one of the above-listed licenses.
+
+*/
+
+/****************************************************************************/
+
+/** @file uise/test/utils/testwidthbucketcache.cpp
+*
+*  Test of WidthBucketCache used for caching bubble widths of chat messages.
+*
+*/
+
+/****************************************************************************/
+
+#include <boost/test/unit_test.hpp>
+
+#include <uise/test/uise-testthread.hpp>
+#include <uise/desktop/utils/widthbucketcache.hpp>
+
+using namespace UISE_DESKTOP_NAMESPACE;
+using namespace UISE_TEST_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestWidthBucketCache)
+
+BOOST_AUTO_TEST_CASE(TestBuckets)
+{
+    using Cache=WidthBucketCache<int,10,3>;
+
+    UISE_TEST_CHECK_EQUAL(Cache::bucket(0),0);
+    UISE_TEST_CHECK_EQUAL(Cache::bucket(9),0);
+    UISE_TEST_CHECK_EQUAL(Cache::bucket(10),1);
+    UISE_TEST_CHECK_EQUAL(Cache::bucket(-1),-1);
+    UISE_TEST_CHECK_EQUAL(Cache::bucket(-10),-1);
+    UISE_TEST_CHECK_EQUAL(Cache::bucket(-11),-2);
+
+    Cache cache;
+    UISE_TEST_CHECK(cache.isEmpty());
+    UISE_TEST_CHECK(!cache.find(100));
+
+    // nearby widths share the value
+    cache.store(101,500);
+    UISE_TEST_CHECK(!cache.isEmpty());
+    UISE_TEST_REQUIRE(cache.find(109).has_value());
+    UISE_TEST_CHECK_EQUAL(cache.find(100).value(),500);
+    UISE_TEST_CHECK(!cache.find(110));
+    UISE_TEST_CHECK(!cache.find(99));
+
+    // storing to the same bucket overwrites the value
+    cache.store(105,400);
+    UISE_TEST_CHECK_EQUAL(cache.find(101).value(),400);
+
+    cache.clear();
+    UISE_TEST_CHECK(cache.isEmpty());
+    UISE_TEST_CHECK(!cache.find(101));
+}
+
+BOOST_AUTO_TEST_CASE(TestCapacity)
+{
+    WidthBucketCache<int,10,3> cache;
+    cache.store(10,1);
+    cache.store(20,2);
+    cache.store(30,3);
+    UISE_TEST_CHECK_EQUAL(cache.find(10).value(),1);
+    UISE_TEST_CHECK_EQUAL(cache.find(20).value(),2);
+    UISE_TEST_CHECK_EQUAL(cache.find(30).value(),3);
+
+    // the oldest bucket is replaced
+    cache.store(40,4);
+    UISE_TEST_CHECK(!cache.find(10));
+    UISE_TEST_CHECK_EQUAL(cache.find(20).value(),2);
+    UISE_TEST_CHECK_EQUAL(cache.find(40).value(),4);
+
+    // overwriting does not take a new slot
+    cache.store(25,5);
+    cache.store(50,6);
+    UISE_TEST_CHECK(!cache.find(20));
+    UISE_TEST_CHECK_EQUAL(cache.find(30).value(),3);
+    UISE_TEST_CHECK_EQUAL(cache.find(40).value(),4);
+    UISE_TEST_CHECK_EQUAL(cache.find(50).value(),6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()